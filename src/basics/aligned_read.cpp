@@ -4,6 +4,8 @@
 #include "aligned_read.hpp"
 
 #include <ostream>
+#include <memory>
+#include <functional>
 
 #include <boost/functional/hash.hpp>
 
@@ -47,7 +49,8 @@ const std::string& AlignedRead::name() const noexcept
 
 const std::string& AlignedRead::read_group() const noexcept
 {
-    return read_group_;
+    static const std::string no_read_group {};
+    return read_group_ ? *read_group_ : no_read_group;
 }
 
 const GenomicRegion& AlignedRead::mapped_region() const noexcept
@@ -259,6 +262,37 @@ AlignedRead::NucleotideSequence::size_type sequence_size(const AlignedRead& read
     return sequence_size(contained_cigar_copy);
 }
 
+namespace {
+
+// Short strings and cigars are stored inside the object, so are already counted by sizeof(AlignedRead)
+template <typename Container>
+bool is_stored_inline(const Container& container) noexcept
+{
+    const auto data = reinterpret_cast<const char*>(container.data());
+    const auto object = reinterpret_cast<const char*>(std::addressof(container));
+    const std::less<const char*> less {};
+    return !less(data, object) && less(data, object + sizeof(Container));
+}
+
+template <typename Container>
+std::size_t heap_footprint(const Container& container) noexcept
+{
+    return is_stored_inline(container) ? 0 : container.capacity() * sizeof(typename Container::value_type);
+}
+
+} // namespace
+
+std::size_t footprint(const AlignedRead& read) noexcept
+{
+    return sizeof(AlignedRead)
+    + heap_footprint(read.name())
+    + heap_footprint(read.sequence())
+    + heap_footprint(read.base_qualities())
+    + heap_footprint(read.cigar())
+    + heap_footprint(contig_name(read))
+    + (read.has_other_segment() ? heap_footprint(read.next_segment().contig_name()) : 0);
+}
+
 bool is_soft_clipped(const AlignedRead& read) noexcept
 {
     return is_soft_clipped(read.cigar());
@@ -321,7 +355,7 @@ AlignedRead copy(const AlignedRead& read, const GenomicRegion& region)
     const auto subqualities_end_itr   = next(subqualities_begin_itr, sequence_length);
     AlignedRead::BaseQualityVector sub_qualities {subqualities_begin_itr, subqualities_end_itr};
     return AlignedRead {read.name(), copy_region, std::move(sub_sequence), std::move(sub_qualities),
-                        std::move(contained_cigar_copy), read.mapping_quality(), read.flags(), read.read_group()};
+                        std::move(contained_cigar_copy), read.mapping_quality(), read.flags(), read.read_group_};
 }
 
 AlignedRead::NucleotideSequence copy_sequence(const AlignedRead& read, const GenomicRegion& region)
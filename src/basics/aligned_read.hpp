@@ -13,6 +13,8 @@
 #include <iterator>
 #include <utility>
 #include <functional>
+#include <memory>
+#include <type_traits>
 #include <iosfwd>
 
 #include <boost/optional.hpp>
@@ -33,6 +35,8 @@ public:
     using MappingQuality      = std::uint_fast8_t;
     using BaseQuality         = std::uint_fast8_t;
     using BaseQualityVector   = std::vector<BaseQuality>;
+    // Readers can share one read group string between all reads in the group
+    using ReadGroupPtr        = std::shared_ptr<const std::string>;
     
     enum class Direction { forward, reverse };
     
@@ -126,6 +130,8 @@ public:
     bool is_marked_duplicate() const noexcept;
     bool is_marked_supplementary_alignment() const noexcept;
     
+    friend AlignedRead copy(const AlignedRead& read, const GenomicRegion& region);
+    
 private:
     static constexpr std::size_t numFlags_ = 10;
     using FlagBits = std::bitset<numFlags_>;
@@ -136,11 +142,15 @@ private:
     NucleotideSequence sequence_;
     BaseQualityVector base_qualities_;
     CigarString cigar_;
-    std::string read_group_;
+    ReadGroupPtr read_group_;
     boost::optional<Segment> next_segment_;
     FlagBits flags_;
     MappingQuality mapping_quality_;
     
+    static ReadGroupPtr make_read_group(ReadGroupPtr read_group) noexcept { return read_group; }
+    template <typename S, typename = std::enable_if_t<!std::is_convertible<S, ReadGroupPtr>::value>>
+    static ReadGroupPtr make_read_group(S&& read_group);
+    
     FlagBits compress(const Flags& flags) const noexcept;
     Flags decompress(const FlagBits& flags) const noexcept;
 };
@@ -174,7 +184,7 @@ AlignedRead::AlignedRead(String_&& name, GenomicRegion_&& reference_region, Seq&
 , sequence_ {std::forward<Seq>(sequence)}
 , base_qualities_ {std::forward<Qualities_>(qualities)}
 , cigar_ {std::forward<CigarString_>(cigar)}
-, read_group_ {std::forward<String2_>(read_group)}
+, read_group_ {make_read_group(std::forward<String2_>(read_group))}
 , next_segment_ {}
 , flags_ {compress(flags)}
 , mapping_quality_ {mapping_quality}
@@ -191,7 +201,7 @@ AlignedRead::AlignedRead(String1_&& name, GenomicRegion_&& reference_region, Seq
 , sequence_ {std::forward<Seq>(sequence)}
 , base_qualities_ {std::forward<Qualities_>(qualities)}
 , cigar_ {std::forward<CigarString_>(cigar)}
-, read_group_ {std::forward<String2_>(read_group)}
+, read_group_ {make_read_group(std::forward<String2_>(read_group))}
 , next_segment_ {
     Segment {std::forward<String3_>(next_segment_contig_name), next_segment_begin,
     inferred_template_length, next_segment_flags}
@@ -200,6 +210,14 @@ AlignedRead::AlignedRead(String1_&& name, GenomicRegion_&& reference_region, Seq
 , mapping_quality_ {mapping_quality}
 {}
 
+template <typename S, typename>
+AlignedRead::ReadGroupPtr AlignedRead::make_read_group(S&& read_group)
+{
+    std::string name {std::forward<S>(read_group)};
+    if (name.empty()) return nullptr;
+    return std::make_shared<const std::string>(std::move(name));
+}
+
 template <typename String_>
 AlignedRead::Segment::Segment(String_&& contig_name, GenomicRegion::Position begin,
                               GenomicRegion::Size inferred_template_length, Flags data)
@@ -225,6 +243,9 @@ bool is_sequence_empty(const AlignedRead& read) noexcept;
 AlignedRead::NucleotideSequence::size_type sequence_size(const AlignedRead& read) noexcept;
 AlignedRead::NucleotideSequence::size_type sequence_size(const AlignedRead& read, const GenomicRegion& region);
 
+// Bytes held by the read, including allocated (but unused) storage but not the shared read group
+std::size_t footprint(const AlignedRead& read) noexcept;
+
 bool is_soft_clipped(const AlignedRead& read) noexcept;
 bool is_front_soft_clipped(const AlignedRead& read) noexcept;
 bool is_back_soft_clipped(const AlignedRead& read) noexcept;
@@ -16,7 +16,7 @@
 namespace octopus {
 
 CigarOperation::CigarOperation(const Size size, const Flag flag) noexcept
-: size_ {size}
+: size_ {static_cast<std::uint32_t>(size)}
 , flag_ {flag}
 {}
 
@@ -13,6 +13,7 @@
 #include <functional>
 
 #include <boost/functional/hash.hpp>
+#include <boost/container/small_vector.hpp>
 
 #include "concepts/comparable.hpp"
 
@@ -51,7 +52,7 @@ public:
     Size size() const noexcept;
     
 private:
-    Size size_;
+    std::uint32_t size_; // same width as BAM cigar operation lengths, keeps operations 8 bytes
     Flag flag_;
 };
 
@@ -69,7 +70,8 @@ bool is_clipping(const CigarOperation& op) noexcept;
 
 // CigarString
 
-using CigarString = std::vector<CigarOperation>;
+// Most reads have few operations, so these are stored inline to save an allocation per read
+using CigarString = boost::container::small_vector<CigarOperation, 3>;
 
 CigarString parse_cigar(const std::string& cigar);
 
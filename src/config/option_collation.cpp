@@ -43,6 +43,8 @@
 #include "io/pedigree/pedigree_reader.hpp"
 #include "io/variant/vcf_reader.hpp"
 #include "io/variant/vcf_writer.hpp"
+#include "io/reference/reference_annotation_index.hpp"
+#include "io/reference/packed_reference.hpp"
 #include "exceptions/user_error.hpp"
 #include "exceptions/program_error.hpp"
 #include "exceptions/system_error.hpp"
@@ -66,9 +68,20 @@ unsigned as_unsigned(const std::string& option, const OptionMap& options)
     return static_cast<unsigned>(options.at(option).as<int>());
 }
 
+bool is_index_reference_command(const OptionMap& options)
+{
+    return options.at("index-reference").as<bool>();
+}
+
+bool is_pack_reference_command(const OptionMap& options)
+{
+    return options.at("pack-reference").as<bool>();
+}
+
 bool is_run_command(const OptionMap& options)
 {
-    return !is_set("help", options) && !is_set("version", options);
+    return !is_set("help", options) && !is_set("version", options)
+           && !is_index_reference_command(options) && !is_pack_reference_command(options);
 }
 
 bool is_debug_mode(const OptionMap& options)
@@ -238,6 +251,11 @@ boost::optional<unsigned> get_num_threads(const OptionMap& options)
     return boost::none;
 }
 
+unsigned get_num_compression_threads(const OptionMap& options)
+{
+    return as_unsigned("compression-threads", options);
+}
+
 ExecutionPolicy get_thread_execution_policy(const OptionMap& options)
 {
     if (is_set("threads", options)) {
@@ -284,6 +302,65 @@ bool is_very_fast_mode(const OptionMap& options)
     return options.at("very-fast").as<bool>();
 }
 
+namespace {
+
+void load_reference_annotations(ReferenceGenome& reference, const fs::path& annotations_path)
+{
+    // A truncated or old format index should not stop the run as the annotations can be recomputed
+    const auto warn_unloadable = [&] (const std::string& reason) {
+        logging::WarningLogger warn_log {};
+        stream(warn_log) << "Ignoring reference annotation index " << annotations_path
+                         << " as it could not be loaded (" << reason << "). Rebuild it with --index-reference";
+    };
+    std::shared_ptr<ReferenceAnnotationIndex> annotations {};
+    try {
+        annotations = std::make_shared<ReferenceAnnotationIndex>(annotations_path);
+    } catch (const Error& e) {
+        warn_unloadable(e.why());
+        return;
+    } catch (const std::exception& e) {
+        warn_unloadable(e.what());
+        return;
+    }
+    if (annotations->is_compatible(reference)) {
+        reference.set_annotations(std::move(annotations));
+    } else {
+        logging::WarningLogger warn_log {};
+        stream(warn_log) << "Ignoring reference annotation index " << annotations_path
+                         << " as it does not match the reference. Rebuild it with --index-reference";
+    }
+}
+
+bool have_same_contigs(const ReferenceGenome& lhs, const ReferenceGenome& rhs)
+{
+    const auto contigs = lhs.contig_names();
+    return contigs == rhs.contig_names()
+           && std::all_of(std::cbegin(contigs), std::cend(contigs),
+                          [&] (const auto& contig) { return lhs.contig_size(contig) == rhs.contig_size(contig); });
+}
+
+boost::optional<ReferenceGenome> load_packed_reference(const fs::path& packed_path, const ReferenceGenome& fasta)
+{
+    // An interrupted or mismatched pack should not stop the run as the FASTA can be used instead
+    const auto warn_unusable = [&] (const std::string& reason) {
+        logging::WarningLogger warn_log {};
+        stream(warn_log) << "Ignoring packed reference " << packed_path << " as " << reason
+                         << ". Rebuild it with --pack-reference";
+    };
+    try {
+        auto result = octopus::make_packed_reference(packed_path);
+        if (have_same_contigs(result, fasta)) return result;
+        warn_unusable("its contigs do not match the reference index");
+    } catch (const Error& e) {
+        warn_unusable("it could not be loaded (" + e.why() + ")");
+    } catch (const std::exception& e) {
+        warn_unusable(std::string {"it could not be loaded ("} + e.what() + ")");
+    }
+    return boost::none;
+}
+
+} // namespace
+
 ReferenceGenome make_reference(const OptionMap& options)
 {
     const fs::path input_path {options.at("reference").as<std::string>()};
@@ -310,8 +387,29 @@ ReferenceGenome make_reference(const OptionMap& options)
             warned = true;
         }
     }
+    const auto annotations_path = ReferenceAnnotationIndex::default_path(resolved_path);
+    const auto packed_path = io::PackedReference::default_path(resolved_path);
     try {
-        return octopus::make_reference(std::move(resolved_path), ref_cache_size, is_threading_allowed(options));
+        // A packed reference that is older than the FASTA is stale and is ignored rather than rejected
+        const auto use_packed = !is_pack_reference_command(options)
+                                && io::PackedReference::is_up_to_date(packed_path, resolved_path);
+        const auto annotations_up_to_date = ReferenceAnnotationIndex::is_up_to_date(annotations_path, resolved_path);
+        // Packing must see the bases as they are in the FASTA so that soft-masked runs are kept
+        const auto capitalise_bases = !is_pack_reference_command(options);
+        auto fasta = octopus::make_reference(std::move(resolved_path), ref_cache_size, is_threading_allowed(options),
+                                             capitalise_bases, options.at("memory-map-reference").as<bool>());
+        auto packed = use_packed ? load_packed_reference(packed_path, fasta) : boost::optional<ReferenceGenome> {};
+        auto result = packed ? std::move(*packed) : std::move(fasta);
+        if (!is_index_reference_command(options) && fs::exists(annotations_path)) {
+            if (annotations_up_to_date) {
+                load_reference_annotations(result, annotations_path);
+            } else {
+                logging::WarningLogger warn_log {};
+                stream(warn_log) << "Ignoring reference annotation index " << annotations_path
+                                 << " as it is older than the reference. Rebuild it with --index-reference";
+            }
+        }
+        return result;
     } catch (MissingFileError& e) {
         e.set_location_specified("the command line option --reference");
         throw;
@@ -320,6 +418,18 @@ ReferenceGenome make_reference(const OptionMap& options)
     }
 }
 
+fs::path get_packed_reference_path(const OptionMap& options)
+{
+    const fs::path input_path {options.at("reference").as<std::string>()};
+    return io::PackedReference::default_path(resolve_path(input_path, options));
+}
+
+fs::path get_reference_annotation_index_path(const OptionMap& options)
+{
+    const fs::path input_path {options.at("reference").as<std::string>()};
+    return ReferenceAnnotationIndex::default_path(resolve_path(input_path, options));
+}
+
 InputRegionMap make_search_regions(const std::vector<GenomicRegion>& regions)
 {
     std::map<ContigName, std::deque<GenomicRegion>> contig_mapped_regions {};
@@ -606,11 +716,22 @@ std::vector<fs::path> get_read_paths(const OptionMap& options)
     return result;
 }
 
+// Fetching from several files and processing several samples share one pool of --threads threads
+std::shared_ptr<ThreadPool> make_read_worker_pool(const OptionMap& options)
+{
+    if (!is_threading_allowed(options)) return nullptr;
+    auto num_threads = get_num_threads(options);
+    if (!num_threads) num_threads = std::thread::hardware_concurrency();
+    if (*num_threads < 2) return nullptr;
+    return std::make_shared<ThreadPool>(*num_threads);
+}
+
 ReadManager make_read_manager(const OptionMap& options)
 {
     auto read_paths = get_read_paths(options);
     const auto max_open_files = as_unsigned("max-open-read-files", options);
-    return ReadManager {std::move(read_paths), max_open_files};
+    const auto num_decompression_threads = as_unsigned("decompression-threads", options);
+    return ReadManager {std::move(read_paths), max_open_files, num_decompression_threads, make_read_worker_pool(options)};
 }
 
 bool allow_assembler_generation(const OptionMap& options)
@@ -760,13 +881,14 @@ boost::optional<readpipe::Downsampler> make_downsampler(const OptionMap& options
 ReadPipe make_read_pipe(ReadManager& read_manager, std::vector<SampleName> samples, const OptionMap& options)
 {
     auto transformers = make_read_transformers(options);
-    if (transformers.second.num_transforms() > 0) {
-        return ReadPipe {read_manager, std::move(transformers.first), make_read_filterer(options),
-                         std::move(transformers.second), make_downsampler(options), std::move(samples)};
-    } else {
-        return ReadPipe {read_manager, std::move(transformers.first), make_read_filterer(options),
-                         make_downsampler(options), std::move(samples)};
-    }
+    auto workers = samples.size() > 1 ? read_manager.workers() : nullptr;
+    auto result = transformers.second.num_transforms() > 0
+        ? ReadPipe {read_manager, std::move(transformers.first), make_read_filterer(options),
+                    std::move(transformers.second), make_downsampler(options), std::move(samples)}
+        : ReadPipe {read_manager, std::move(transformers.first), make_read_filterer(options),
+                    make_downsampler(options), std::move(samples)};
+    result.set_thread_pool(std::move(workers));
+    return result;
 }
 
 auto get_default_germline_inclusion_predicate()
@@ -916,6 +1038,10 @@ auto make_variant_generator_builder(const OptionMap& options)
         reassembler_options.max_bubbles = as_unsigned("max-bubbles", options);
         reassembler_options.min_bubble_score = options.at("min-bubble-score").as<double>();
         reassembler_options.max_variant_size = as_unsigned("max-variant-size", options);
+        const auto assembly_cache_footprint = options.at("max-assembly-cache-footprint").as<MemoryFootprint>();
+        if (assembly_cache_footprint.num_bytes() > 0) {
+            reassembler_options.cache = std::make_shared<AssemblyCache>(assembly_cache_footprint.num_bytes());
+        }
         result.set_local_reassembler(std::move(reassembler_options));
     }
     if (is_set("source-candidates", options) || is_set("source-candidates-file", options)) {
@@ -1123,6 +1249,11 @@ bool call_sites_only(const OptionMap& options)
     return options.at("sites-only").as<bool>();
 }
 
+bool use_index_task_planning(const OptionMap& options)
+{
+    return options.at("index-task-planning").as<bool>();
+}
+
 auto get_extension_policy(const OptionMap& options)
 {
     using ExtensionPolicy = HaplotypeGenerator::Builder::Policies::Extension;
@@ -27,6 +27,8 @@ namespace fs = boost::filesystem;
 namespace octopus { namespace options {
 
 bool is_run_command(const OptionMap& options);
+bool is_index_reference_command(const OptionMap& options);
+bool is_pack_reference_command(const OptionMap& options);
 
 bool is_debug_mode(const OptionMap& options);
 bool is_trace_mode(const OptionMap& options);
@@ -36,10 +38,16 @@ boost::optional<fs::path> get_trace_log_file_name(const OptionMap& options);
 
 boost::optional<unsigned> get_num_threads(const OptionMap& options);
 
+unsigned get_num_compression_threads(const OptionMap& options);
+
 MemoryFootprint get_target_read_buffer_size(const OptionMap& options);
 
 ReferenceGenome make_reference(const OptionMap& options);
 
+fs::path get_reference_annotation_index_path(const OptionMap& options);
+
+fs::path get_packed_reference_path(const OptionMap& options);
+
 InputRegionMap get_search_regions(const OptionMap& options, const ReferenceGenome& reference);
 
 ContigOutputOrder get_contig_output_order(const OptionMap& options);
@@ -54,6 +62,8 @@ ReadPipe make_read_pipe(ReadManager& read_manager, std::vector<SampleName> sampl
 
 bool call_sites_only(const OptionMap& options);
 
+bool use_index_task_planning(const OptionMap& options);
+
 CallerFactory make_caller_factory(const ReferenceGenome& reference, ReadPipe& read_pipe,
                                   const InputRegionMap& regions, const OptionMap& options,
                                   boost::optional<ReadSetProfile> input_reads_profile = boost::none);
@@ -70,6 +70,16 @@ OptionMap parse_options(const int argc, const char** argv)
     ("very-fast",
      po::bool_switch()->default_value(false),
      "The same as fast but also disables inactive flank scoring")
+    
+    ("index-reference",
+     po::bool_switch()->default_value(false),
+     "Writes an annotation index (exact GC content of any region) next to the reference FASTA, which is used"
+     " by subsequent runs, then exits")
+    
+    ("pack-reference",
+     po::bool_switch()->default_value(false),
+     "Writes a packed binary copy of the reference FASTA next to it, which subsequent runs load instead"
+     " of the FASTA, then exits")
     ;
     
     po::options_description backend("Backend");
@@ -87,6 +97,11 @@ OptionMap parse_options(const int argc, const char** argv)
      po::value<MemoryFootprint>()->default_value(*parse_footprint("500MB"), "500MB"),
      "Maximum memory footprint for cached reference sequence")
     
+    ("memory-map-reference",
+     po::bool_switch()->default_value(false),
+     "Read the reference FASTA through a memory map that all threads share without locking;"
+     " the reference cache is then not used")
+    
     ("target-read-buffer-footprint,B",
      po::value<MemoryFootprint>()->default_value(*parse_footprint("6GB"), "6GB"),
      "None binding request to limit the memory footprint of buffered read data")
@@ -94,6 +109,21 @@ OptionMap parse_options(const int argc, const char** argv)
     ("max-open-read-files",
      po::value<int>()->default_value(250),
      "Limits the number of read files that can be open simultaneously")
+    
+    ("decompression-threads",
+     po::value<int>()->default_value(0),
+     "Size of a thread pool shared by all read files for BGZF/CRAM decoding and read-ahead;"
+     " 0 decodes on the calling thread")
+    
+    ("compression-threads",
+     po::value<int>()->default_value(0),
+     "Size of a thread pool shared by all compressed (BGZF) output files, including temporary files,"
+     " for block compression; 0 compresses on the writing thread")
+    
+    ("index-task-planning",
+     po::bool_switch()->default_value(false),
+     "Split calling regions into tasks using read densities estimated from the BAM indices rather than"
+     " by reading alignments; falls back to reading alignments for CRAM files")
     ;
     
     po::options_description input("I/O");
@@ -347,6 +377,11 @@ OptionMap parse_options(const int argc, const char** argv)
      po::value<int>()->default_value(200),
      "The maximum number of bases allowed to overlap assembly regions")
     
+    ("max-assembly-cache-footprint",
+     po::value<MemoryFootprint>()->default_value(*parse_footprint("100MB"), "100MB"),
+     "Maximum memory footprint for caching local assembly results between overlapping or repeated"
+     " assembly regions. Set to 0 to disable caching")
+    
     ("assemble-all",
      po::bool_switch()->default_value(false),
      "Forces all regions to be assembled")
@@ -953,7 +988,8 @@ void validate(const OptionMap& vm)
         "min-mapping-quality", "good-base-quality", "min-good-bases", "min-read-length",
         "max-read-length", "min-base-quality", "min-supporting-reads", "max-variant-size",
         "num-fallback-kmers", "max-assemble-region-overlap", "assembler-mask-base-quality",
-        "min-kmer-prune", "max-bubbles", "max-holdout-depth"
+        "min-kmer-prune", "max-bubbles", "max-holdout-depth", "decompression-threads",
+        "compression-threads"
     };
     const std::vector<std::string> strictly_positive_int_options {
         "max-open-read-files", "downsample-above", "downsample-target",
@@ -977,7 +1013,10 @@ void validate(const OptionMap& vm)
     for (const auto& option : probability_options) {
         check_probability(option, vm);
     }
-    check_reads_present(vm);
+    if ((vm.count("index-reference") == 0 || !vm.at("index-reference").as<bool>())
+        && (vm.count("pack-reference") == 0 || !vm.at("pack-reference").as<bool>())) {
+        check_reads_present(vm);
+    }
     check_region_files_consistent(vm);
     check_trio_consistent(vm);
     validate_caller(vm);
@@ -128,14 +128,22 @@ auto convert_to_vcf(std::deque<CallWrapper>&& calls, const VcfRecordFactory& fac
     return result;
 }
 
+MemoryBudget::Charge charge_footprint(const ReadPipe& read_pipe, const ReadMap& reads)
+{
+    auto budget = read_pipe.memory_budget();
+    return budget ? budget->charge(footprint(reads)) : MemoryBudget::Charge {};
+}
+
 } // namespace
 
 std::deque<VcfRecord> Caller::call(const GenomicRegion& call_region, ProgressMeter& progress_meter) const
 {
     resume(init_timer);
     ReadMap reads;
+    MemoryBudget::Charge reads_charge {};
     if (candidate_generator_.requires_reads()) {
         reads = read_pipe_.get().fetch_reads(expand(call_region, 100));
+        reads_charge = charge_footprint(read_pipe_, reads);
         add_reads(reads, candidate_generator_);
         if (!refcalls_requested() && all_empty(reads)) {
             if (debug_log_) stream(*debug_log_) << "Stopping early as no reads found in call region " << call_region;
@@ -153,6 +161,7 @@ std::deque<VcfRecord> Caller::call(const GenomicRegion& call_region, ProgressMet
     if (!candidate_generator_.requires_reads()) {
         // as we didn't fetch them earlier
         reads = read_pipe_.get().fetch_reads(extract_regions(candidates));
+        reads_charge = charge_footprint(read_pipe_, reads);
     }
     pause(init_timer);
     auto calls = call_variants(call_region, candidates, reads, progress_meter);
@@ -247,8 +247,7 @@ std::unique_ptr<Caller> CallerBuilder::build(const ContigName& contig) const
     if (factory_.count(caller_) == 0) {
         throw std::runtime_error {"CallerBuilder: unknown caller " + caller_};
     }
-    requested_contig_ = contig;
-    return factory_.at(caller_)();
+    return factory_.at(caller_)(contig);
 }
 
 // private methods
@@ -313,36 +312,36 @@ CallerBuilder::CallerFactoryMap CallerBuilder::generate_factory() const
 {
     const auto& samples = components_.read_pipe.get().samples();
     return CallerFactoryMap {
-        {"individual", [this, &samples] () {
+        {"individual", [this, &samples] (const ContigName& contig) {
             return std::make_unique<IndividualCaller>(make_components(),
                                                       params_.general,
                                                       IndividualCaller::Parameters {
-                                                          params_.ploidies.of(samples.front(), *requested_contig_),
+                                                          params_.ploidies.of(samples.front(), contig),
                                                           make_individual_prior_model(params_.snp_heterozygosity, params_.indel_heterozygosity),
                                                           params_.min_variant_posterior,
                                                           params_.min_refcall_posterior,
                                                           params_.deduplicate_haplotypes_with_caller_model
                                                       });
         }},
-        {"population", [this, &samples] () {
+        {"population", [this, &samples] (const ContigName& contig) {
             return std::make_unique<PopulationCaller>(make_components(),
                                                       params_.general,
                                                       PopulationCaller::Parameters {
                                                           params_.min_variant_posterior,
                                                           params_.min_refcall_posterior,
-                                                          get_ploidies(samples, *requested_contig_, params_.ploidies),
+                                                          get_ploidies(samples, contig, params_.ploidies),
                                                           make_population_prior_model(params_.snp_heterozygosity, params_.indel_heterozygosity),
                                                           params_.max_joint_genotypes,
                                                       });
         }},
-        {"cancer", [this, &samples] () {
+        {"cancer", [this, &samples] (const ContigName& contig) {
             return std::make_unique<CancerCaller>(make_components(),
                                                   params_.general,
                                                   CancerCaller::Parameters {
                                                       params_.min_variant_posterior,
                                                       params_.min_somatic_posterior,
                                                       params_.min_refcall_posterior,
-                                                      params_.ploidies.of(samples.front(), *requested_contig_),
+                                                      params_.ploidies.of(samples.front(), contig),
                                                       params_.normal_sample,
                                                       make_cancer_prior_model(params_.snp_heterozygosity, params_.indel_heterozygosity),
                                                       {params_.somatic_snv_mutation_rate, params_.somatic_indel_mutation_rate},
@@ -353,14 +352,14 @@ CallerBuilder::CallerFactoryMap CallerBuilder::generate_factory() const
                                                       params_.normal_contamination_risk
                                                   });
         }},
-        {"trio", [this] () {
+        {"trio", [this] (const ContigName& contig) {
             return std::make_unique<TrioCaller>(make_components(),
                                                 params_.general,
                                                 TrioCaller::Parameters {
                                                     *params_.trio,
-                                                    params_.ploidies.of(params_.trio->mother(), *requested_contig_),
-                                                    params_.ploidies.of(params_.trio->father(), *requested_contig_),
-                                                    params_.ploidies.of(params_.trio->child(), *requested_contig_),
+                                                    params_.ploidies.of(params_.trio->mother(), contig),
+                                                    params_.ploidies.of(params_.trio->father(), contig),
+                                                    params_.ploidies.of(params_.trio->child(), contig),
                                                     make_trio_prior_model(params_.snp_heterozygosity, params_.indel_heterozygosity),
                                                     {*params_.snv_denovo_mutation_rate, *params_.indel_denovo_mutation_rate},
                                                     params_.min_variant_posterior,
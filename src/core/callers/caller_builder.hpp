@@ -123,15 +123,13 @@ private:
         boost::optional<Pedigree> pedigree;
     };
     
-    using CallerFactoryMap = std::unordered_map<std::string, std::function<std::unique_ptr<Caller>()>>;
+    using CallerFactoryMap = std::unordered_map<std::string, std::function<std::unique_ptr<Caller>(const ContigName&)>>;
     
     std::string caller_;
     Components components_;
     Parameters params_;
     CallerFactoryMap factory_;
     
-    mutable boost::optional<ContigName> requested_contig_;
-    
     Caller::Components make_components() const;
     CallerFactoryMap generate_factory() const;
 };
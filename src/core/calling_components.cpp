@@ -13,6 +13,7 @@
 #include "config/config.hpp"
 #include "config/option_collation.hpp"
 #include "utils/map_utils.hpp"
+#include "io/read/read_buffer_pool.hpp"
 #include "logging/logging.hpp"
 #include "exceptions/user_error.hpp"
 
@@ -22,9 +23,9 @@ namespace {
 
 namespace fs = boost::filesystem;
 
-VcfWriter make_vcf_writer(boost::optional<fs::path> dst)
+VcfWriter make_vcf_writer(boost::optional<fs::path> dst, std::shared_ptr<const VcfWriter::ThreadPool> compression_pool)
 {
-    return dst ? VcfWriter {std::move(*dst)} : VcfWriter {};
+    return dst ? VcfWriter {std::move(*dst), std::move(compression_pool)} : VcfWriter {std::move(compression_pool)};
 }
 
 } // namespace
@@ -90,11 +91,22 @@ const VcfWriter& GenomeCallingComponents::output() const noexcept
     return components_.output;
 }
 
+const std::shared_ptr<const VcfWriter::ThreadPool>& GenomeCallingComponents::compression_pool() const noexcept
+{
+    return components_.compression_pool;
+}
+
 std::size_t GenomeCallingComponents::read_buffer_size() const noexcept
 {
     return components_.read_buffer_size;
 }
 
+boost::optional<const MemoryBudget&> GenomeCallingComponents::read_memory_budget() const noexcept
+{
+    if (components_.read_memory_budget) return *components_.read_memory_budget;
+    return boost::none;
+}
+
 const boost::optional<GenomeCallingComponents::Path>& GenomeCallingComponents::temp_directory() const noexcept
 {
     return components_.temp_directory;
@@ -168,6 +180,11 @@ bool GenomeCallingComponents::sites_only() const noexcept
     return components_.sites_only;
 }
 
+bool GenomeCallingComponents::index_task_planning() const noexcept
+{
+    return components_.index_task_planning;
+}
+
 namespace {
 
 std::vector<ContigName>
@@ -375,20 +392,26 @@ auto estimate_read_size(const boost::optional<ReadSetProfile>& profile) noexcept
     return result;
 }
 
-std::size_t calculate_max_num_reads(MemoryFootprint max_buffer_size, const boost::optional<ReadSetProfile>& profile) noexcept
+MemoryFootprint get_max_read_buffer_size(const options::OptionMap& options)
 {
     static constexpr MemoryFootprint min_buffer_size {50'000'000}; // 50Mb
-    if (max_buffer_size < min_buffer_size) {
+    auto result = options::get_target_read_buffer_size(options);
+    if (result < min_buffer_size) {
         static bool warned {false};
         if (!warned) {
             logging::WarningLogger warn_log {};
-            stream(warn_log) << "Ignoring given maximum read buffer size of " << max_buffer_size
+            stream(warn_log) << "Ignoring given maximum read buffer size of " << result
                              << " as this size is too small. Setting maximum to "
                              << min_buffer_size << " instead.";
             warned = true;
         }
-        max_buffer_size = min_buffer_size;
+        result = min_buffer_size;
     }
+    return result;
+}
+
+std::size_t calculate_max_num_reads(MemoryFootprint max_buffer_size, const boost::optional<ReadSetProfile>& profile) noexcept
+{
     return max_buffer_size.num_bytes() / estimate_read_size(profile);
 }
 
@@ -471,11 +494,14 @@ GenomeCallingComponents::Components::Components(ReferenceGenome&& reference, Rea
 , call_filter_factory {options::make_call_filter_factory(this->reference, this->read_pipe, options)}
 , filter_read_pipe {}
 , output {std::move(output)}
+, compression_pool {this->output.compression_pool()}
 , num_threads {options::get_num_threads(options)}
 , read_buffer_size {}
+, read_memory_budget {}
 , temp_directory {get_temp_directory(options)}
 , progress_meter {regions}
 , sites_only {options::call_sites_only(options)}
+, index_task_planning {options::use_index_task_planning(options)}
 , filtered_output {}
 , legacy {}
 , filter_request_ {}
@@ -508,7 +534,14 @@ void GenomeCallingComponents::Components::setup_progress_meter(const options::Op
 void GenomeCallingComponents::Components::set_read_buffer_size(const options::OptionMap& options)
 {
     if (!samples.empty() && !regions.empty() && read_manager.good()) {
-        read_buffer_size = calculate_max_num_reads(options::get_target_read_buffer_size(options), reads_profile_);
+        const auto max_buffer_size = get_max_read_buffer_size(options);
+        read_buffer_size = calculate_max_num_reads(max_buffer_size, reads_profile_);
+        // The profile estimate only sets the initial read counts; the reads actually held are measured.
+        // Both the buffered reads and the working copies held by running tasks are charged, and each is
+        // sized to the target, so the budget allows for both.
+        read_memory_budget = std::make_shared<MemoryBudget>(MemoryFootprint {2 * max_buffer_size.num_bytes()});
+        read_pipe.set_memory_budget(read_memory_budget);
+        io::set_read_buffer_pool_budget(read_memory_budget);
     }
 }
 
@@ -529,7 +562,7 @@ void GenomeCallingComponents::Components::setup_writers(const options::OptionMap
             assert(temp_directory);
             prefilter_path = generate_temp_output_path(*temp_directory);
         }
-        output.open(std::move(prefilter_path));
+        output.open(std::move(prefilter_path), compression_pool);
         if (options::is_legacy_vcf_requested(options) && final_output_path) {
             legacy = get_legacy_path(*final_output_path);
         }
@@ -542,6 +575,7 @@ void GenomeCallingComponents::Components::setup_filter_read_pipe(const options::
 {
     if (!options::use_calling_read_pipe_for_call_filtering(options)) {
         filter_read_pipe = options::make_call_filter_read_pipe(read_manager, samples, options);
+        filter_read_pipe->set_memory_budget(read_memory_budget);
     }
 }
 
@@ -601,9 +635,16 @@ private:
     std::string reference_name_, why_;
 };
 
+std::shared_ptr<const VcfWriter::ThreadPool> make_compression_pool(const options::OptionMap& options)
+{
+    const auto num_threads = options::get_num_compression_threads(options);
+    if (num_threads == 0) return nullptr;
+    return std::make_shared<VcfWriter::ThreadPool>(num_threads);
+}
+
 VcfWriter make_output_vcf_writer(const options::OptionMap& options)
 {
-    return make_vcf_writer(options::get_output_path(options));
+    return make_vcf_writer(options::get_output_path(options), make_compression_pool(options));
 }
 
 } // namespace
@@ -661,6 +702,7 @@ ContigCallingComponents::ContigCallingComponents(const GenomicRegion::ContigName
 , samples {genome_components.samples()}
 , caller {genome_components.caller_factory().make(contig)}
 , read_buffer_size {genome_components.read_buffer_size()}
+, index_task_planning {genome_components.index_task_planning()}
 , output {genome_components.output()}
 , progress_meter {genome_components.progress_meter()}
 {}
@@ -673,6 +715,7 @@ ContigCallingComponents::ContigCallingComponents(const GenomicRegion::ContigName
 , samples {genome_components.samples()}
 , caller {genome_components.caller_factory().make(contig)}
 , read_buffer_size {genome_components.read_buffer_size()}
+, index_task_planning {genome_components.index_task_planning()}
 , output {output}
 , progress_meter {genome_components.progress_meter()}
 {}
@@ -22,6 +22,7 @@
 #include "core/callers/caller_factory.hpp"
 #include "core/csr/filters/variant_call_filter_factory.hpp"
 #include "utils/input_reads_profiler.hpp"
+#include "utils/memory_budget.hpp"
 #include "logging/progress_meter.hpp"
 
 namespace octopus {
@@ -53,7 +54,10 @@ public:
     const std::vector<GenomicRegion::ContigName>& contigs() const noexcept;
     VcfWriter& output() noexcept;
     const VcfWriter& output() const noexcept;
+    // Shared by every compressed output file, including temporary ones (null if none was requested)
+    const std::shared_ptr<const VcfWriter::ThreadPool>& compression_pool() const noexcept;
     std::size_t read_buffer_size() const noexcept;
+    boost::optional<const MemoryBudget&> read_memory_budget() const noexcept;
     const boost::optional<Path>& temp_directory() const noexcept;
     boost::optional<unsigned> num_threads() const noexcept;
     const CallerFactory& caller_factory() const noexcept;
@@ -64,6 +68,7 @@ public:
     const ReadPipe& filter_read_pipe() const noexcept;
     ProgressMeter& progress_meter() noexcept;
     bool sites_only() const noexcept;
+    bool index_task_planning() const noexcept;
     boost::optional<Path> legacy() const;
     boost::optional<Path> filter_request() const;
     boost::optional<Path> bamout() const;
@@ -94,11 +99,14 @@ private:
         std::unique_ptr<VariantCallFilterFactory> call_filter_factory;
         boost::optional<ReadPipe> filter_read_pipe;
         VcfWriter output;
+        std::shared_ptr<const VcfWriter::ThreadPool> compression_pool;
         boost::optional<unsigned> num_threads;
         std::size_t read_buffer_size;
+        std::shared_ptr<MemoryBudget> read_memory_budget;
         boost::optional<Path> temp_directory;
         ProgressMeter progress_meter;
         bool sites_only;
+        bool index_task_planning;
         boost::optional<VcfWriter> filtered_output;
         boost::optional<Path> legacy;
         boost::optional<Path> filter_request_;
@@ -129,6 +137,7 @@ struct ContigCallingComponents
     std::reference_wrapper<const std::vector<SampleName>> samples;
     std::unique_ptr<const Caller> caller;
     std::size_t read_buffer_size;
+    bool index_task_planning;
     std::reference_wrapper<VcfWriter> output;
     std::reference_wrapper<ProgressMeter> progress_meter;
     
@@ -34,7 +34,8 @@ public:
                                       std::reference_wrapper<const SupportMaps>,
                                       std::reference_wrapper<const std::string>,
                                       std::reference_wrapper<const std::vector<std::string>>,
-                                      std::reference_wrapper<const Haplotype>
+                                      std::reference_wrapper<const Haplotype>,
+                                      double
                                      >;
     
     Facet() = default;
@@ -15,6 +15,7 @@
 #include "overlapping_reads.hpp"
 #include "read_assignments.hpp"
 #include "reference_context.hpp"
+#include "reference_gc_content.hpp"
 #include "samples.hpp"
 
 namespace octopus { namespace csr {
@@ -81,6 +82,8 @@ decltype(auto) name() noexcept
     return Facet().name();
 }
 
+constexpr GenomicRegion::Size reference_context_size {50};
+
 bool requires_reads(const std::string& facet) noexcept
 {
     const static std::array<std::string, 2> read_facets{name<OverlappingReads>(), name<ReadAssignments>()};
@@ -164,8 +167,15 @@ void FacetFactory::setup_facet_makers()
     facet_makers_[name<ReferenceContext>()] = [this] (const BlockData& block) -> FacetWrapper
     {
         if (block.region) {
-            constexpr GenomicRegion::Size context_size {50};
-            return {std::make_unique<ReferenceContext>(reference_, expand(*block.region, context_size))};
+            return {std::make_unique<ReferenceContext>(reference_, expand(*block.region, reference_context_size))};
+        } else {
+            return {nullptr};
+        }
+    };
+    facet_makers_[name<ReferenceGCContent>()] = [this] (const BlockData& block) -> FacetWrapper
+    {
+        if (block.region) {
+            return {std::make_unique<ReferenceGCContent>(reference_, expand(*block.region, reference_context_size))};
         } else {
             return {nullptr};
         }
@@ -0,0 +1,30 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "reference_gc_content.hpp"
+
+#include "io/reference/reference_annotation_index.hpp"
+#include "utils/sequence_utils.hpp"
+
+namespace octopus { namespace csr {
+
+const std::string ReferenceGCContent::name_ {"ReferenceGCContent"};
+
+ReferenceGCContent::ReferenceGCContent(const ReferenceGenome& reference, const GenomicRegion& region)
+: result_ {}
+{
+    // The annotation index gives the same answer without fetching the sequence
+    if (reference.has_annotations() && reference.annotations().has_contig(region.contig_name())) {
+        result_ = reference.annotations().gc_content(region);
+    } else {
+        result_ = utils::gc_content(reference.fetch_sequence(region));
+    }
+}
+
+Facet::ResultType ReferenceGCContent::do_get() const
+{
+    return result_;
+}
+
+} // namespace csr
+} // namespace octopus
@@ -0,0 +1,36 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef reference_gc_content_hpp
+#define reference_gc_content_hpp
+
+#include <string>
+
+#include "basics/genomic_region.hpp"
+#include "io/reference/reference_genome.hpp"
+#include "facet.hpp"
+
+namespace octopus { namespace csr {
+
+class ReferenceGCContent : public Facet
+{
+public:
+    using ResultType = double;
+    
+    ReferenceGCContent() = default;
+    
+    ReferenceGCContent(const ReferenceGenome& reference, const GenomicRegion& region);
+    
+private:
+    static const std::string name_;
+    
+    double result_;
+    
+    const std::string& do_name() const noexcept override { return name_; }
+    Facet::ResultType do_get() const override;
+};
+
+} // namespace csr
+} // namespace octopus
+
+#endif
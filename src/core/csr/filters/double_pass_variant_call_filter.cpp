@@ -41,13 +41,15 @@ void DoublePassVariantCallFilter::make_registration_pass(const VcfReader& source
 {
     if (info_log_) log_registration_pass_start(*info_log_);
     if (progress_) progress_->start();
+    // Measured values are stored, so only the fields they read need decoding until the filter pass
+    const auto fields = measured_fields();
     if (can_measure_single_call()) {
-        auto p = source.iterate();
+        auto p = source.iterate(fields);
         std::size_t idx {0};
         std::for_each(std::move(p.first), std::move(p.second), [&] (const VcfRecord& call) { record(call, idx++); });
     } else {
         std::size_t idx {0};
-        for (auto p = source.iterate(); p.first != p.second;) {
+        for (auto p = source.iterate(fields); p.first != p.second;) {
             const auto calls = read_next_block(p.first, p.second, samples);
             record(calls, idx);
             idx += calls.size();
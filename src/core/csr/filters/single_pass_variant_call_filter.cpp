@@ -30,19 +30,32 @@ void SinglePassVariantCallFilter::filter(const VcfReader& source, VcfWriter& des
 {
     assert(dest.is_header_written());
     if (progress_) progress_->start();
+    filter(source.iterate(), dest, samples);
+    if (progress_) progress_->stop();
+}
+
+void SinglePassVariantCallFilter::filter(const VcfReader& source, const GenomicRegion::ContigName& contig,
+                                         VcfWriter& dest, const SampleList& samples) const
+{
+    assert(dest.is_header_written());
+    filter(source.iterate(contig), dest, samples);
+}
+
+void SinglePassVariantCallFilter::filter(VcfReader::RecordIteratorPair calls, VcfWriter& dest, const SampleList& samples) const
+{
+    auto& first = calls.first;
+    const auto& last = calls.second;
     if (can_measure_multiple_blocks()) {
-        for (auto p = source.iterate(); p.first != p.second;) {
-            filter(read_next_blocks(p.first, p.second, samples), dest, samples);
+        while (first != last) {
+            filter(read_next_blocks(first, last, samples), dest, samples);
         }
     } else if (can_measure_single_call()) {
-        auto p = source.iterate();
-        std::for_each(std::move(p.first), std::move(p.second), [&] (const VcfRecord& call) { filter(call, dest, samples); });
+        std::for_each(std::move(calls.first), std::move(calls.second), [&] (const VcfRecord& call) { filter(call, dest, samples); });
     } else {
-        for (auto p = source.iterate(); p.first != p.second;) {
-            filter(read_next_block(p.first, p.second, samples), dest, samples);
+        while (first != last) {
+            filter(read_next_block(first, last, samples), dest, samples);
         }
     }
-    if (progress_) progress_->stop();
 }
 
 void SinglePassVariantCallFilter::filter(const VcfRecord& call, VcfWriter& dest, const SampleList& samples) const
@@ -32,6 +32,8 @@ public:
     
     virtual ~SinglePassVariantCallFilter() override = default;
     
+    bool is_contig_separable() const noexcept override { return true; }
+    
 protected:
     std::vector<std::string> measure_names_;
     
@@ -43,6 +45,9 @@ private:
     virtual Classification classify(const MeasureVector& call_measures) const = 0;
     
     void filter(const VcfReader& source, VcfWriter& dest, const SampleList& samples) const override;
+    void filter(const VcfReader& source, const GenomicRegion::ContigName& contig,
+                VcfWriter& dest, const SampleList& samples) const override;
+    void filter(VcfReader::RecordIteratorPair calls, VcfWriter& dest, const SampleList& samples) const;
     void filter(const VcfRecord& call, VcfWriter& dest, const SampleList& samples) const;
     void filter(const CallBlock& block, VcfWriter& dest, const SampleList& samples) const;
     void filter(const std::vector<CallBlock>& blocks, VcfWriter& dest, const SampleList& samples) const;
@@ -6,7 +6,13 @@
 #include <utility>
 #include <iterator>
 #include <algorithm>
-#include <numeric>
+#include <functional>
+#include <limits>
+#include <cmath>
+
+#include <boost/variant.hpp>
+#include <boost/optional.hpp>
+#include <boost/any.hpp>
 
 namespace octopus { namespace csr {
 
@@ -23,29 +29,77 @@ void UnsupervisedClusteringFilter::annotate(VcfHeader::Builder& header) const
     // TODO
 }
 
+namespace {
+
+constexpr double missing_feature {std::numeric_limits<double>::quiet_NaN()};
+
+template <typename T>
+double to_feature(const T value) noexcept
+{
+    return static_cast<double>(value);
+}
+
+template <typename T>
+double to_feature(const boost::optional<T>& value) noexcept
+{
+    return value ? to_feature(*value) : missing_feature;
+}
+
+class FeatureExtractor : public boost::static_visitor<>
+{
+public:
+    FeatureExtractor(std::vector<double>& result) : result_ {result} {}
+    template <typename T> void operator()(const T& value) const { result_.get().push_back(to_feature(value)); }
+    template <typename T> void operator()(const std::vector<T>& values) const
+    {
+        for (const T value : values) (*this)(value);
+    }
+    void operator()(const boost::any&) const {} // not a numeric feature
+private:
+    std::reference_wrapper<std::vector<double>> result_;
+};
+
+bool is_missing(const double feature) noexcept
+{
+    return std::isnan(feature);
+}
+
+} // namespace
+
 void UnsupervisedClusteringFilter::record(const std::size_t call_idx, MeasureVector measures) const
 {
-    if (data_.size() == call_idx) {
-        data_.push_back(std::move(measures));
-    } else if (call_idx > data_.size()) {
-        data_.resize(call_idx + 1);
-        data_.back() = std::move(measures);
-    } else {
-        data_[call_idx] = std::move(measures);
+    if (data_.size() < measures.size()) data_.resize(measures.size());
+    num_records_ = std::max(num_records_, call_idx + 1);
+    std::vector<double> features {};
+    for (std::size_t measure_idx {0}; measure_idx < measures.size(); ++measure_idx) {
+        features.clear();
+        boost::apply_visitor(FeatureExtractor {features}, measures[measure_idx]);
+        // Vector measures need not have the same width for every call, so elements missing here stay missing
+        auto& columns = data_[measure_idx];
+        if (columns.size() < features.size()) columns.resize(features.size());
+        for (std::size_t i {0}; i < features.size(); ++i) {
+            auto& column = columns[i];
+            if (column.size() < num_records_) column.resize(num_records_, missing_feature);
+            column[call_idx] = features[i];
+        }
     }
 }
 
 void UnsupervisedClusteringFilter::prepare_for_classification(boost::optional<Log>& log) const
 {
     if (log) {
-        stream(*log) << "CSR: clustering " << data_.size() << " records";
+        stream(*log) << "CSR: clustering " << num_records_ << " records";
+    }
+    for (auto& columns : data_) {
+        for (auto& column : columns) {
+            column.resize(num_records_, missing_feature);
+        }
     }
     remove_missing_features();
-    const auto num_calls = data_.size();
     // TODO
     data_.clear();
     data_.shrink_to_fit();
-    classifications_.resize(num_calls);
+    classifications_.resize(num_records_);
 }
 
 VariantCallFilter::Classification UnsupervisedClusteringFilter::classify(std::size_t call_idx) const
@@ -53,42 +107,13 @@ VariantCallFilter::Classification UnsupervisedClusteringFilter::classify(std::si
     return classifications_[call_idx];
 }
 
-bool UnsupervisedClusteringFilter::all_missing(const MeasureVector& measures) const noexcept
-{
-    return std::all_of(std::cbegin(measures), std::cend(measures),
-                       [] (const auto& measure) noexcept { return is_missing(measure); });
-}
-
 void UnsupervisedClusteringFilter::remove_missing_features() const
 {
-    if (!data_.empty()) {
-        const auto num_dimensions = data_.front().size();
-        std::vector<std::size_t> missing_columns(num_dimensions);
-        std::iota(std::begin(missing_columns), std::end(missing_columns), 0);
-        for (const auto& point : data_) {
-            for (auto itr = std::cbegin(missing_columns); itr != std::cend(missing_columns);) {
-                assert(*itr < point.size());
-                if (is_missing(point[*itr])) {
-                    ++itr;
-                } else {
-                    itr = missing_columns.erase(itr);
-                }
-            }
-            if (missing_columns.empty()) break;
-        }
-        if (!missing_columns.empty()) {
-            if (missing_columns.size() != num_dimensions) {
-                assert(std::is_sorted(std::cbegin(missing_columns), std::cend(missing_columns)));
-                for (auto& point : data_) {
-                    std::for_each(std::crbegin(missing_columns), std::crend(missing_columns),
-                                  [&point] (auto idx) { point.erase(std::next(std::cbegin(point), idx)); });
-        
-                }
-            } else {
-                data_.clear();
-                data_.shrink_to_fit();
-            }
-        }
+    const auto is_missing_column = [] (const FeatureColumn& column) {
+        return std::all_of(std::cbegin(column), std::cend(column), [] (double feature) { return is_missing(feature); });
+    };
+    for (auto& columns : data_) {
+        columns.erase(std::remove_if(std::begin(columns), std::end(columns), is_missing_column), std::end(columns));
     }
 }
 
@@ -5,7 +5,6 @@
 #define unsupervised_clustering_filter_hpp
 
 #include <vector>
-#include <deque>
 #include <cstddef>
 
 #include <boost/optional.hpp>
@@ -33,7 +32,12 @@ public:
     virtual ~UnsupervisedClusteringFilter() override = default;
     
 private:
-    mutable std::deque<MeasureVector> data_;
+    using FeatureColumn = std::vector<double>; // missing values are NaN
+    
+    // Numeric measures are stored by column, keyed by measure index and then by element index of vector
+    // (e.g. per-sample) measures
+    mutable std::vector<std::vector<FeatureColumn>> data_;
+    mutable std::size_t num_records_ = 0;
     mutable std::vector<Classification> classifications_;
     
     void annotate(VcfHeader::Builder& header) const override;
@@ -41,7 +45,6 @@ private:
     void prepare_for_classification(boost::optional<Log>& log) const override;
     Classification classify(std::size_t call_idx) const override;
     
-    bool all_missing(const MeasureVector& measures) const noexcept;
     void remove_missing_features() const;
 };
 
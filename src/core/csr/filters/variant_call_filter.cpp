@@ -12,6 +12,7 @@
 #include <limits>
 #include <cmath>
 #include <thread>
+#include <stdexcept>
 
 #include <boost/range/combine.hpp>
 
@@ -96,6 +97,15 @@ void VariantCallFilter::filter(const VcfReader& source, VcfWriter& dest) const
     filter(source, dest, samples);
 }
 
+void VariantCallFilter::filter(const VcfReader& source, const GenomicRegion::ContigName& contig, VcfWriter& dest) const
+{
+    if (!dest.is_header_written()) {
+        dest << make_header(source);
+    }
+    const auto samples = source.fetch_header().samples();
+    filter(source, contig, dest, samples);
+}
+
 // protected methods
 
 namespace {
@@ -149,6 +159,30 @@ bool VariantCallFilter::can_measure_single_call() const noexcept
     return facet_names_.empty();
 }
 
+namespace {
+
+void sort_unique(std::vector<std::string>& keys)
+{
+    std::sort(std::begin(keys), std::end(keys));
+    keys.erase(std::unique(std::begin(keys), std::end(keys)), std::end(keys));
+}
+
+} // namespace
+
+VcfReader::UnpackFields VariantCallFilter::measured_fields() const
+{
+    // Genotypes and phase sets are needed for call blocks and facets
+    VcfReader::UnpackFields result {{}, {vcfspec::format::genotype, vcfspec::format::phaseSet}};
+    for (const auto& measure : measures_) {
+        const auto fields = measure.vcf_requirements();
+        utils::append(fields.info, result.info);
+        utils::append(fields.format, result.format);
+    }
+    sort_unique(result.info);
+    sort_unique(result.format);
+    return result;
+}
+
 bool VariantCallFilter::can_measure_multiple_blocks() const noexcept
 {
     return is_multithreaded();
@@ -307,6 +341,12 @@ void VariantCallFilter::annotate(VcfRecord::Builder& call, const MeasureVector&
 
 // private methods
 
+void VariantCallFilter::filter(const VcfReader& source, const GenomicRegion::ContigName& contig,
+                               VcfWriter& dest, const SampleList& samples) const
+{
+    throw std::logic_error {"VariantCallFilter: filter cannot filter contigs separately"};
+}
+
 bool VariantCallFilter::is_soft_filtered(const ClassificationList& sample_classifications, const MeasureVector& measures) const
 {
     return std::all_of(std::cbegin(sample_classifications), std::cend(sample_classifications),
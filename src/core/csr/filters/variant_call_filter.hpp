@@ -64,6 +64,13 @@ public:
     virtual ~VariantCallFilter() = default;
     
     void filter(const VcfReader& source, VcfWriter& dest) const;
+    // Only filters calls on the given contig; requires is_contig_separable()
+    void filter(const VcfReader& source, const GenomicRegion::ContigName& contig, VcfWriter& dest) const;
+    
+    // True if calls are classified independently of calls on other contigs, so contigs can be filtered separately
+    virtual bool is_contig_separable() const noexcept { return false; }
+    
+    VcfHeader make_header(const VcfReader& source) const;
     
 protected:
     using SampleList    = std::vector<SampleName>;
@@ -87,6 +94,7 @@ protected:
     
     bool can_measure_single_call() const noexcept;
     bool can_measure_multiple_blocks() const noexcept;
+    VcfReader::UnpackFields measured_fields() const; // the fields any measure, facet, or call block reads
     CallBlock read_next_block(VcfIterator& first, const VcfIterator& last, const SampleList& samples) const;
     std::vector<CallBlock> read_next_blocks(VcfIterator& first, const VcfIterator& last, const SampleList& samples) const;
     MeasureVector measure(const VcfRecord& call) const;
@@ -110,11 +118,12 @@ private:
     
     virtual void annotate(VcfHeader::Builder& header) const = 0;
     virtual void filter(const VcfReader& source, VcfWriter& dest, const SampleList& samples) const = 0;
+    virtual void filter(const VcfReader& source, const GenomicRegion::ContigName& contig,
+                        VcfWriter& dest, const SampleList& samples) const;
     virtual boost::optional<std::string> call_quality_name() const { return boost::none; }
     virtual boost::optional<std::string> genotype_quality_name() const { return boost::none; }
     virtual bool is_soft_filtered(const ClassificationList& sample_classifications, const MeasureVector& measures) const;
     
-    VcfHeader make_header(const VcfReader& source) const;
     Measure::FacetMap compute_facets(const CallBlock& block) const;
     std::vector<Measure::FacetMap> compute_facets(const std::vector<CallBlock>& blocks) const;
     MeasureBlock measure(const CallBlock& block, const Measure::FacetMap& facets) const;
@@ -80,6 +80,19 @@ std::vector<std::string> Depth::do_requirements() const
     return result;
 }
 
+Measure::VcfFieldSet Depth::do_vcf_requirements() const
+{
+    VcfFieldSet result {};
+    if (!recalculate_) {
+        if (aggregate_) {
+            result.info.push_back(vcfspec::info::combinedReadDepth);
+        } else {
+            result.format.push_back(vcfspec::format::combinedReadDepth);
+        }
+    }
+    return result;
+}
+
 bool Depth::is_equal(const Measure& other) const noexcept
 {
     const auto& other_depth = static_cast<const Depth&>(other);
@@ -6,8 +6,7 @@
 #include <boost/variant.hpp>
 
 #include "io/variant/vcf_record.hpp"
-#include "utils/sequence_utils.hpp"
-#include "../facets/reference_context.hpp"
+#include "../facets/reference_gc_content.hpp"
 
 namespace octopus { namespace csr {
 
@@ -20,8 +19,7 @@ std::unique_ptr<Measure> GCContent::do_clone() const
 
 Measure::ResultType GCContent::do_evaluate(const VcfRecord& call, const FacetMap& facets) const
 {
-    const auto& reference = get_value<ReferenceContext>(facets.at("ReferenceContext"));
-    return utils::gc_content(reference.sequence());
+    return get_value<ReferenceGCContent>(facets.at("ReferenceGCContent"));
 }
 
 Measure::ResultCardinality GCContent::do_cardinality() const noexcept
@@ -41,7 +39,7 @@ std::string GCContent::do_describe() const
 
 std::vector<std::string> GCContent::do_requirements() const
 {
-    return {"ReferenceContext"};
+    return {"ReferenceGCContent"};
 }
 
 } // namespace csr
@@ -58,5 +58,10 @@ std::vector<std::string> GenotypeQuality::do_requirements() const
     return {"Samples"};
 }
 
+Measure::VcfFieldSet GenotypeQuality::do_vcf_requirements() const
+{
+    return VcfFieldSet {{}, {vcfspec::format::conditionalQuality}};
+}
+
 } // namespace csr
 } // namespace octopus
@@ -35,5 +35,10 @@ std::string IsDenovo::do_describe() const
     return "Is the call marked DENOVO";
 }
 
+Measure::VcfFieldSet IsDenovo::do_vcf_requirements() const
+{
+    return VcfFieldSet {{vcf::spec::info::denovo}};
+}
+
 } // namespace csr
 } // namespace octopus
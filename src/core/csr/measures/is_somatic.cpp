@@ -8,6 +8,7 @@
 #include <cassert>
 
 #include "io/variant/vcf_record.hpp"
+#include "io/variant/vcf_spec.hpp"
 #include "../facets/samples.hpp"
 
 namespace octopus { namespace csr {
@@ -78,5 +79,10 @@ std::vector<std::string> IsSomatic::do_requirements() const
     }
 }
 
+Measure::VcfFieldSet IsSomatic::do_vcf_requirements() const
+{
+    return VcfFieldSet {{vcfspec::info::somatic}};
+}
+
 } // namespace csr
 } // namespace octopus
@@ -54,6 +54,13 @@ std::vector<std::string> MappingQualityZeroCount::do_requirements() const
     }
 }
 
+Measure::VcfFieldSet MappingQualityZeroCount::do_vcf_requirements() const
+{
+    VcfFieldSet result {};
+    if (!recalculate_) result.info.push_back("MQ0");
+    return result;
+}
+
 bool MappingQualityZeroCount::is_equal(const Measure& other) const noexcept
 {
     return recalculate_ == static_cast<const MappingQualityZeroCount&>(other).recalculate_;
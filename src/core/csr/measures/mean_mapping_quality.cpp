@@ -58,6 +58,13 @@ std::vector<std::string> MeanMappingQuality::do_requirements() const
     }
 }
 
+Measure::VcfFieldSet MeanMappingQuality::do_vcf_requirements() const
+{
+    VcfFieldSet result {};
+    if (!recalculate_) result.info.push_back(vcfspec::info::rmsMappingQuality);
+    return result;
+}
+
 bool MeanMappingQuality::is_equal(const Measure& other) const noexcept
 {
     return recalculate_ == static_cast<const MeanMappingQuality&>(other).recalculate_;
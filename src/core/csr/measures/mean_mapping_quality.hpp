@@ -25,6 +25,7 @@ class MeanMappingQuality : public Measure
     const std::string& do_name() const override;
     std::string do_describe() const override;
     std::vector<std::string> do_requirements() const override;
+    VcfFieldSet do_vcf_requirements() const override;
     bool is_equal(const Measure& other) const noexcept override;
 public:
     MeanMappingQuality(bool recalculate = true);
@@ -17,6 +17,7 @@
 #include "concepts/equitable.hpp"
 #include "io/variant/vcf_header.hpp"
 #include "io/variant/vcf_record.hpp"
+#include "io/variant/vcf_reader.hpp"
 #include "../facets/facet.hpp"
 
 namespace octopus { namespace csr {
@@ -34,6 +35,7 @@ public:
                                       bool, std::vector<bool>,
                                       boost::any>;
     enum class ResultCardinality { one, num_alleles, num_samples };
+    using VcfFieldSet = VcfReader::UnpackFields;
     
     Measure() = default;
     
@@ -51,6 +53,7 @@ public:
     const std::string& name() const { return do_name(); }
     std::string describe() const { return do_describe(); }
     std::vector<std::string> requirements() const { return do_requirements(); }
+    VcfFieldSet vcf_requirements() const { return do_vcf_requirements(); } // fields read from the call, other than GT
     std::string serialise(const ResultType& value) const { return do_serialise(value); }
     void annotate(VcfHeader::Builder& header) const;
     void annotate(VcfRecord::Builder& record, const ResultType& value) const;
@@ -66,6 +69,7 @@ private:
     virtual const std::string& do_name() const = 0;
     virtual std::string do_describe() const = 0;
     virtual std::vector<std::string> do_requirements() const { return {}; }
+    virtual VcfFieldSet do_vcf_requirements() const { return {}; }
     virtual std::string do_serialise(const ResultType& value) const;
     virtual bool is_required_vcf_field() const noexcept { return false; }
     virtual bool is_equal(const Measure& other) const noexcept { return true; }
@@ -96,6 +100,7 @@ public:
     const std::string& name() const { return measure_->name(); }
     std::string describe() const { return measure_->describe(); }
     std::vector<std::string> requirements() const { return measure_->requirements(); }
+    Measure::VcfFieldSet vcf_requirements() const { return measure_->vcf_requirements(); }
     std::string serialise(const Measure::ResultType& value) const { return measure_->serialise(value); }
     void annotate(VcfHeader::Builder& header) const { measure_->annotate(header); }
     void annotate(VcfRecord::Builder& record, const Measure::ResultType& value) const { measure_->annotate(record, value); }
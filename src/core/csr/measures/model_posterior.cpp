@@ -40,5 +40,10 @@ std::string ModelPosterior::do_describe() const
     return "Model posterior for this haplotype block";
 }
 
+Measure::VcfFieldSet ModelPosterior::do_vcf_requirements() const
+{
+    return VcfFieldSet {{vcf::spec::info::modelPosterior}};
+}
+
 } // namespace csr
 } // namespace octopus
@@ -22,6 +22,7 @@ class ModelPosterior : public Measure
     ResultCardinality do_cardinality() const noexcept override;
     const std::string& do_name() const override;
     std::string do_describe() const override;
+    VcfFieldSet do_vcf_requirements() const override;
 };
 
 } // namespace csr
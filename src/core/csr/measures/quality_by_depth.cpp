@@ -49,6 +49,11 @@ std::vector<std::string> QualityByDepth::do_requirements() const
     return depth_.requirements();
 }
 
+Measure::VcfFieldSet QualityByDepth::do_vcf_requirements() const
+{
+    return depth_.vcf_requirements();
+}
+
 bool QualityByDepth::is_equal(const Measure& other) const noexcept
 {
     return depth_ == static_cast<const Depth&>(other);
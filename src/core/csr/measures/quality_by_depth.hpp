@@ -26,6 +26,7 @@ class QualityByDepth : public Measure
     const std::string& do_name() const override;
     std::string do_describe() const override;
     std::vector<std::string> do_requirements() const override;
+    VcfFieldSet do_vcf_requirements() const override;
     bool is_equal(const Measure& other) const noexcept override;
 public:
     QualityByDepth(bool recalculate = false);
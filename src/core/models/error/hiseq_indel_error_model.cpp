@@ -9,6 +9,7 @@
 #include "tandem/tandem.hpp"
 
 #include "core/types/haplotype.hpp"
+#include "utils/repeat_finder.hpp"
 
 namespace octopus {
 
@@ -27,7 +28,7 @@ namespace {
 
 auto extract_repeats(const Haplotype& haplotype)
 {
-    return tandem::extract_exact_tandem_repeats(haplotype.sequence(), 1, 3);
+    return find_short_tandem_repeats(haplotype.sequence(), 1, 3);
 }
 
 template <typename C, typename T>
@@ -10,6 +10,7 @@
 #include <tandem/tandem.hpp>
 
 #include <core/types/haplotype.hpp>
+#include <utils/repeat_finder.hpp>
 
 namespace octopus {
 
@@ -24,7 +25,7 @@ namespace {
 
 auto extract_repeats(const Haplotype& haplotype, const unsigned max_period)
 {
-    return tandem::extract_exact_tandem_repeats(haplotype.sequence(), 1, max_period);
+    return extract_exact_tandem_repeats(haplotype.sequence(), 1, max_period);
 }
 
 template <typename ForwardIt, typename OutputIt>
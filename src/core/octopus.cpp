@@ -8,6 +8,7 @@
 #include <queue>
 #include <map>
 #include <set>
+#include <unordered_set>
 #include <algorithm>
 #include <numeric>
 #include <memory>
@@ -16,6 +17,7 @@
 #include <typeinfo>
 #include <thread>
 #include <future>
+#include <exception>
 #include <condition_variable>
 #include <mutex>
 #include <atomic>
@@ -25,6 +27,7 @@
 #include <cassert>
 
 #include <boost/optional.hpp>
+#include <boost/filesystem/operations.hpp>
 
 #include "config/common.hpp"
 #include "basics/genomic_region.hpp"
@@ -33,6 +36,7 @@
 #include "containers/mappable_map.hpp"
 #include "io/reference/reference_genome.hpp"
 #include "io/read/read_manager.hpp"
+#include "io/read/read_buffer_pool.hpp"
 #include "readpipe/read_pipe_fwd.hpp"
 #include "readpipe/buffered_read_pipe.hpp"
 #include "utils/mappable_algorithms.hpp"
@@ -48,6 +52,7 @@
 #include "core/tools/vcf_header_factory.hpp"
 #include "io/variant/vcf.hpp"
 #include "utils/timing.hpp"
+#include "utils/memory_footprint.hpp"
 #include "exceptions/program_error.hpp"
 #include "csr/filters/variant_call_filter.hpp"
 #include "csr/filters/variant_call_filter_factory.hpp"
@@ -401,6 +406,22 @@ void run_octopus_single_threaded(GenomeCallingComponents& components)
     #endif
 }
 
+// Temporary files use the output's format when it is compressed so they can be appended without being decoded
+std::string get_temp_output_extension(const VcfWriter& output)
+{
+    const auto output_path = output.path();
+    if (output_path && output_path->extension() == ".gz") {
+        return ".vcf.gz";
+    } else {
+        return ".bcf";
+    }
+}
+
+std::string get_temp_output_extension(const GenomeCallingComponents& components)
+{
+    return get_temp_output_extension(components.output());
+}
+
 VcfWriter create_unique_temp_output_file(const GenomicRegion& region,
                                          const GenomeCallingComponents& components)
 {
@@ -408,12 +429,12 @@ VcfWriter create_unique_temp_output_file(const GenomicRegion& region,
     const auto& contig = region.contig_name();
     const auto begin   = std::to_string(region.begin());
     const auto end     = std::to_string(region.end());
-    boost::filesystem::path file_name {contig + "_" + begin + "-" + end + "_temp.bcf"};
+    boost::filesystem::path file_name {contig + "_" + begin + "-" + end + "_temp" + get_temp_output_extension(components)};
     path /= file_name;
     const auto call_types = get_call_types(components, {region.contig_name()});
     auto header = make_vcf_header(components.samples(), contig, components.reference(), call_types,
                                   "octopus-internal");
-    return VcfWriter {std::move(path), std::move(header)};
+    return VcfWriter {std::move(path), std::move(header), components.compression_pool()};
 }
 
 VcfWriter create_unique_temp_output_file(const GenomicRegion::ContigName& contig,
@@ -502,11 +523,52 @@ struct TaskMakerSyncPacket
     std::atomic_bool all_done;
 };
 
+// Splits the region into windows of window_size and greedily groups consecutive windows into tasks using index read
+// count estimates, so no reads are touched.
+boost::optional<std::deque<GenomicRegion>>
+plan_region_tasks(const GenomicRegion& region, const ContigCallingComponents& components,
+                  const GenomicRegion::Size window_size)
+{
+    const auto window_read_counts = components.read_manager.get().estimate_read_counts(components.samples, region, window_size);
+    if (!window_read_counts) return boost::none;
+    std::deque<GenomicRegion> result {};
+    auto task_begin = region.begin();
+    std::size_t task_read_count {0};
+    for (std::size_t i {0}; i < window_read_counts->size(); ++i) {
+        const auto window_begin = region.begin() + static_cast<GenomicRegion::Position>(i * window_size);
+        const auto window_read_count = (*window_read_counts)[i];
+        if (window_begin > task_begin && task_read_count + window_read_count > components.read_buffer_size) {
+            result.emplace_back(region.contig_name(), task_begin, window_begin);
+            task_begin = window_begin;
+            task_read_count = 0;
+        }
+        task_read_count += window_read_count;
+    }
+    result.emplace_back(region.contig_name(), task_begin, region.end());
+    return result;
+}
+
 void make_region_tasks(const GenomicRegion& region, const ContigCallingComponents& components, const ExecutionPolicy policy,
                        TaskQueue& result, TaskMakerSyncPacket& sync, const bool last_region_in_contig, const bool last_contig)
 {
     static constexpr GenomicRegion::Size minTaskSize {5'000};
     std::unique_lock<std::mutex> lock {sync.mutex, std::defer_lock};
+    if (components.index_task_planning) {
+        auto tasks = plan_region_tasks(region, components, minTaskSize);
+        if (tasks) {
+            lock.lock();
+            sync.cv.wait(lock, [&] () { return sync.ready; });
+            for (auto&& r : *tasks) result.emplace(std::move(r), policy);
+            sync.num_tasks += tasks->size();
+            if (last_region_in_contig) {
+                sync.finished.at(region.contig_name()) = true;
+                if (last_contig) sync.all_done = true;
+            }
+            lock.unlock();
+            sync.cv.notify_one();
+            return;
+        }
+    }
     auto subregion = propose_call_subregion(components, region, minTaskSize);
     if (ends_equal(subregion, region)) {
         lock.lock();
@@ -659,7 +721,7 @@ unsigned calculate_num_task_threads(const GenomeCallingComponents& components)
     }
 }
 
-Task pop(TaskMap& tasks, TaskMakerSyncPacket& sync)
+Task pop(TaskMap& tasks, TaskMakerSyncPacket& sync, bool& last_contig_task)
 {
     assert(!tasks.empty());
     std::unique_lock<std::mutex> lock {sync.mutex};
@@ -669,7 +731,8 @@ Task pop(TaskMap& tasks, TaskMakerSyncPacket& sync)
     assert(!contig_task_itr->second.empty());
     const auto result = std::move(contig_task_itr->second.front());
     contig_task_itr->second.pop();
-    if (sync.finished.at(contig_task_itr->first) && contig_task_itr->second.empty()) {
+    last_contig_task = sync.finished.at(contig_task_itr->first) && contig_task_itr->second.empty();
+    if (last_contig_task) {
         static auto debug_log = get_debug_log();
         if (debug_log) stream(*debug_log) << "Finished calling contig " << contig_task_itr->first;
         tasks.erase(contig_task_itr);
@@ -701,47 +764,200 @@ std::ostream& operator<<(std::ostream& os, const CompletedTask& task)
     return os;
 }
 
+using ContigCallingComponentFactory    = std::function<ContigCallingComponents()>;
+using ContigCallingComponentFactoryMap = std::map<ContigName, ContigCallingComponentFactory>;
+
+auto make_contig_calling_component_factory_map(GenomeCallingComponents& components)
+{
+    ContigCallingComponentFactoryMap result {};
+    for (const auto& contig : components.contigs()) {
+        result.emplace(contig, [&components, contig] () -> ContigCallingComponents
+                       { return ContigCallingComponents {contig, components}; });
+    }
+    return result;
+}
+
 struct CallerSyncPacket
 {
     CallerSyncPacket() : num_finished {0} {}
     std::condition_variable cv;
     std::mutex mutex;
     std::atomic_uint num_finished;
+    std::deque<CompletedTask> completed = {};
+    std::exception_ptr error = nullptr;
+};
+
+bool is_read_memory_exceeded(const GenomeCallingComponents& components) noexcept
+{
+    const auto budget = components.read_memory_budget();
+    return budget && budget->is_exceeded();
+}
+
+// Persistent calling threads that take submitted tasks in order. Each worker keeps the components for the
+// contig of its last task, so consecutive tasks on the same contig reuse the caller rather than making a new one.
+// The components are released once the last task of the contig has been submitted and there is nothing left to
+// reuse them for. Finished tasks are handed back through the CallerSyncPacket, and the driver is woken through
+// both sync packets.
+class CallingWorkerPool
+{
+public:
+    CallingWorkerPool(unsigned num_workers, const ContigCallingComponentFactoryMap& calling_components,
+                      CallerSyncPacket& caller_sync, TaskMakerSyncPacket& task_maker_sync);
+    
+    CallingWorkerPool(const CallingWorkerPool&)            = delete;
+    CallingWorkerPool& operator=(const CallingWorkerPool&) = delete;
+    
+    ~CallingWorkerPool();
+    
+    void submit(Task task, bool last_contig_task = false);
+    void join(); // runs all submitted tasks first
+    
+private:
+    const ContigCallingComponentFactoryMap& calling_components_;
+    CallerSyncPacket& caller_sync_;
+    TaskMakerSyncPacket& task_maker_sync_;
+    std::deque<Task> tasks_;
+    std::unordered_set<ContigName> finished_contigs_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool done_;
+    std::vector<std::thread> workers_;
+    
+    void work();
+    void finish(CompletedTask&& task);
+    void fail(const Task& task);
+    void notify_driver();
 };
 
-template<typename R>
-bool is_ready(const std::future<R>& f)
+CallingWorkerPool::CallingWorkerPool(const unsigned num_workers,
+                                     const ContigCallingComponentFactoryMap& calling_components,
+                                     CallerSyncPacket& caller_sync, TaskMakerSyncPacket& task_maker_sync)
+: calling_components_ {calling_components}
+, caller_sync_ {caller_sync}
+, task_maker_sync_ {task_maker_sync}
+, tasks_ {}
+, finished_contigs_ {}
+, mutex_ {}
+, cv_ {}
+, done_ {false}
+, workers_ {}
 {
-    return f.valid() && f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    workers_.reserve(num_workers);
+    for (unsigned i {0}; i < num_workers; ++i) {
+        workers_.emplace_back(&CallingWorkerPool::work, this);
+    }
 }
 
-auto run(Task task, ContigCallingComponents components, CallerSyncPacket& sync)
+CallingWorkerPool::~CallingWorkerPool()
+{
+    std::unique_lock<std::mutex> lock {mutex_};
+    tasks_.clear(); // only non-empty if the driver gave up early
+    lock.unlock();
+    join();
+}
+
+void CallingWorkerPool::submit(Task task, const bool last_contig_task)
 {
     static auto debug_log = get_debug_log();
-    if (debug_log) stream(*debug_log) << "Spawning task " << task;
-    return std::async(std::launch::async, [task = std::move(task), components = std::move(components), &sync] () {
+    if (debug_log) stream(*debug_log) << "Submitting task " << task;
+    std::unique_lock<std::mutex> lock {mutex_};
+    if (last_contig_task) finished_contigs_.insert(contig_name(task));
+    tasks_.push_back(std::move(task));
+    lock.unlock();
+    if (last_contig_task) {
+        cv_.notify_all(); // wake any idle workers holding components for the contig
+    } else {
+        cv_.notify_one();
+    }
+}
+
+void CallingWorkerPool::join()
+{
+    std::unique_lock<std::mutex> lock {mutex_};
+    done_ = true;
+    lock.unlock();
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void CallingWorkerPool::work()
+{
+    boost::optional<ContigName> contig {};
+    boost::optional<ContigCallingComponents> components {};
+    std::unique_lock<std::mutex> lock {mutex_, std::defer_lock};
+    while (true) {
+        lock.lock();
+        cv_.wait(lock, [&] () { return !tasks_.empty() || done_ || (contig && finished_contigs_.count(*contig) > 0); });
+        if (tasks_.empty()) {
+            if (done_) break;
+            lock.unlock();
+            components = boost::none;
+            contig = boost::none;
+            continue;
+        }
+        auto task = std::move(tasks_.front());
+        tasks_.pop_front();
+        lock.unlock();
         try {
+            if (!contig || *contig != contig_name(task)) {
+                components = boost::none; // release the old caller first
+                components.emplace(calling_components_.at(contig_name(task))());
+                contig = contig_name(task);
+            }
             CompletedTask result {task};
             result.runtime.start = std::chrono::system_clock::now();
-            result.calls = components.caller->call(task.region, components.progress_meter);
+            result.calls = components->caller->call(task.region, components->progress_meter);
             result.runtime.end = std::chrono::system_clock::now();
-            std::unique_lock<std::mutex> lock {sync.mutex};
-            ++sync.num_finished;
-            lock.unlock();
-            sync.cv.notify_all();
-            return result;
+            finish(std::move(result));
         } catch (...) {
-            logging::ErrorLogger error_log {};
-            stream(error_log) << "Encountered a problem whilst calling " << task;
-            using namespace std::chrono_literals;
-            std::this_thread::sleep_for(2s); // Try to make sure the error is logged before raising
-            std::unique_lock<std::mutex> lock {sync.mutex};
-            ++sync.num_finished;
-            lock.unlock();
-            sync.cv.notify_all();
-            throw;
+            components = boost::none;
+            contig = boost::none;
+            fail(task);
         }
-    });
+    }
+}
+
+void CallingWorkerPool::finish(CompletedTask&& task)
+{
+    std::unique_lock<std::mutex> lock {caller_sync_.mutex};
+    caller_sync_.completed.push_back(std::move(task));
+    ++caller_sync_.num_finished;
+    lock.unlock();
+    notify_driver();
+}
+
+void CallingWorkerPool::fail(const Task& task)
+{
+    logging::ErrorLogger error_log {};
+    stream(error_log) << "Encountered a problem whilst calling " << task;
+    using namespace std::chrono_literals;
+    std::this_thread::sleep_for(2s); // Try to make sure the error is logged before raising
+    std::unique_lock<std::mutex> lock {caller_sync_.mutex};
+    if (!caller_sync_.error) caller_sync_.error = std::current_exception();
+    ++caller_sync_.num_finished;
+    lock.unlock();
+    notify_driver();
+}
+
+void CallingWorkerPool::notify_driver()
+{
+    caller_sync_.cv.notify_all();
+    // The driver may be waiting for new tasks, so take the task maker lock to be sure it sees num_finished
+    std::unique_lock<std::mutex> lock {task_maker_sync_.mutex};
+    lock.unlock();
+    task_maker_sync_.cv.notify_all();
+}
+
+std::deque<CompletedTask> take_completed_tasks(CallerSyncPacket& sync)
+{
+    std::deque<CompletedTask> result {};
+    std::unique_lock<std::mutex> lock {sync.mutex};
+    if (sync.error) std::rethrow_exception(sync.error);
+    std::swap(sync.completed, result);
+    sync.num_finished = 0;
+    return result;
 }
 
 using CompletedTaskMap = std::map<ContigName, std::map<ContigRegion, CompletedTask>>;
@@ -771,19 +987,6 @@ auto get_writable_completed_tasks(CompletedTask&& task, CompletedTaskMap::mapped
     return result;
 }
 
-using ContigCallingComponentFactory    = std::function<ContigCallingComponents()>;
-using ContigCallingComponentFactoryMap = std::map<ContigName, ContigCallingComponentFactory>;
-
-auto make_contig_calling_component_factory_map(GenomeCallingComponents& components)
-{
-    ContigCallingComponentFactoryMap result {};
-    for (const auto& contig : components.contigs()) {
-        result.emplace(contig, [&components, contig] () -> ContigCallingComponents
-                       { return ContigCallingComponents {contig, components}; });
-    }
-    return result;
-}
-
 auto find_first_lhs_connecting(const std::deque<VcfRecord>& lhs_calls, const GenomicRegion& rhs_region)
 {
     const auto rhs_begin = mapped_begin(rhs_region);
@@ -975,17 +1178,8 @@ void wait_until_finished(TaskWriterSyncPacket& sync)
     sync.cv.notify_one();
 }
 
-using FutureCompletedTasks = std::vector<std::future<CompletedTask>>;
 using RemainingTaskMap = std::map<ContigName, std::deque<CompletedTask>>;
 
-void extract_remaining_future_tasks(FutureCompletedTasks& futures, std::deque<CompletedTask>& result)
-{
-    const auto itr = std::remove_if(std::begin(futures), std::end(futures), [] (const auto& f) { return !f.valid(); });
-    std::transform(std::begin(futures), itr, std::back_inserter(result), [] (auto& fut) { return fut.get(); });
-    futures.clear();
-    futures.shrink_to_fit();
-}
-
 void extract_buffered_tasks(CompletedTaskMap& buffered_tasks, std::deque<CompletedTask>& result)
 {
     for (auto& p : buffered_tasks) {
@@ -1012,10 +1206,9 @@ RemainingTaskMap make_map(std::deque<CompletedTask>& tasks)
     return result;
 }
 
-RemainingTaskMap extract_remaining_tasks(FutureCompletedTasks& futures, CompletedTaskMap& buffered_tasks)
+RemainingTaskMap extract_remaining_tasks(CallerSyncPacket& caller_sync, CompletedTaskMap& buffered_tasks)
 {
-    std::deque<CompletedTask> tasks {};
-    extract_remaining_future_tasks(futures, tasks);
+    auto tasks = take_completed_tasks(caller_sync);
     extract_buffered_tasks(buffered_tasks, tasks);
     return make_map(tasks);
 }
@@ -1035,43 +1228,46 @@ void write(RemainingTaskMap&& remaining_tasks, TempVcfWriterMap& temp_vcfs)
     }
 }
 
-void write_remaining_tasks(FutureCompletedTasks& futures, CompletedTaskMap& buffered_tasks, TempVcfWriterMap& temp_vcfs,
-                           const ContigCallingComponentFactoryMap& calling_components)
+void write_remaining_tasks(CallingWorkerPool& workers, CallerSyncPacket& caller_sync, CompletedTaskMap& buffered_tasks,
+                           TempVcfWriterMap& temp_vcfs, const ContigCallingComponentFactoryMap& calling_components)
 {
     static auto debug_log = get_debug_log();
-    if (debug_log) stream(*debug_log) << "Waiting for " << futures.size() << " running tasks to finish";
-    auto remaining_tasks = extract_remaining_tasks(futures, buffered_tasks);
+    if (debug_log) *debug_log << "Waiting for running tasks to finish";
+    workers.join();
+    auto remaining_tasks = extract_remaining_tasks(caller_sync, buffered_tasks);
     resolve_connecting_calls(remaining_tasks, calling_components);
     write(std::move(remaining_tasks), temp_vcfs);
 }
 
-auto extract_writers(TempVcfWriterMap&& vcfs)
+auto close_in_contig_order(TempVcfWriterMap& vcfs, const std::vector<ContigName>& contigs)
 {
-    std::vector<VcfWriter> result {};
+    std::vector<boost::filesystem::path> result {};
     result.reserve(vcfs.size());
-    for (auto&& p : vcfs) {
-        result.push_back(std::move(p.second));
+    for (const auto& contig : contigs) {
+        auto& writer = vcfs.at(contig);
+        auto path = writer.path();
+        writer.close();
+        if (path) result.push_back(std::move(*path));
     }
-    vcfs.clear();
     return result;
 }
 
-auto extract_as_readers(TempVcfWriterMap&& vcfs)
-{
-    return writers_to_readers(extract_writers(std::move(vcfs)));
-}
-
 void merge(TempVcfWriterMap&& temp_vcf_writers, GenomeCallingComponents& components)
 {
     static auto debug_log = get_debug_log();
     if (debug_log) stream(*debug_log) << "Merging " << temp_vcf_writers.size() << " temporary VCF files";
-    auto temp_readers = extract_as_readers(std::move(temp_vcf_writers));
-    merge(temp_readers, components.output(), components.contigs());
+    // Each temporary file holds a single contig, so they only need concatenating in contig order
+    const auto temp_paths = close_in_contig_order(temp_vcf_writers, components.contigs());
+    concatenate(temp_paths, components.output());
+    // The temporary files are no longer needed, and removing them first stops their writers indexing them
+    for (const auto& path : temp_paths) {
+        boost::filesystem::remove(path);
+    }
+    temp_vcf_writers.clear();
 }
 
 void run_octopus_multi_threaded(GenomeCallingComponents& components)
 {
-    using namespace std::chrono_literals;
     static auto debug_log = get_debug_log();
     
     const auto num_task_threads = calculate_num_task_threads(components);
@@ -1088,7 +1284,6 @@ void run_octopus_multi_threaded(GenomeCallingComponents& components)
     }
     task_maker_thread.detach();
     
-    FutureCompletedTasks futures(num_task_threads);
     TaskMap running_tasks {ContigOrder {components.contigs()}};
     CompletedTaskMap buffered_tasks {};
     std::map<ContigName, HoldbackTask> holdbacks {};
@@ -1101,7 +1296,7 @@ void run_octopus_multi_threaded(GenomeCallingComponents& components)
     
     CallerSyncPacket caller_sync {};
     const auto calling_components = make_contig_calling_component_factory_map(components);
-    unsigned num_idle_futures {0};
+    unsigned num_running_tasks {0};
     
     auto temp_writers = make_temp_vcf_writers(components);
     TaskWriterSyncPacket task_writer_sync {};
@@ -1122,57 +1317,64 @@ void run_octopus_multi_threaded(GenomeCallingComponents& components)
     }
     task_maker_sync.batch_size_hint = num_task_threads / 2;
     
+    CallingWorkerPool workers {num_task_threads, calling_components, caller_sync, task_maker_sync};
+    
     components.progress_meter().start();
     
     while (!task_maker_sync.all_done || task_maker_sync.num_tasks > 0) {
         pending_task_lock.lock();
         assert(count_tasks(pending_tasks) == task_maker_sync.num_tasks);
         if (!task_maker_sync.all_done && task_maker_sync.num_tasks == 0) {
-            task_maker_sync.batch_size_hint = std::max(num_idle_futures, num_task_threads / 2);
-            if (num_idle_futures < futures.size()) {
-                // If there are running futures then it's good periodically check to see if
-                // any have finished and process them while we wait for the task maker.
-                while (task_maker_sync.num_tasks == 0 && caller_sync.num_finished == 0) {
-                    auto now = std::chrono::system_clock::now();
-                    task_maker_sync.cv.wait_until(pending_task_lock, now + 5s, tasks_available);
-                }
-            } else {
-                task_maker_sync.cv.wait(pending_task_lock, tasks_available);
-            }
+            const auto num_idle_workers = num_task_threads - num_running_tasks;
+            task_maker_sync.batch_size_hint = std::max(num_idle_workers, num_task_threads / 2);
+            // Workers notify the task maker condition variable when they finish, so finished tasks
+            // can be processed while we wait for the task maker.
+            task_maker_sync.cv.wait(pending_task_lock,
+                                    [&] () { return tasks_available() || caller_sync.num_finished > 0; });
         }
         pending_task_lock.unlock();
-        num_idle_futures = 0;
-        for (auto& future : futures) {
-            if (is_ready(future)) {
-                auto completed_task = future.get();
-                const auto& contig = contig_name(completed_task.region);
-                write_or_buffer(std::move(completed_task), buffered_tasks.at(contig),
-                                running_tasks.at(contig), holdbacks.at(contig),
-                                task_writer_sync, calling_components.at(contig));
-                --caller_sync.num_finished;
-            }
-            if (!future.valid()) {
-                pending_task_lock.lock();
-                if (task_maker_sync.num_tasks > 0) {
-                    pending_task_lock.unlock(); // As pop will need to lock the mutex too == deadlock
-                    auto task = pop(pending_tasks, task_maker_sync);
-                    future = run(task, calling_components.at(contig_name(task))(), caller_sync);
-                    running_tasks.at(contig_name(task)).push(std::move(task));
-                } else {
-                    pending_task_lock.unlock();
-                    ++num_idle_futures;
-                }
+        for (auto&& completed_task : take_completed_tasks(caller_sync)) {
+            const auto& contig = contig_name(completed_task.region);
+            write_or_buffer(std::move(completed_task), buffered_tasks.at(contig),
+                            running_tasks.at(contig), holdbacks.at(contig),
+                            task_writer_sync, calling_components.at(contig));
+            --num_running_tasks;
+        }
+        unsigned num_held_tasks {0};
+        while (num_running_tasks < num_task_threads) {
+            pending_task_lock.lock();
+            if (task_maker_sync.num_tasks > 0 && is_read_memory_exceeded(components) && num_running_tasks > 0) {
+                // Starting another task would only add to the reads held, so wait for one to finish
+                pending_task_lock.unlock();
+                num_held_tasks = num_task_threads - num_running_tasks;
+                break;
+            } else if (task_maker_sync.num_tasks > 0) {
+                pending_task_lock.unlock(); // As pop will need to lock the mutex too == deadlock
+                bool last_contig_task {false};
+                auto task = pop(pending_tasks, task_maker_sync, last_contig_task);
+                running_tasks.at(contig_name(task)).push(task);
+                workers.submit(std::move(task), last_contig_task);
+                ++num_running_tasks;
+            } else {
+                pending_task_lock.unlock();
+                break;
             }
         }
-        // If there are no idle futures then all threads are busy and we must wait for one to finish,
-        // otherwise we must have run out of tasks, so we should wait for new ones.
-        if (num_idle_futures == 0 && caller_sync.num_finished == 0) {
+        if (debug_log && num_held_tasks > 0) {
+            stream(*debug_log) << "Holding back " << num_held_tasks << " tasks as reads held by running tasks use "
+                               << components.read_memory_budget()->used();
+        }
+        // If there are no idle workers then all threads are busy (or held back) and we must wait for one to
+        // finish, otherwise we must have run out of tasks, so we should wait for new ones.
+        if ((num_running_tasks == num_task_threads || num_held_tasks > 0) && caller_sync.num_finished == 0) {
             task_maker_sync.waiting = false;
             std::unique_lock<std::mutex> lock {caller_sync.mutex};
             caller_sync.cv.wait(lock, [&] () { return caller_sync.num_finished > 0; });
             task_maker_sync.waiting = true;
         } else {
-            if (debug_log) stream(*debug_log) << "There are " << num_idle_futures << " idle futures";
+            if (debug_log) {
+                stream(*debug_log) << "There are " << (num_task_threads - num_running_tasks) << " idle workers";
+            }
         }
     }
     assert(task_maker_sync.num_tasks == 0);
@@ -1181,7 +1383,7 @@ void run_octopus_multi_threaded(GenomeCallingComponents& components)
     holdbacks.clear(); // holdbacks are just references to buffered tasks
     if (debug_log) *debug_log << "Finished making new tasks. Waiting for task writer to complete existing jobs";
     wait_until_finished(task_writer_sync);
-    write_remaining_tasks(futures, buffered_tasks, temp_writers, calling_components);
+    write_remaining_tasks(workers, caller_sync, buffered_tasks, temp_writers, calling_components);
     components.progress_meter().stop();
     merge(std::move(temp_writers), components);
 }
@@ -1204,6 +1406,15 @@ void run_calling(GenomeCallingComponents& components)
     } else {
         run_octopus_single_threaded(components);
     }
+    static auto debug_log = get_debug_log();
+    if (debug_log) {
+        for (const auto& p : io::read_buffer_high_water_marks()) {
+            stream(*debug_log) << "Read buffer high-water mark for thread " << p.first << " was "
+                               << MemoryFootprint {p.second};
+        }
+    }
+    // Calling is done so there will be no more fetches to reuse the buffers
+    io::release_cached_read_buffers();
 }
 
 void destroy(VcfWriter& writer)
@@ -1221,7 +1432,7 @@ void log_filtering_info(const GenomeCallingComponents& components)
 std::vector<GenomicRegion> extract_call_regions(VcfReader& vcf)
 {
     std::deque<GenomicRegion> regions {};
-    auto p = vcf.iterate(VcfReader::UnpackPolicy::sites);
+    auto p = vcf.iterate(VcfReader::UnpackFields {});
     std::transform(std::move(p.first), std::move(p.second), std::back_inserter(regions),
                    [] (const VcfRecord& record) { return mapped_region(record); });
     return {std::make_move_iterator(std::begin(regions)), std::make_move_iterator(std::end(regions))};
@@ -1257,6 +1468,120 @@ bool use_unfiltered_call_region_hints_for_filtering(const GenomeCallingComponent
     return true;
 }
 
+unsigned calculate_num_filter_threads(const GenomeCallingComponents& components)
+{
+    if (components.num_threads()) {
+        return *components.num_threads();
+    }
+    const auto num_cores = std::thread::hardware_concurrency();
+    return num_cores > 0 ? num_cores : 8;
+}
+
+// Records on contigs missing from the header would be silently dropped by per-contig filtering
+bool has_all_indexed_contigs(const VcfReader& in, const std::vector<GenomicRegion::ContigName>& header_contigs)
+{
+    const auto indexed_contigs = in.fetch_indexed_contigs();
+    if (!indexed_contigs) return false;
+    return std::all_of(std::cbegin(*indexed_contigs), std::cend(*indexed_contigs), [&] (const auto& contig) {
+        return std::find(std::cbegin(header_contigs), std::cend(header_contigs), contig) != std::cend(header_contigs);
+    });
+}
+
+bool can_filter_contigs_in_parallel(const GenomeCallingComponents& components, const VariantCallFilter& filter,
+                                    const VcfReader& in, const std::vector<GenomicRegion::ContigName>& contigs)
+{
+    return filter.is_contig_separable() && components.temp_directory() && contigs.size() > 1
+           && calculate_num_filter_threads(components) > 1 && has_all_indexed_contigs(in, contigs);
+}
+
+void remove_temp_files(const std::vector<boost::filesystem::path>& paths) noexcept
+{
+    for (const auto& path : paths) {
+        boost::system::error_code ec {};
+        boost::filesystem::remove(path, ec);
+    }
+}
+
+boost::filesystem::path make_temp_filter_output_path(const GenomicRegion::ContigName& contig,
+                                                     const GenomeCallingComponents& components)
+{
+    auto result = *components.temp_directory();
+    result /= contig + "_filtered_temp" + get_temp_output_extension(*components.filtered_output());
+    return result;
+}
+
+// Each worker owns a reader, read buffer and filter, and filters whole contigs into temporary files
+// that are concatenated in contig order, so the output is the same as filtering serially.
+void filter_contigs_in_parallel(const boost::filesystem::path& input_path,
+                                const std::vector<GenomicRegion::ContigName>& contigs,
+                                const BufferedReadPipe::Config& buffer_config,
+                                const std::vector<GenomicRegion>& hints,
+                                const VariantCallFilter::OutputOptions& output_config,
+                                ProgressMeter& progress,
+                                GenomeCallingComponents& components)
+{
+    static auto debug_log = get_debug_log();
+    const auto num_workers = std::min(calculate_num_filter_threads(components), static_cast<unsigned>(contigs.size()));
+    if (debug_log) stream(*debug_log) << "Filtering " << contigs.size() << " contigs with " << num_workers << " threads";
+    std::vector<boost::filesystem::path> temp_paths {};
+    temp_paths.reserve(contigs.size());
+    for (const auto& contig : contigs) {
+        temp_paths.push_back(make_temp_filter_output_path(contig, components));
+    }
+    // The workers share the read buffer budget
+    auto worker_buffer_config = buffer_config;
+    worker_buffer_config.max_buffer_size /= num_workers;
+    std::atomic<std::size_t> next_contig_idx {0};
+    const auto filter_contigs = [&] () {
+        try {
+            const VcfReader in {input_path};
+            BufferedReadPipe buffered_rp {components.filter_read_pipe(), worker_buffer_config, hints};
+            const auto filter = components.call_filter_factory().make(components.reference(), std::move(buffered_rp),
+                                                                      in.fetch_header(), output_config);
+            assert(filter);
+            for (auto idx = next_contig_idx++; idx < contigs.size(); idx = next_contig_idx++) {
+                VcfWriter temp_out {temp_paths[idx], components.compression_pool()};
+                filter->filter(in, contigs[idx], temp_out);
+                temp_out.close();
+                if (components.search_regions().count(contigs[idx]) == 1) {
+                    progress.log_completed(contigs[idx]);
+                }
+            }
+        } catch (...) {
+            next_contig_idx = contigs.size(); // stop the other workers taking more contigs
+            throw;
+        }
+    };
+    std::vector<std::future<void>> workers {};
+    workers.reserve(num_workers);
+    progress.start();
+    for (unsigned i {0}; i < num_workers; ++i) {
+        workers.push_back(std::async(std::launch::async, filter_contigs));
+    }
+    // Every worker must finish before the temp files can be removed
+    std::exception_ptr worker_error {};
+    for (auto& worker : workers) {
+        try {
+            worker.get();
+        } catch (...) {
+            if (!worker_error) worker_error = std::current_exception();
+        }
+    }
+    progress.stop();
+    if (worker_error) {
+        remove_temp_files(temp_paths);
+        std::rethrow_exception(worker_error);
+    }
+    VcfWriter& out {*components.filtered_output()};
+    try {
+        concatenate(temp_paths, out);
+    } catch (...) {
+        remove_temp_files(temp_paths);
+        throw;
+    }
+    remove_temp_files(temp_paths);
+}
+
 void run_csr(GenomeCallingComponents& components)
 {
     if (apply_csr(components)) {
@@ -1274,22 +1599,33 @@ void run_csr(GenomeCallingComponents& components)
         BufferedReadPipe::Config buffer_config {components.read_buffer_size()};
         buffer_config.fetch_expansion = 100;
         buffer_config.max_hint_gap = 5'000;
-        BufferedReadPipe buffered_rp {filter_read_pipe, buffer_config};
+        if (!components.num_threads() || *components.num_threads() > 1) {
+            buffer_config.max_prefetches = 1;
+        }
+        std::vector<GenomicRegion> hints {};
         if (use_unfiltered_call_region_hints_for_filtering(components)) {
-            buffered_rp.hint(extract_call_regions(*input_path));
+            hints = extract_call_regions(*input_path);
         } else {
-            buffered_rp.hint(flatten(components.search_regions()));
+            hints = flatten(components.search_regions());
         }
         VariantCallFilter::OutputOptions output_config {};
         if (components.sites_only()) {
             output_config.emit_sites_only = true;
         }
-        const VcfReader in {std::move(*input_path)};
-        const auto filter = filter_factory.make(components.reference(), std::move(buffered_rp), in.fetch_header(),
+        const VcfReader in {*input_path};
+        const auto input_header = in.fetch_header();
+        BufferedReadPipe buffered_rp {filter_read_pipe, buffer_config, hints};
+        const auto filter = filter_factory.make(components.reference(), std::move(buffered_rp), input_header,
                                                 output_config, progress, components.num_threads());
         assert(filter);
         VcfWriter& out {*components.filtered_output()};
-        filter->filter(in, out);
+        const auto contigs = get_contigs(input_header);
+        if (can_filter_contigs_in_parallel(components, *filter, in, contigs)) {
+            out << filter->make_header(in);
+            filter_contigs_in_parallel(*input_path, contigs, buffer_config, hints, output_config, progress, components);
+        } else {
+            filter->filter(in, out);
+        }
         out.close();
     }
 }
@@ -11,7 +11,6 @@
 #include "basics/genomic_region.hpp"
 #include "utils/maths.hpp"
 #include "utils/kmer_mapper.hpp"
-#include "utils/append.hpp"
 #include "core/models/error/error_model_factory.hpp"
 
 namespace octopus {
@@ -284,7 +283,7 @@ CigarString pad_reference(const GenomicRegion& read_region, const CigarString& r
                     result.insert(result.cend(), haplotype_to_reference.cbegin(), haplotype_to_reference.cend() - 1);
                     result.emplace_back(haplotype_to_reference.back().size() + rhs_pad_size, Flag::sequenceMatch);
                 } else {
-                    utils::append(haplotype_to_reference, result);
+                    result.insert(result.cend(), haplotype_to_reference.cbegin(), haplotype_to_reference.cend());
                     if (rhs_pad_size > 0) result.emplace_back(rhs_pad_size, Flag::sequenceMatch);
                 }
             }
@@ -297,7 +296,7 @@ CigarString pad_reference(const GenomicRegion& read_region, const CigarString& r
             } else {
                 assert(lhs_pad_size > 0);
                 result.emplace_back(lhs_pad_size, Flag::sequenceMatch);
-                utils::append(haplotype_to_reference, result);
+                result.insert(result.cend(), haplotype_to_reference.cbegin(), haplotype_to_reference.cend());
             }
         } else {
             assert(begins_before(haplotype_region, read_region) && ends_before(haplotype_region, read_region));
@@ -6,9 +6,11 @@
 #include <iterator>
 #include <algorithm>
 #include <numeric>
+#include <limits>
 
 #include <boost/iterator/zip_iterator.hpp>
 #include <boost/tuple/tuple.hpp>
+#include <boost/functional/hash.hpp>
 
 #include "config/common.hpp"
 #include "basics/aligned_read.hpp"
@@ -31,16 +33,31 @@ std::unique_ptr<VariantGenerator> CigarScanner::do_clone() const
 CigarScanner::CigarScanner(const ReferenceGenome& reference, Options options)
 : reference_ {reference}
 , options_ {options}
+, contig_ {}
 , buffer_ {}
+, snv_buffer_ {}
 , candidates_ {}
 , likely_misaligned_candidates_ {}
+, snv_sites_ {}
+, likely_misaligned_snv_sites_ {}
 , max_seen_candidate_size_ {}
 , read_coverage_tracker_ {}
 , misaligned_tracker_ {}
+, alleles_ {}
+, allele_indices_ {}
 {
     buffer_.reserve(100);
+    snv_buffer_.reserve(100);
+    base_allele_indices_.fill(std::numeric_limits<AlleleIndex>::max());
 }
 
+CigarScanner::Candidate::Candidate(ContigRegion region, AlleleIndex ref, AlleleIndex alt, Observation observation)
+: region {region}
+, ref {ref}
+, alt {alt}
+, observation {observation}
+{}
+
 bool CigarScanner::do_requires_reads() const noexcept
 {
     return true;
@@ -48,13 +65,21 @@ bool CigarScanner::do_requires_reads() const noexcept
 
 namespace {
 
-template <typename Sequence, typename P, typename S>
-Sequence copy(const Sequence& sequence, const P pos, const S size)
+constexpr unsigned no_base_index {4};
+
+unsigned base_index(const char base) noexcept
 {
-    const auto it = std::next(std::cbegin(sequence), pos);
-    return Sequence {it, std::next(it, size)};
+    switch (base) {
+        case 'A': return 0;
+        case 'C': return 1;
+        case 'G': return 2;
+        case 'T': return 3;
+        default: return no_base_index;
+    }
 }
 
+constexpr std::array<char, 4> indexed_bases {'A', 'C', 'G', 'T'};
+
 double ln_probability_read_correctly_aligned(const double misalign_penalty, const AlignedRead& read,
                                              const double max_expected_mutation_rate)
 {
@@ -82,13 +107,16 @@ void CigarScanner::add_read(const SampleName& sample, const AlignedRead& read,
 {
     using std::cbegin; using std::next; using std::move;
     using Flag = CigarOperation::Flag;
+    static const NucleotideSequence empty_sequence {};
     const auto& read_contig   = contig_name(read);
     const auto& read_sequence = read.sequence();
+    if (contig_.empty()) contig_ = read_contig;
     auto ref_index = mapped_begin(read);
     std::size_t read_index {0};
     GenomicRegion region;
     double misalignment_penalty {0};
     buffer_.clear();
+    snv_buffer_.clear();
     for (const auto& cigar_operation : read.cigar()) {
         const auto op_size = cigar_operation.size();
         switch (cigar_operation.flag()) {
@@ -105,10 +133,16 @@ void CigarScanner::add_read(const SampleName& sample, const AlignedRead& read,
             case Flag::substitution:
             {
                 region = GenomicRegion {read_contig, ref_index, ref_index + op_size};
-                add_candidate(region,
-                              reference_.get().fetch_sequence(region),
-                              copy(read_sequence, read_index, op_size),
-                              read, read_index, sample);
+                const auto ref_sequence = reference_.get().fetch_sequence(region);
+                if (op_size == 1) {
+                    add_snv(ref_index, ref_sequence.front(), read_sequence[read_index], read, read_index, sample);
+                } else {
+                    const auto first_base_itr = next(cbegin(read_sequence), read_index);
+                    add_candidate(region.contig_region(),
+                                  intern(ref_sequence),
+                                  intern(first_base_itr, next(first_base_itr, op_size)),
+                                  read, read_index, sample);
+                }
                 read_index += op_size;
                 ref_index  += op_size;
                 misalignment_penalty += op_size * options_.misalignment_parameters.snv_penalty;
@@ -116,9 +150,10 @@ void CigarScanner::add_read(const SampleName& sample, const AlignedRead& read,
             }
             case Flag::insertion:
             {
-                add_candidate(GenomicRegion {read_contig, ref_index, ref_index},
-                              "",
-                              copy(read_sequence, read_index, op_size),
+                const auto first_base_itr = next(cbegin(read_sequence), read_index);
+                add_candidate(ContigRegion {ref_index, ref_index},
+                              intern(empty_sequence),
+                              intern(first_base_itr, next(first_base_itr, op_size)),
                               read, read_index, sample);
                 read_index += op_size;
                 misalignment_penalty += options_.misalignment_parameters.indel_penalty;
@@ -127,9 +162,10 @@ void CigarScanner::add_read(const SampleName& sample, const AlignedRead& read,
             case Flag::deletion:
             {
                 region = GenomicRegion {read_contig, ref_index, ref_index + op_size};
-                add_candidate(move(region),
-                              reference_.get().fetch_sequence(region),
-                              "",
+                const auto ref_allele = intern(reference_.get().fetch_sequence(region));
+                add_candidate(region.contig_region(),
+                              ref_allele,
+                              intern(empty_sequence),
                               read, read_index, sample);
                 ref_index += op_size;
                 misalignment_penalty += options_.misalignment_parameters.indel_penalty;
@@ -167,10 +203,19 @@ void CigarScanner::add_read(const SampleName& sample, const AlignedRead& read,
         read_coverage_tracker_.add(read);
         sample_coverage_tracker.add(read);
     }
+    const auto add_to = [this] (SnvSiteMap& sites) {
+        for (const auto& snv : snv_buffer_) {
+            auto& site = sites[snv.position];
+            site.ref_base = snv.ref_base;
+            site.observations[snv.base_index].push_back(snv.observation);
+        }
+    };
     if (!is_likely_misaligned(read, misalignment_penalty)) {
         utils::append(std::move(buffer_), candidates_);
+        add_to(snv_sites_);
     } else {
         utils::append(std::move(buffer_), likely_misaligned_candidates_);
+        add_to(likely_misaligned_snv_sites_);
         misaligned_tracker_.add(clipped_mapped_region(read));
     }
 }
@@ -244,8 +289,9 @@ void choose_push_back(Variant candidate, std::vector<Variant>& final_candidates,
 
 std::vector<Variant> CigarScanner::do_generate(const RegionSet& regions) const
 {
-    std::sort(std::begin(candidates_), std::end(candidates_));
-    std::sort(std::begin(likely_misaligned_candidates_), std::end(likely_misaligned_candidates_));
+    const auto candidate_less = [this] (const Candidate& lhs, const Candidate& rhs) noexcept { return is_less(lhs, rhs); };
+    std::sort(std::begin(candidates_), std::end(candidates_), candidate_less);
+    std::sort(std::begin(likely_misaligned_candidates_), std::end(likely_misaligned_candidates_), candidate_less);
     std::vector<Variant> result {};
     for (const auto& region : regions) {
         generate(region, result);
@@ -255,15 +301,24 @@ std::vector<Variant> CigarScanner::do_generate(const RegionSet& regions) const
 
 void CigarScanner::do_clear() noexcept
 {
+    contig_.clear();
     buffer_.clear();
     buffer_.shrink_to_fit();
+    snv_buffer_.clear();
+    snv_buffer_.shrink_to_fit();
     candidates_.clear();
     candidates_.shrink_to_fit();
     likely_misaligned_candidates_.clear();
     likely_misaligned_candidates_.shrink_to_fit();
+    snv_sites_.clear();
+    likely_misaligned_snv_sites_.clear();
     read_coverage_tracker_.clear();
     misaligned_tracker_.clear();
     max_seen_candidate_size_ = 0;
+    alleles_.clear();
+    alleles_.shrink_to_fit();
+    allele_indices_.clear();
+    base_allele_indices_.fill(std::numeric_limits<AlleleIndex>::max());
 }
 
 std::string CigarScanner::name() const
@@ -273,6 +328,64 @@ std::string CigarScanner::name() const
 
 // private methods
 
+CigarScanner::AlleleIndex CigarScanner::intern(const SequenceIterator first, const SequenceIterator last)
+{
+    const auto hash = boost::hash_range(first, last);
+    const auto matches = allele_indices_.equal_range(hash);
+    const auto match_itr = std::find_if(matches.first, matches.second, [&] (const auto& p) {
+        const auto& allele = alleles_[p.second];
+        return static_cast<std::size_t>(std::distance(first, last)) == allele.size()
+               && std::equal(first, last, std::cbegin(allele));
+    });
+    if (match_itr != matches.second) return match_itr->second;
+    const auto result = static_cast<AlleleIndex>(alleles_.size());
+    alleles_.emplace_back(first, last);
+    allele_indices_.emplace(hash, result);
+    return result;
+}
+
+CigarScanner::AlleleIndex CigarScanner::intern(const NucleotideSequence& allele)
+{
+    return intern(std::cbegin(allele), std::cend(allele));
+}
+
+CigarScanner::AlleleIndex CigarScanner::intern(const char base)
+{
+    auto& result = base_allele_indices_[static_cast<unsigned char>(base)];
+    if (result == std::numeric_limits<AlleleIndex>::max()) {
+        const NucleotideSequence allele(1, base);
+        result = intern(allele);
+    }
+    return result;
+}
+
+void CigarScanner::add_candidate(const ContigRegion region, const AlleleIndex ref, const AlleleIndex alt,
+                                 const AlignedRead& read, const std::size_t offset, const SampleName& sample)
+{
+    const auto candidate_size = size(region);
+    if (candidate_size <= options_.max_variant_size) {
+        const auto first_base_qual_itr = std::next(std::cbegin(read.base_qualities()), offset);
+        const auto last_base_qual_itr = std::next(first_base_qual_itr, alleles_[alt].size());
+        const auto base_quality_sum = std::accumulate(first_base_qual_itr, last_base_qual_itr, 0u);
+        buffer_.emplace_back(region, ref, alt, Observation {sample, base_quality_sum, read.mapping_quality(),
+                                                            read.direction() == AlignedRead::Direction::forward});
+        max_seen_candidate_size_ = std::max(max_seen_candidate_size_, candidate_size);
+    }
+}
+
+void CigarScanner::add_snv(const ContigRegion::Position position, const char ref_base, const char read_base,
+                           const AlignedRead& read, const std::size_t offset, const SampleName& sample)
+{
+    const auto read_base_index = base_index(read_base);
+    if (base_index(ref_base) != no_base_index && read_base_index != no_base_index) {
+        snv_buffer_.push_back({position, ref_base, read_base_index,
+                               Observation {sample, read.base_qualities()[offset], read.mapping_quality(),
+                                            read.direction() == AlignedRead::Direction::forward}});
+    } else {
+        add_candidate(ContigRegion {position, position + 1}, intern(ref_base), intern(read_base), read, offset, sample);
+    }
+}
+
 double CigarScanner::add_snvs_in_match_range(const GenomicRegion& region, const AlignedRead& read,
                                              std::size_t read_index, const SampleName& origin)
 {
@@ -281,9 +394,8 @@ double CigarScanner::add_snvs_in_match_range(const GenomicRegion& region, const
     for (std::size_t ref_index {0}; ref_index < ref_segment.size(); ++ref_index, ++read_index) {
         const char ref_base {ref_segment[ref_index]}, read_base {read.sequence()[read_index]};
         if (ref_base != read_base && ref_base != 'N' && read_base != 'N') {
-            const auto begin_pos = region.begin() + static_cast<GenomicRegion::Position>(ref_index);
-            add_candidate(GenomicRegion {region.contig_name(), begin_pos, begin_pos + 1},
-                          ref_base, read_base, read, read_index, origin);
+            const auto position = region.begin() + static_cast<GenomicRegion::Position>(ref_index);
+            add_snv(position, ref_base, read_base, read, read_index, origin);
             if (read.base_qualities()[read_index] >= options_.misalignment_parameters.snv_threshold) {
                 misalignment_penalty += options_.misalignment_parameters.snv_penalty;
             }
@@ -292,39 +404,102 @@ double CigarScanner::add_snvs_in_match_range(const GenomicRegion& region, const
     return misalignment_penalty;
 }
 
+bool CigarScanner::is_less(const Candidate& lhs, const Candidate& rhs) const noexcept
+{
+    if (lhs.region != rhs.region) return lhs.region < rhs.region;
+    if (lhs.ref != rhs.ref) return alleles_[lhs.ref] < alleles_[rhs.ref];
+    return lhs.alt != rhs.alt && alleles_[lhs.alt] < alleles_[rhs.alt];
+}
+
+bool CigarScanner::is_same(const Candidate& lhs, const Candidate& rhs) const noexcept
+{
+    return lhs.ref == rhs.ref && lhs.alt == rhs.alt && lhs.region == rhs.region;
+}
+
+Variant CigarScanner::make_variant(const Candidate& candidate) const
+{
+    return Variant {GenomicRegion {contig_, candidate.region}, alleles_[candidate.ref], alleles_[candidate.alt]};
+}
+
+Variant CigarScanner::make_variant(const ContigRegion::Position position, const char ref_base,
+                                   const unsigned base_index) const
+{
+    return Variant {contig_, position, NucleotideSequence(1, ref_base), NucleotideSequence(1, indexed_bases[base_index])};
+}
+
+namespace {
+
+template <typename Iterator, typename ObservationVector>
+struct UniqueCandidate
+{
+    Variant variant;
+    Iterator first, last;
+    const ObservationVector* snv_observations;
+};
+
+template <typename SnvSiteMap, typename UnaryFunction>
+void for_each_overlapped_site(const SnvSiteMap& sites, const ContigRegion& region, UnaryFunction f)
+{
+    for (auto itr = sites.lower_bound(region.begin() > 0 ? region.begin() - 1 : 0);
+         itr != std::cend(sites) && itr->first <= region.end(); ++itr) {
+        if (overlaps(ContigRegion {itr->first, itr->first + 1}, region)) f(itr->first, itr->second);
+    }
+}
+
+} // namespace
+
 void CigarScanner::generate(const GenomicRegion& region, std::vector<Variant>& result) const
 {
     using std::begin; using std::end; using std::cbegin; using std::cend; using std::next;
-    assert(std::is_sorted(std::cbegin(candidates_), std::cend(candidates_)));
-    auto viable_candidates = overlap_range(candidates_, region, max_seen_candidate_size_);
-    if (empty(viable_candidates)) return;
-    result.reserve(result.size() + size(viable_candidates, BidirectionallySortedTag {})); // maximum possible
-    const auto last_viable_candidate_itr = cend(viable_candidates);
-    while (!viable_candidates.empty()) {
-        const Candidate& candidate {viable_candidates.front()};
-        const auto next_candidate_itr = std::find_if_not(next(cbegin(viable_candidates)), last_viable_candidate_itr,
-                                                         [this, &candidate] (const Candidate& c) {
-                                                             return options_.match(c.variant, candidate.variant);
+    if (region.contig_name() != contig_) return;
+    const auto& contig_region = region.contig_region();
+    // Only materialise one Variant per distinct allele, rather than one per observation
+    using UniqueVariant = UniqueCandidate<CandidateIterator, std::vector<Observation>>;
+    std::vector<UniqueVariant> unique_candidates {};
+    auto viable_candidates = overlap_range(candidates_, contig_region, max_seen_candidate_size_);
+    for (auto candidate_itr = cbegin(viable_candidates); candidate_itr != cend(viable_candidates);) {
+        const auto next_candidate_itr = std::find_if_not(next(candidate_itr), cend(viable_candidates),
+                                                         [this, candidate_itr] (const Candidate& c) {
+                                                             return is_same(c, *candidate_itr);
                                                          });
-        const auto num_matches = std::distance(cbegin(viable_candidates), next_candidate_itr);
-        const auto observation = make_observation(cbegin(viable_candidates), next_candidate_itr);
-        if (options_.include(observation)) {
-            if (num_matches > 1) {
-                auto unique_itr = cbegin(viable_candidates);
-                while (unique_itr != next_candidate_itr) {
-                    result.push_back(unique_itr->variant);
-                    unique_itr = std::find_if_not(next(unique_itr), next_candidate_itr,
-                                                  [unique_itr] (const Candidate& c) {
-                                                      return c.variant == unique_itr->variant;
-                                                  });
-                }
+        unique_candidates.push_back({make_variant(*candidate_itr), candidate_itr, next_candidate_itr, nullptr});
+        candidate_itr = next_candidate_itr;
+    }
+    const auto num_non_snv_candidates = unique_candidates.size();
+    for_each_overlapped_site(snv_sites_, contig_region, [&] (const auto position, const SnvSite& site) {
+        for (unsigned i {0}; i < site.observations.size(); ++i) {
+            if (!site.observations[i].empty()) {
+                unique_candidates.push_back({make_variant(position, site.ref_base, i), cend(viable_candidates),
+                                             cend(viable_candidates), &site.observations[i]});
+            }
+        }
+    });
+    if (unique_candidates.empty()) return;
+    std::inplace_merge(begin(unique_candidates), next(begin(unique_candidates), num_non_snv_candidates), end(unique_candidates),
+                       [] (const auto& lhs, const auto& rhs) { return lhs.variant < rhs.variant; });
+    result.reserve(result.size() + unique_candidates.size()); // maximum possible
+    std::vector<std::reference_wrapper<const Observation>> observations {};
+    for (auto unique_itr = begin(unique_candidates); unique_itr != end(unique_candidates);) {
+        const auto& candidate = unique_itr->variant;
+        const auto next_unique_itr = std::find_if_not(next(unique_itr), end(unique_candidates),
+                                                      [this, &candidate] (const auto& c) {
+                                                          return options_.match(c.variant, candidate);
+                                                      });
+        observations.clear();
+        std::for_each(unique_itr, next_unique_itr, [&] (const UniqueVariant& c) {
+            if (c.snv_observations) {
+                observations.insert(end(observations), cbegin(*c.snv_observations), cend(*c.snv_observations));
             } else {
-                result.push_back(candidate.variant);
+                std::for_each(c.first, c.last, [&] (const Candidate& o) { observations.emplace_back(o.observation); });
             }
+        });
+        const auto observation = make_observation(candidate, observations);
+        if (options_.include(observation)) {
+            std::for_each(unique_itr, next_unique_itr, [&] (auto& c) { result.push_back(std::move(c.variant)); });
         }
-        viable_candidates.advance_begin(num_matches);
+        unique_itr = next_unique_itr;
     }
-    if (debug_log_ && !likely_misaligned_candidates_.empty()) {
+    if (debug_log_ && !(likely_misaligned_candidates_.empty() && likely_misaligned_snv_sites_.empty())) {
         const auto novel_unique_misaligned_variants = get_novel_likely_misaligned_candidates(result);
         if (!novel_unique_misaligned_variants.empty()) {
             stream(*debug_log_) << "DynamicCigarScanner: ignoring "
@@ -334,13 +509,6 @@ void CigarScanner::generate(const GenomicRegion& region, std::vector<Variant>& r
     }
 }
 
-unsigned CigarScanner::sum_base_qualities(const Candidate& candidate) const noexcept
-{
-    const auto first_base_qual_itr = std::next(std::cbegin(candidate.source.get().base_qualities()), candidate.offset);
-    const auto last_base_qual_itr = std::next(first_base_qual_itr, alt_sequence_size(candidate.variant));
-    return std::accumulate(first_base_qual_itr, last_base_qual_itr, 0u);
-}
-
 bool CigarScanner::is_likely_misaligned(const AlignedRead& read, const double penalty) const
 {
     auto mu = options_.misalignment_parameters.max_expected_mutation_rate;
@@ -350,37 +518,33 @@ bool CigarScanner::is_likely_misaligned(const AlignedRead& read, const double pe
 }
 
 CigarScanner::ObservedVariant
-CigarScanner::make_observation(const CandidateIterator first_match, const CandidateIterator last_match) const
+CigarScanner::make_observation(const Variant& variant,
+                               const std::vector<std::reference_wrapper<const Observation>>& observations) const
 {
-    assert(first_match != last_match);
-    const Candidate& candidate {*first_match};
+    assert(!observations.empty());
     ObservedVariant result {};
-    result.variant = candidate.variant;
-    result.total_depth = get_min_depth(candidate.variant, read_coverage_tracker_);
-    std::vector<Candidate> observations {first_match, last_match};
-    std::sort(begin(observations), end(observations),
-              [] (const Candidate& lhs, const Candidate& rhs) { return lhs.origin.get() < rhs.origin.get(); });
-    for (auto observation_itr = begin(observations); observation_itr != end(observations);) {
-        const auto& origin = observation_itr->origin;
-        auto next_itr = std::find_if_not(next(observation_itr), end(observations),
-                                         [&] (const Candidate& c) { return c.origin.get() == origin.get(); });
+    result.variant = variant;
+    result.total_depth = get_min_depth(variant, read_coverage_tracker_);
+    auto sample_observations = observations;
+    std::sort(begin(sample_observations), end(sample_observations),
+              [] (const Observation& lhs, const Observation& rhs) { return lhs.origin.get() < rhs.origin.get(); });
+    for (auto observation_itr = begin(sample_observations); observation_itr != end(sample_observations);) {
+        const auto& origin = observation_itr->get().origin;
+        auto next_itr = std::find_if_not(next(observation_itr), end(sample_observations),
+                                         [&] (const Observation& o) { return o.origin.get() == origin.get(); });
         const auto num_observations = static_cast<std::size_t>(std::distance(observation_itr, next_itr));
         std::vector<unsigned> observed_base_qualities(num_observations);
         std::transform(observation_itr, next_itr, begin(observed_base_qualities),
-                       [this] (const Candidate& c) noexcept { return sum_base_qualities(c); });
+                       [] (const Observation& o) noexcept { return o.base_quality_sum; });
         std::vector<AlignedRead::MappingQuality> observed_mapping_qualities(num_observations);
         std::transform(observation_itr, next_itr, begin(observed_mapping_qualities),
-                       [] (const Candidate& c) noexcept { return c.source.get().mapping_quality(); });
-        const auto num_fwd_support = std::accumulate(observation_itr, next_itr, 0u,
-                                                     [] (unsigned curr, const Candidate& c) noexcept {
-                                                         if (c.source.get().direction() == AlignedRead::Direction::forward) {
-                                                             ++curr;
-                                                         }
-                                                         return curr;
-                                                     });
-        const auto depth = get_min_depth(candidate.variant, sample_read_coverage_tracker_.at(origin));
+                       [] (const Observation& o) noexcept { return o.mapping_quality; });
+        const auto num_fwd_support = std::count_if(observation_itr, next_itr,
+                                                   [] (const Observation& o) noexcept { return o.is_forward_strand; });
+        const auto depth = get_min_depth(variant, sample_read_coverage_tracker_.at(origin));
         result.sample_observations.push_back({origin, depth, std::move(observed_base_qualities),
-                                              std::move(observed_mapping_qualities), num_fwd_support});
+                                              std::move(observed_mapping_qualities),
+                                              static_cast<unsigned>(num_fwd_support)});
         observation_itr = next_itr;
     }
     return result;
@@ -389,16 +553,20 @@ CigarScanner::make_observation(const CandidateIterator first_match, const Candid
 std::vector<Variant>
 CigarScanner::get_novel_likely_misaligned_candidates(const std::vector<Variant>& current_candidates) const
 {
-    std::is_sorted(std::cbegin(likely_misaligned_candidates_), std::cend(likely_misaligned_candidates_));
-    std::vector<Candidate> unique_misaligned_candidates {};
-    unique_misaligned_candidates.reserve(likely_misaligned_candidates_.size());
-    std::unique_copy(std::cbegin(likely_misaligned_candidates_), std::cend(likely_misaligned_candidates_),
-                     std::back_inserter(unique_misaligned_candidates));
     std::vector<Variant> unique_misaligned_variants {};
-    unique_misaligned_variants.reserve(unique_misaligned_candidates.size());
-    std::transform(std::cbegin(unique_misaligned_candidates), std::cend(unique_misaligned_candidates),
-                   std::back_inserter(unique_misaligned_variants),
-                   [] (const Candidate& candidate) { return candidate.variant; });
+    for (auto itr = std::cbegin(likely_misaligned_candidates_); itr != std::cend(likely_misaligned_candidates_);) {
+        unique_misaligned_variants.push_back(make_variant(*itr));
+        itr = std::find_if_not(std::next(itr), std::cend(likely_misaligned_candidates_),
+                               [this, itr] (const Candidate& c) { return is_same(c, *itr); });
+    }
+    for (const auto& p : likely_misaligned_snv_sites_) {
+        for (unsigned i {0}; i < p.second.observations.size(); ++i) {
+            if (!p.second.observations[i].empty()) {
+                unique_misaligned_variants.push_back(make_variant(p.first, p.second.ref_base, i));
+            }
+        }
+    }
+    std::sort(std::begin(unique_misaligned_variants), std::end(unique_misaligned_variants));
     std::vector<Variant> result {};
     result.reserve(unique_misaligned_variants.size());
     assert(std::is_sorted(std::cbegin(current_candidates), std::cend(current_candidates)));
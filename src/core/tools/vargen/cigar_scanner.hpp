@@ -6,7 +6,11 @@
 
 #include <vector>
 #include <deque>
+#include <map>
+#include <array>
+#include <unordered_map>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <functional>
 #include <memory>
@@ -14,7 +18,8 @@
 #include <boost/optional.hpp>
 
 #include "concepts/mappable.hpp"
-#include "concepts/comparable.hpp"
+#include "basics/contig_region.hpp"
+#include "basics/genomic_region.hpp"
 #include "basics/aligned_read.hpp"
 #include "core/types/variant.hpp"
 #include "utils/coverage_tracker.hpp"
@@ -23,7 +28,6 @@
 namespace octopus {
 
 class ReferenceGenome;
-class GenomicRegion;
 
 namespace coretools {
 
@@ -91,74 +95,85 @@ private:
     void do_clear() noexcept override;
     std::string name() const override;
     
-    struct Candidate : public Comparable<Candidate>, public Mappable<Candidate>
+    using NucleotideSequence = AlignedRead::NucleotideSequence;
+    using SequenceIterator   = NucleotideSequence::const_iterator;
+    using AlleleIndex        = std::uint32_t;
+    
+    // The read summary kept for each allele observation. Base qualities are kept per observation, rather
+    // than as counts, as the inclusion predicates need individual qualities (e.g. medians).
+    struct Observation
     {
-        Variant variant;
-        std::reference_wrapper<const AlignedRead> source;
         std::reference_wrapper<const SampleName> origin;
-        std::size_t offset;
-        
-        template <typename T1, typename T2, typename T3>
-        Candidate(T1&& region, T2&& sequence_removed, T3&& sequence_added,
-                  const AlignedRead& source, std::size_t offset,
-                  const SampleName& origin);
+        unsigned base_quality_sum;
+        AlignedRead::MappingQuality mapping_quality;
+        bool is_forward_strand;
+    };
+    
+    // Indel, MNV and non-ACGT SNV observations. Allele sequences are interned, and as a scanner only sees one contig
+    // between clears, the contig name is stored once in the scanner rather than in each candidate.
+    struct Candidate : public Mappable<Candidate>
+    {
+        ContigRegion region;
+        AlleleIndex ref, alt;
+        Observation observation;
         
-        const GenomicRegion& mapped_region() const noexcept { return variant.mapped_region(); }
+        Candidate(ContigRegion region, AlleleIndex ref, AlleleIndex alt, Observation observation);
         
-        friend bool operator==(const Candidate& lhs, const Candidate& rhs) noexcept { return lhs.variant == rhs.variant; }
-        friend bool operator<(const Candidate& lhs, const Candidate& rhs) noexcept { return lhs.variant < rhs.variant; }
+        const ContigRegion& mapped_region() const noexcept { return region; }
     };
     
-    using NucleotideSequence = AlignedRead::NucleotideSequence;
-    using SequenceIterator   = NucleotideSequence::const_iterator;
+    // SNV observations are collated by position, with one slot per alt base (A, C, G, T)
+    struct SnvSite
+    {
+        char ref_base;
+        std::array<std::vector<Observation>, 4> observations;
+    };
+    using SnvSiteMap = std::map<ContigRegion::Position, SnvSite>;
+    
+    struct SnvObservation
+    {
+        ContigRegion::Position position;
+        char ref_base;
+        unsigned base_index;
+        Observation observation;
+    };
     
     std::reference_wrapper<const ReferenceGenome> reference_;
     Options options_;
+    GenomicRegion::ContigName contig_;
     std::vector<Candidate> buffer_;
+    std::vector<SnvObservation> snv_buffer_;
     mutable std::deque<Candidate> candidates_, likely_misaligned_candidates_;
+    SnvSiteMap snv_sites_, likely_misaligned_snv_sites_;
     Variant::MappingDomain::Size max_seen_candidate_size_;
     CoverageTracker<GenomicRegion> read_coverage_tracker_, misaligned_tracker_;
     std::unordered_map<SampleName, CoverageTracker<GenomicRegion>> sample_read_coverage_tracker_;
+    std::vector<NucleotideSequence> alleles_;
+    std::unordered_multimap<std::size_t, AlleleIndex> allele_indices_;
+    std::array<AlleleIndex, 256> base_allele_indices_;
     
     using CandidateIterator = OverlapIterator<decltype(candidates_)::const_iterator>;
     
-    template <typename T1, typename T2, typename T3>
-    void add_candidate(T1&& region, T2&& sequence_removed, T3&& sequence_added,
+    AlleleIndex intern(SequenceIterator first, SequenceIterator last);
+    AlleleIndex intern(const NucleotideSequence& allele);
+    AlleleIndex intern(char base);
+    void add_candidate(ContigRegion region, AlleleIndex ref, AlleleIndex alt,
                        const AlignedRead& read, std::size_t offset, const SampleName& sample);
+    void add_snv(ContigRegion::Position position, char ref_base, char read_base,
+                 const AlignedRead& read, std::size_t offset, const SampleName& sample);
     double add_snvs_in_match_range(const GenomicRegion& region, const AlignedRead& read,
                                    std::size_t read_index, const SampleName& origin);
+    bool is_less(const Candidate& lhs, const Candidate& rhs) const noexcept;
+    bool is_same(const Candidate& lhs, const Candidate& rhs) const noexcept;
+    Variant make_variant(const Candidate& candidate) const;
+    Variant make_variant(ContigRegion::Position position, char ref_base, unsigned base_index) const;
     void generate(const GenomicRegion& region, std::vector<Variant>& result) const;
-    unsigned sum_base_qualities(const Candidate& candidate) const noexcept;
     bool is_likely_misaligned(const AlignedRead& read, double penalty) const;
-    ObservedVariant make_observation(CandidateIterator first_match, CandidateIterator last_match) const;
+    ObservedVariant make_observation(const Variant& variant,
+                                     const std::vector<std::reference_wrapper<const Observation>>& observations) const;
     std::vector<Variant> get_novel_likely_misaligned_candidates(const std::vector<Variant>& current_candidates) const;
 };
 
-template <typename T1, typename T2, typename T3>
-CigarScanner::Candidate::Candidate(T1&& region, T2&& sequence_removed, T3&& sequence_added,
-                                   const AlignedRead& source, std::size_t offset,
-                                   const SampleName& origin)
-: variant {std::forward<T1>(region), std::forward<T2>(sequence_removed), std::forward<T3>(sequence_added)}
-, source {source}
-, origin {origin}
-, offset {offset}
-{}
-
-template <typename T1, typename T2, typename T3>
-void CigarScanner::add_candidate(T1&& region, T2&& sequence_removed, T3&& sequence_added,
-                                 const AlignedRead& read, const std::size_t offset,
-                                 const SampleName& sample)
-{
-    const auto candidate_size = size(region);
-    if (candidate_size <= options_.max_variant_size) {
-        buffer_.emplace_back(std::forward<T1>(region),
-                             std::forward<T2>(sequence_removed),
-                             std::forward<T3>(sequence_added),
-                             read, offset, sample);
-        max_seen_candidate_size_ = std::max(max_seen_candidate_size_, candidate_size);
-    }
-}
-
 struct DefaultInclusionPredicate
 {
     bool operator()(const CigarScanner::ObservedVariant& candidate);
@@ -62,6 +62,7 @@ LocalReassembler::LocalReassembler(const ReferenceGenome& reference, Options opt
 , max_bubbles_ {options.max_bubbles}
 , min_bubble_score_ {options.min_bubble_score}
 , max_variant_size_ {options.max_variant_size}
+, cache_ {std::move(options.cache)}
 {
     if (max_bin_size_ == 0) {
         throw std::runtime_error {"bin size must be greater than zero"};
@@ -85,6 +86,8 @@ std::unique_ptr<VariantGenerator> LocalReassembler::do_clone() const
 
 LocalReassembler::Bin::Bin(GenomicRegion region)
 : region {std::move(region)}
+, read_sequences_hash {}
+, cache_reads {}
 {}
 
 const GenomicRegion& LocalReassembler::Bin::mapped_region() const noexcept
@@ -100,6 +103,7 @@ void LocalReassembler::Bin::add(const AlignedRead& read)
         read_region = contig_region(read);
     }
     read_sequences.emplace_back(read.sequence());
+    read_sequences_hash.add(read.sequence());
 }
 
 void LocalReassembler::Bin::add(const GenomicRegion& read_region, const NucleotideSequence& read_sequence)
@@ -110,12 +114,15 @@ void LocalReassembler::Bin::add(const GenomicRegion& read_region, const Nucleoti
         this->read_region = contig_region(read_region);
     }
     read_sequences.emplace_back(read_sequence);
+    read_sequences_hash.add(read_sequence);
 }
 
 void LocalReassembler::Bin::clear() noexcept
 {
     read_sequences.clear();
     read_sequences.shrink_to_fit();
+    read_sequences_hash = {};
+    cache_reads.reset();
 }
 
 bool LocalReassembler::Bin::empty() const noexcept
@@ -368,6 +375,7 @@ std::vector<Variant> LocalReassembler::do_generate(const RegionSet& regions) con
             first_bin = next_bin;
         }
     }
+    if (trace_log_) log_cache_stats();
     remove_duplicates(candidates);
     remove_larger_than(candidates, max_variant_size_);
     return {std::make_move_iterator(std::begin(candidates)), std::make_move_iterator(std::end(candidates))};
@@ -541,6 +549,25 @@ LocalReassembler::assemble_bin(const unsigned kmer_size, const Bin& bin, std::de
     if (bin.empty()) return AssemblerStatus::success;
     const auto assemble_region = propose_assembler_region(bin.region, kmer_size);
     if (size(assemble_region) < kmer_size) return AssemblerStatus::failed;
+    if (!cache_) return assemble_bin_helper(kmer_size, bin, assemble_region, result);
+    auto cached = cache_->find(assemble_region, kmer_size, bin.read_sequences_hash, bin.read_sequences);
+    if (!cached) {
+        std::deque<Variant> variants {};
+        const auto status = assemble_bin_helper(kmer_size, bin, assemble_region, variants);
+        cached = AssemblyCache::Result {status, {std::cbegin(variants), std::cend(variants)}};
+        if (!bin.cache_reads) bin.cache_reads = make_read_set(bin.read_sequences, bin.read_sequences_hash);
+        cache_->insert(assemble_region, kmer_size, bin.cache_reads, *cached);
+        utils::append(std::move(variants), result);
+    } else {
+        utils::append(std::move(cached->variants), result);
+    }
+    return cached->status;
+}
+
+LocalReassembler::AssemblerStatus
+LocalReassembler::assemble_bin_helper(const unsigned kmer_size, const Bin& bin, const GenomicRegion& assemble_region,
+                                      std::deque<Variant>& result) const
+{
     const auto reference_sequence = reference_.get().fetch_sequence(assemble_region);
     if (!utils::is_canonical_dna(reference_sequence)) return AssemblerStatus::failed;
     Assembler assembler {kmer_size, reference_sequence};
@@ -999,5 +1026,17 @@ LocalReassembler::try_assemble_region(Assembler& assembler, const NucleotideSequ
     return status;
 }
 
+void LocalReassembler::log_cache_stats() const
+{
+    if (cache_ && trace_log_) {
+        const auto stats = cache_->stats();
+        const auto num_lookups = stats.hits + stats.misses;
+        const auto hit_rate = num_lookups > 0 ? static_cast<double>(stats.hits) / num_lookups : 0.0;
+        stream(*trace_log_) << "Assembly cache: " << stats.hits << " hits, " << stats.misses << " misses ("
+                            << 100 * hit_rate << "% hit rate), " << stats.size << " entries, "
+                            << stats.footprint << " bytes, " << stats.evictions << " evictions";
+    }
+}
+
 } // namespace coretools
 } // namespace octopus
@@ -21,6 +21,7 @@
 #include "core/types/variant.hpp"
 #include "variant_generator.hpp"
 #include "utils/assembler.hpp"
+#include "utils/assembly_cache.hpp"
 
 namespace octopus {
 
@@ -44,6 +45,7 @@ public:
         unsigned max_bubbles                          = 10;
         double min_bubble_score                       = 2.0;
         Variant::MappingDomain::Size max_variant_size = 5000;
+        std::shared_ptr<AssemblyCache> cache          = nullptr;
     };
     
     LocalReassembler() = delete;
@@ -96,11 +98,13 @@ private:
         GenomicRegion region;
         boost::optional<ContigRegion> read_region;
         std::deque<std::reference_wrapper<const NucleotideSequence>> read_sequences;
+        AssemblyCache::ReadSetHash read_sequences_hash;
+        mutable AssemblyCache::ReadSetPtr cache_reads; // only made when the bin is first cached
     };
     
     using BinList = std::deque<Bin>;
     
-    enum class AssemblerStatus { success, partial_success, failed };
+    using AssemblerStatus = AssemblyCache::Status;
     
     ExecutionPolicy execution_policy_;
     std::reference_wrapper<const ReferenceGenome> reference_;
@@ -112,6 +116,7 @@ private:
     unsigned max_bubbles_;
     double min_bubble_score_;
     Variant::MappingDomain::Size max_variant_size_;
+    std::shared_ptr<AssemblyCache> cache_;
     
     void prepare_bins(const GenomicRegion& active_region, BinList& bins) const;
     bool should_assemble_bin(const Bin& bin) const;
@@ -120,6 +125,9 @@ private:
     void try_assemble_with_fallbacks(const Bin& bin, std::deque<Variant>& result) const;
     GenomicRegion propose_assembler_region(const GenomicRegion& input_region, unsigned kmer_size) const;
     AssemblerStatus assemble_bin(unsigned kmer_size, const Bin& bin, std::deque<Variant>& result) const;
+    AssemblerStatus assemble_bin_helper(unsigned kmer_size, const Bin& bin, const GenomicRegion& assemble_region,
+                                        std::deque<Variant>& result) const;
+    void log_cache_stats() const;
     AssemblerStatus try_assemble_region(Assembler& assembler, const NucleotideSequence& reference_sequence,
                                         const GenomicRegion& reference_region, std::deque<Variant>& result) const;
 };
@@ -0,0 +1,185 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "assembly_cache.hpp"
+
+#include <numeric>
+#include <utility>
+#include <cstdint>
+#include <cassert>
+
+namespace octopus { namespace coretools {
+
+namespace {
+
+std::size_t estimate_footprint(const Variant& variant) noexcept
+{
+    return sizeof(Variant) + contig_name(variant).size() + ref_sequence_size(variant) + alt_sequence_size(variant);
+}
+
+std::size_t estimate_footprint(const AssemblyCache::Result& result) noexcept
+{
+    return std::accumulate(std::cbegin(result.variants), std::cend(result.variants), sizeof(AssemblyCache::Result),
+                           [] (auto curr, const auto& variant) { return curr + estimate_footprint(variant); });
+}
+
+} // namespace
+
+// AssemblyCache::ReadSetHash
+
+namespace {
+
+// The per-sequence hashes are summed, which does not depend on order, so mix them first to spread their bits
+std::uint64_t mix(std::uint64_t x) noexcept
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+} // namespace
+
+void AssemblyCache::ReadSetHash::add(const NucleotideSequence& sequence) noexcept
+{
+    value_ += static_cast<std::size_t>(mix(boost::hash_range(std::cbegin(sequence), std::cend(sequence))));
+    ++size_;
+}
+
+std::size_t AssemblyCache::ReadSetHash::size() const noexcept
+{
+    return size_;
+}
+
+std::size_t AssemblyCache::ReadSetHash::value() const noexcept
+{
+    return value_;
+}
+
+bool operator==(const AssemblyCache::ReadSetHash& lhs, const AssemblyCache::ReadSetHash& rhs) noexcept
+{
+    return lhs.size() == rhs.size() && lhs.value() == rhs.value();
+}
+
+// AssemblyCache::ReadSet
+
+std::size_t AssemblyCache::ReadSet::size() const noexcept
+{
+    return sequences_.size();
+}
+
+const AssemblyCache::ReadSetHash& AssemblyCache::ReadSet::hash() const noexcept
+{
+    return hash_;
+}
+
+std::size_t AssemblyCache::ReadSet::footprint() const noexcept
+{
+    return std::accumulate(std::cbegin(sequences_), std::cend(sequences_), sizeof(ReadSet),
+                           [] (auto curr, const auto& sequence) { return curr + sizeof(sequence) + sequence.size(); });
+}
+
+bool operator==(const AssemblyCache::ReadSet& lhs, const AssemblyCache::ReadSet& rhs) noexcept
+{
+    return &lhs == &rhs || (lhs.hash() == rhs.hash() && lhs.sequences_ == rhs.sequences_);
+}
+
+// AssemblyCache
+
+AssemblyCache::AssemblyCache(const std::size_t max_footprint)
+: max_footprint_ {max_footprint}
+, cache_ {}
+, recently_used_ {}
+, footprint_ {0}
+, hits_ {0}
+, misses_ {0}
+, evictions_ {0}
+{}
+
+boost::optional<AssemblyCache::Result>
+AssemblyCache::find(const GenomicRegion& region, const unsigned kmer_size, const ReadSet& reads) const
+{
+    return find(region, kmer_size, reads.hash(), reads.sequences_);
+}
+
+void AssemblyCache::insert(const GenomicRegion& region, const unsigned kmer_size, ReadSetPtr reads, Result result)
+{
+    assert(reads);
+    // The reads may be shared by entries for other kmer sizes, but are charged to each so the budget is not exceeded
+    const auto footprint = estimate_footprint(result) + reads->footprint();
+    if (footprint > max_footprint_) return;
+    std::lock_guard<std::mutex> lock {mutex_};
+    Key key {region, kmer_size, reads->hash()};
+    const auto matches = cache_.equal_range(key);
+    if (std::any_of(matches.first, matches.second, [&] (const auto& p) { return *p.second.reads == *reads; })) {
+        return; // another thread got here first
+    }
+    evict_until(max_footprint_ - footprint);
+    recently_used_.emplace_back(key, reads);
+    cache_.emplace(std::move(key), Entry {std::move(reads), std::move(result), footprint,
+                                          std::prev(std::end(recently_used_))});
+    footprint_ += footprint;
+}
+
+AssemblyCache::Stats AssemblyCache::stats() const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    return {hits_, misses_, evictions_, cache_.size(), footprint_};
+}
+
+void AssemblyCache::clear() noexcept
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    cache_.clear();
+    recently_used_.clear();
+    footprint_ = 0;
+}
+
+// private methods
+
+bool operator==(const AssemblyCache::Key& lhs, const AssemblyCache::Key& rhs) noexcept
+{
+    return lhs.kmer_size == rhs.kmer_size && lhs.reads == rhs.reads && lhs.region == rhs.region;
+}
+
+std::size_t AssemblyCache::KeyHash::operator()(const Key& key) const noexcept
+{
+    using boost::hash_combine;
+    std::size_t result {};
+    hash_combine(result, std::hash<GenomicRegion>()(key.region));
+    hash_combine(result, key.kmer_size);
+    hash_combine(result, key.reads.value());
+    return result;
+}
+
+boost::optional<AssemblyCache::Result> AssemblyCache::record_lookup(const EntryMap::iterator match) const
+{
+    if (match != std::end(cache_)) {
+        recently_used_.splice(std::end(recently_used_), recently_used_, match->second.usage);
+        ++hits_;
+        return match->second.result;
+    } else {
+        ++misses_;
+        return boost::none;
+    }
+}
+
+void AssemblyCache::evict_until(const std::size_t target_footprint)
+{
+    while (footprint_ > target_footprint && !recently_used_.empty()) {
+        const auto& lru = recently_used_.front();
+        const auto matches = cache_.equal_range(lru.first);
+        const auto itr = std::find_if(matches.first, matches.second,
+                                      [&] (const auto& p) { return p.second.reads == lru.second; });
+        assert(itr != matches.second);
+        footprint_ -= itr->second.footprint;
+        cache_.erase(itr);
+        recently_used_.pop_front();
+        ++evictions_;
+    }
+}
+
+} // namespace coretools
+} // namespace octopus
@@ -0,0 +1,231 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef assembly_cache_hpp
+#define assembly_cache_hpp
+
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <unordered_map>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+#include <boost/optional.hpp>
+#include <boost/functional/hash.hpp>
+
+#include "basics/genomic_region.hpp"
+#include "core/types/variant.hpp"
+
+namespace octopus { namespace coretools {
+
+/*
+ AssemblyCache stores the variants discovered by local assembly so that identical assembly
+ problems do not need to be solved twice. This happens when assembly bins overlap, or when the
+ same region is called more than once (e.g. regenotyping).
+
+ A problem is identified by the reference window, the kmer size, and the multiset of read sequences
+ inserted into the graph. Lookups are keyed by an order-independent hash of the reads, which is built
+ without copying or sorting them. The sorted read sequences are stored with each entry, and a lookup
+ only compares the reads against them when the hash matches, so a hit is confirmed against the reads
+ rather than trusting a hash. Entries are evicted in least-recently-used order once the estimated memory
+ footprint of the cached variants and reads exceeds the given budget.
+
+ The cache is thread-safe and intended to be shared between LocalReassembler instances.
+ */
+
+class AssemblyCache
+{
+public:
+    using NucleotideSequence = Variant::NucleotideSequence;
+    
+    // Hash of a multiset of read sequences that does not depend on read order, so reads can be added one by one
+    class ReadSetHash
+    {
+    public:
+        ReadSetHash() = default;
+        
+        template <typename SequenceRange>
+        explicit ReadSetHash(const SequenceRange& sequences);
+        
+        void add(const NucleotideSequence& sequence) noexcept;
+        
+        std::size_t size() const noexcept;
+        std::size_t value() const noexcept;
+        
+    private:
+        std::size_t size_ = 0, value_ = 0;
+    };
+    
+    // The multiset of read sequences of a cached assembly problem, sorted so that read order does not matter
+    class ReadSet
+    {
+    public:
+        ReadSet() = delete;
+        
+        template <typename SequenceRange>
+        ReadSet(const SequenceRange& sequences, ReadSetHash hash);
+        
+        template <typename SequenceRange>
+        explicit ReadSet(const SequenceRange& sequences);
+        
+        std::size_t size() const noexcept;
+        const ReadSetHash& hash() const noexcept;
+        std::size_t footprint() const noexcept;
+        
+        // True if sequences, in any order, are the same multiset as this
+        template <typename SequenceRange>
+        bool is_same(const SequenceRange& sequences) const;
+        
+        friend bool operator==(const ReadSet& lhs, const ReadSet& rhs) noexcept;
+        
+    private:
+        std::vector<NucleotideSequence> sequences_;
+        ReadSetHash hash_;
+        
+        friend AssemblyCache;
+    };
+    
+    using ReadSetPtr = std::shared_ptr<const ReadSet>;
+
+    enum class Status { success, partial_success, failed };
+
+    struct Result
+    {
+        Status status;
+        std::vector<Variant> variants;
+    };
+
+    struct Stats
+    {
+        std::size_t hits, misses, evictions, size, footprint;
+    };
+
+    AssemblyCache() = delete;
+
+    AssemblyCache(std::size_t max_footprint);
+
+    AssemblyCache(const AssemblyCache&)            = delete;
+    AssemblyCache& operator=(const AssemblyCache&) = delete;
+    AssemblyCache(AssemblyCache&&)                 = delete;
+    AssemblyCache& operator=(AssemblyCache&&)      = delete;
+
+    ~AssemblyCache() = default;
+
+    template <typename SequenceRange>
+    boost::optional<Result> find(const GenomicRegion& region, unsigned kmer_size,
+                                 const ReadSetHash& hash, const SequenceRange& sequences) const;
+    boost::optional<Result> find(const GenomicRegion& region, unsigned kmer_size, const ReadSet& reads) const;
+    void insert(const GenomicRegion& region, unsigned kmer_size, ReadSetPtr reads, Result result);
+
+    Stats stats() const;
+    void clear() noexcept;
+
+private:
+    struct Key
+    {
+        GenomicRegion region;
+        unsigned kmer_size;
+        ReadSetHash reads;
+    };
+
+    friend bool operator==(const Key& lhs, const Key& rhs) noexcept;
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const noexcept;
+    };
+
+    struct Entry;
+    using EntryMap = std::unordered_multimap<Key, Entry, KeyHash>;
+    using UsageList = std::list<std::pair<Key, ReadSetPtr>>;
+
+    struct Entry
+    {
+        ReadSetPtr reads;
+        Result result;
+        std::size_t footprint;
+        UsageList::iterator usage;
+    };
+
+    std::size_t max_footprint_;
+    mutable EntryMap cache_;
+    mutable UsageList recently_used_;
+    std::size_t footprint_;
+    mutable std::size_t hits_, misses_;
+    std::size_t evictions_;
+    mutable std::mutex mutex_;
+
+    boost::optional<Result> record_lookup(EntryMap::iterator match) const;
+    void evict_until(std::size_t target_footprint);
+};
+
+bool operator==(const AssemblyCache::ReadSetHash& lhs, const AssemblyCache::ReadSetHash& rhs) noexcept;
+bool operator==(const AssemblyCache::ReadSet& lhs, const AssemblyCache::ReadSet& rhs) noexcept;
+
+template <typename SequenceRange>
+AssemblyCache::ReadSetHash::ReadSetHash(const SequenceRange& sequences)
+{
+    for (const NucleotideSequence& sequence : sequences) add(sequence);
+}
+
+template <typename SequenceRange>
+AssemblyCache::ReadSet::ReadSet(const SequenceRange& sequences, ReadSetHash hash)
+: sequences_ {std::cbegin(sequences), std::cend(sequences)}
+, hash_ {hash}
+{
+    std::sort(std::begin(sequences_), std::end(sequences_));
+}
+
+template <typename SequenceRange>
+AssemblyCache::ReadSet::ReadSet(const SequenceRange& sequences)
+: ReadSet {sequences, ReadSetHash {sequences}}
+{}
+
+template <typename SequenceRange>
+bool AssemblyCache::ReadSet::is_same(const SequenceRange& sequences) const
+{
+    if (static_cast<std::size_t>(std::distance(std::cbegin(sequences), std::cend(sequences))) != sequences_.size()) {
+        return false;
+    }
+    // Sort references rather than copies of the sequences
+    std::vector<std::reference_wrapper<const NucleotideSequence>> sorted_sequences {};
+    sorted_sequences.reserve(sequences_.size());
+    for (const NucleotideSequence& sequence : sequences) sorted_sequences.emplace_back(sequence);
+    std::sort(std::begin(sorted_sequences), std::end(sorted_sequences),
+              [] (const NucleotideSequence& lhs, const NucleotideSequence& rhs) { return lhs < rhs; });
+    return std::equal(std::cbegin(sorted_sequences), std::cend(sorted_sequences), std::cbegin(sequences_),
+                      [] (const NucleotideSequence& lhs, const NucleotideSequence& rhs) { return lhs == rhs; });
+}
+
+template <typename SequenceRange>
+boost::optional<AssemblyCache::Result>
+AssemblyCache::find(const GenomicRegion& region, const unsigned kmer_size,
+                    const ReadSetHash& hash, const SequenceRange& sequences) const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    const auto matches = cache_.equal_range(Key {region, kmer_size, hash});
+    const auto match = std::find_if(matches.first, matches.second,
+                                    [&] (const auto& p) { return p.second.reads->is_same(sequences); });
+    return record_lookup(match != matches.second ? match : std::end(cache_));
+}
+
+template <typename SequenceRange>
+AssemblyCache::ReadSetPtr make_read_set(const SequenceRange& sequences)
+{
+    return std::make_shared<const AssemblyCache::ReadSet>(sequences);
+}
+
+template <typename SequenceRange>
+AssemblyCache::ReadSetPtr make_read_set(const SequenceRange& sequences, AssemblyCache::ReadSetHash hash)
+{
+    return std::make_shared<const AssemblyCache::ReadSet>(sequences, hash);
+}
+
+} // namespace coretools
+} // namespace octopus
+
+#endif
@@ -104,7 +104,7 @@ std::string VcfExtractor::name() const
 std::vector<Variant> VcfExtractor::fetch_variants(const GenomicRegion& region) const
 {
   std::deque<Variant> variants {};
-    for (auto p = reader_->iterate(region, VcfReader::UnpackPolicy::sites); p.first != p.second; ++p.first) {
+    for (auto p = reader_->iterate(region, VcfReader::UnpackFields {}); p.first != p.second; ++p.first) {
         if (is_good(*p.first)) {
             extract_variants(*p.first, variants);
         }
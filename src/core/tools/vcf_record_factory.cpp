@@ -598,7 +598,7 @@ void set_allele_counts(const Call& call, const std::vector<SampleName>& samples,
     } else {
         // It's safe to put ac before ad as there can only be one canonical alt allele, which is always listed
         // before the deleted allele.
-        result.set_info("AC", {std::to_string(std::get<0>(t)), std::to_string(std::get<1>(t))});
+        result.set_info("AC", std::vector<unsigned> {std::get<0>(t), std::get<1>(t)});
     }
     
     result.set_info("AN", std::get<2>(t));
@@ -626,7 +626,7 @@ VcfRecord VcfRecordFactory::make(std::unique_ptr<Call> call) const
     const auto call_reads = copy_overlapped(reads_, region);
     result.set_info("NS",  count_samples_with_coverage(call_reads));
     result.set_info("DP",  sum_max_coverages(call_reads));
-    result.set_info("SB",  utils::to_string(strand_bias(call_reads), 2));
+    result.set_info("SB",  strand_bias(call_reads), 2);
     result.set_info("BQ",  static_cast<unsigned>(rmq_base_quality(call_reads)));
     result.set_info("MQ",  static_cast<unsigned>(rmq_mapping_quality(call_reads)));
     result.set_info("MQ0", count_mapq_zero(call_reads));
@@ -646,7 +646,7 @@ VcfRecord VcfRecordFactory::make(std::unique_ptr<Call> call) const
             const auto& genotype_call = call->get_genotype_call(sample);
             auto gq = std::min(999, static_cast<int>(std::round(genotype_call.posterior.score())));
             set_vcf_genotype(sample, genotype_call, result, has_non_ref);
-            result.set_format(sample, "GQ", std::to_string(gq));
+            result.set_format(sample, "GQ", gq);
             result.set_format(sample, "DP", max_coverage(call_reads.at(sample)));
             result.set_format(sample, "BQ", static_cast<unsigned>(rmq_base_quality(call_reads.at(sample))));
             result.set_format(sample, "MQ", static_cast<unsigned>(rmq_mapping_quality(call_reads.at(sample))));
@@ -654,7 +654,7 @@ VcfRecord VcfRecordFactory::make(std::unique_ptr<Call> call) const
                 const auto& phase = *genotype_call.phase;
                 auto pq = std::min(99, static_cast<int>(std::round(phase.score().score())));
                 result.set_format(sample, "PS", mapped_begin(phase.region()) + 1);
-                result.set_format(sample, "PQ", std::to_string(pq));
+                result.set_format(sample, "PQ", pq);
             }
         }
     }
@@ -704,7 +704,7 @@ void set_allele_counts(const std::vector<VcfRecord::NucleotideSequence>& alt_all
                        VcfRecord::Builder& result)
 {
     auto p = get_allele_counts(alt_alleles, genotypes);
-    result.set_info("AC", utils::to_strings(p.first));
+    result.set_info("AC", p.first);
     result.set_info("AN", p.second);
 }
 
@@ -776,7 +776,7 @@ VcfRecord VcfRecordFactory::make_segment(std::vector<std::unique_ptr<Call>>&& ca
     result.set_qual(std::min(max_qual, maths::round(q->get()->quality().score(), 2)));
     result.set_info("NS",  count_samples_with_coverage(reads_, region));
     result.set_info("DP",  sum_max_coverages(reads_, region));
-    result.set_info("SB",  utils::to_string(strand_bias(reads_, region), 2));
+    result.set_info("SB",  strand_bias(reads_, region), 2);
     result.set_info("BQ",  static_cast<unsigned>(rmq_base_quality(reads_, region)));
     result.set_info("MQ",  static_cast<unsigned>(rmq_mapping_quality(reads_, region)));
     result.set_info("MQ0", count_mapq_zero(reads_, region));
@@ -802,7 +802,7 @@ VcfRecord VcfRecordFactory::make_segment(std::vector<std::unique_ptr<Call>>&& ca
                              std::string {vcfspec::missingValue}, std::string {"<NON_REF>"});
             }
             result.set_genotype(sample, genotype_call, VcfRecord::Builder::Phasing::phased);
-            result.set_format(sample, "GQ", std::to_string(gq));
+            result.set_format(sample, "GQ", gq);
             result.set_format(sample, "DP", max_coverage(reads_.at(sample), region));
             result.set_format(sample, "BQ", static_cast<unsigned>(rmq_base_quality(reads_.at(sample), region)));
             result.set_format(sample, "MQ", static_cast<unsigned>(rmq_mapping_quality(reads_.at(sample), region)));
@@ -810,7 +810,7 @@ VcfRecord VcfRecordFactory::make_segment(std::vector<std::unique_ptr<Call>>&& ca
                 const auto phase = *calls.front()->get_genotype_call(sample).phase;
                 auto pq = std::min(99, static_cast<int>(std::round(phase.score().score())));
                 result.set_format(sample, "PS", mapped_begin(phase.region()) + 1);
-                result.set_format(sample, "PQ", std::to_string(pq));
+                result.set_format(sample, "PQ", pq);
             }
         }
     }
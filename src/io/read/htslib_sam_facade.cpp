@@ -7,6 +7,7 @@
 #include <cmath>
 #include <algorithm>
 #include <iterator>
+#include <numeric>
 #include <stdexcept>
 #include <sstream>
 #include <cassert>
@@ -21,6 +22,10 @@
 #include "exceptions/missing_index_error.hpp"
 #include "exceptions/malformed_file_error.hpp"
 #include "exceptions/unwritable_file_error.hpp"
+#include "streaming_downsampler.hpp"
+#include "read_buffer_pool.hpp"
+#include "config/common.hpp"
+#include "logging/logging.hpp"
 
 namespace octopus { namespace io {
 
@@ -155,10 +160,13 @@ private:
 
 namespace {
 
-auto open_hts_file(const boost::filesystem::path& file)
+auto open_hts_file(const boost::filesystem::path& file, const HtslibThreadPool* decompression_pool = nullptr)
 {
     hts_verbose = 0; // disable hts error reporting
-    return sam_open(file.c_str(), "r");
+    auto result = sam_open(file.c_str(), "r");
+    // Attach before the header is read so all decoding, including the header block, uses the pool
+    if (result && decompression_pool) decompression_pool->attach(result);
+    return result;
 }
 
 bool is_cram(const boost::filesystem::path& file)
@@ -169,14 +177,21 @@ bool is_cram(const boost::filesystem::path& file)
 } // namespace
 
 HtslibSamFacade::HtslibSamFacade(Path file_path)
+: HtslibSamFacade {std::move(file_path), std::shared_ptr<const HtslibThreadPool> {}}
+{}
+
+HtslibSamFacade::HtslibSamFacade(Path file_path, std::shared_ptr<const HtslibThreadPool> decompression_pool)
 : file_path_ {std::move(file_path)}
-, hts_file_ {open_hts_file(file_path_), HtsFileDeleter {}}
+, decompression_pool_ {std::move(decompression_pool)}
+, hts_file_ {open_hts_file(file_path_, decompression_pool_.get()), HtsFileDeleter {}}
 , hts_header_ {(hts_file_) ? sam_hdr_read(hts_file_.get()) : nullptr, HtsHeaderDeleter {}}
 , hts_index_ {(hts_file_) ? sam_index_load(hts_file_.get(), file_path_.c_str()) : nullptr, HtsIndexDeleter {}}
 , hts_targets_ {}
 , contig_names_ {}
 , sample_names_ {}
+, read_groups_ {}
 , samples_ {}
+, contig_compressed_bytes_ {}
 {
     namespace fs = boost::filesystem;
     if (!hts_file_) {
@@ -258,7 +273,7 @@ bool HtslibSamFacade::is_open() const noexcept
 
 void HtslibSamFacade::open()
 {
-    hts_file_.reset(sam_open(file_path_.string().c_str(), "r"));
+    hts_file_.reset(open_hts_file(file_path_, decompression_pool_.get()));
     if (hts_file_) {
         hts_header_.reset(sam_hdr_read(hts_file_.get()));
         hts_index_.reset(sam_index_load(hts_file_.get(), file_path_.c_str()));
@@ -497,7 +512,7 @@ HtslibSamFacade::SampleReadMap HtslibSamFacade::fetch_reads(const GenomicRegion&
     HtslibIterator it {*this, region};
     for (const auto& sample : samples_) {
         auto p = result.emplace(std::piecewise_construct, std::forward_as_tuple(sample), std::forward_as_tuple());
-        p.first->second.reserve(defaultReserve_);
+        p.first->second = acquire_read_buffer(defaultReserve_);
     }
     while (++it) {
         try {
@@ -517,8 +532,7 @@ HtslibSamFacade::ReadContainer HtslibSamFacade::fetch_reads(const SampleName& sa
     if (!contains(samples_, sample)) return {};
     if (samples_.size() == 1) return fetch_all_reads(region);
     HtslibIterator it {*this, region};
-    ReadContainer result {};
-    result.reserve(defaultReserve_);
+    auto result = acquire_read_buffer(defaultReserve_);
     while (++it) {
         if (sample_names_.at(it.read_group()) == sample) {
             try {
@@ -547,7 +561,7 @@ HtslibSamFacade::SampleReadMap HtslibSamFacade::fetch_reads(const std::vector<Sa
             auto p = result.emplace(std::piecewise_construct,
                                     std::forward_as_tuple(sample),
                                     std::forward_as_tuple());
-            p.first->second.reserve(defaultReserve_);
+            p.first->second = acquire_read_buffer(defaultReserve_);
         }
     }
     if (result.empty()) return result; // no matching samples
@@ -566,6 +580,76 @@ HtslibSamFacade::SampleReadMap HtslibSamFacade::fetch_reads(const std::vector<Sa
     return result;
 }
 
+HtslibSamFacade::SampleReadMap HtslibSamFacade::fetch_reads(const std::vector<SampleName>& samples,
+                                                            const GenomicRegion& region,
+                                                            const ReadPrefilter& prefilter,
+                                                            SampleFilterCountMap& filter_counts) const
+{
+    if (prefilter.empty()) return fetch_reads(samples, region);
+    SampleReadMap result {samples.size()};
+    std::unordered_map<SampleName, std::vector<std::size_t>> rejection_counts {samples.size()};
+    std::unordered_map<SampleName, StreamingDownsampler> downsamplers {};
+    std::unordered_map<SampleName, std::size_t> invalid_record_counts {};
+    const auto& coverage_limit = prefilter.coverage_limit();
+    for (const auto& sample : samples) {
+        if (contains(samples_, sample)) {
+            auto p = result.emplace(std::piecewise_construct,
+                                    std::forward_as_tuple(sample),
+                                    std::forward_as_tuple());
+            p.first->second = acquire_read_buffer(defaultReserve_);
+            rejection_counts.emplace(sample, std::vector<std::size_t>(prefilter.size(), 0));
+            if (coverage_limit) {
+                downsamplers.emplace(sample, StreamingDownsampler {coverage_limit->trigger_coverage,
+                                                                   coverage_limit->target_coverage});
+            }
+        }
+    }
+    if (result.empty()) return result; // no matching samples
+    HtslibIterator it {*this, region};
+    while (++it) {
+        const auto& sample = sample_names_.at(it.read_group());
+        const auto sample_itr = result.find(sample);
+        if (sample_itr != std::end(result)) {
+            const auto failed_clause = std::find_if_not(std::cbegin(prefilter), std::cend(prefilter),
+                                                        [&it] (const auto& clause) { return it.passes(clause); });
+            if (failed_clause != std::cend(prefilter)) {
+                ++rejection_counts.at(sample)[std::distance(std::cbegin(prefilter), failed_clause)];
+                continue;
+            }
+            auto& reads = sample_itr->second;
+            try {
+                if (coverage_limit) {
+                    const auto index = downsamplers.at(sample).add(it.begin(), it.end(), reads.size());
+                    if (!index) continue;
+                    if (*index < reads.size()) {
+                        reads[*index] = *it;
+                        continue;
+                    }
+                }
+                reads.emplace_back(*it);
+            } catch (const InvalidBamRecord&) {
+                ++invalid_record_counts[sample];
+            }
+        }
+    }
+    for (const auto& p : rejection_counts) {
+        auto& sample_filter_counts = filter_counts[p.first];
+        for (std::size_t i {0}; i < prefilter.size(); ++i) {
+            sample_filter_counts[prefilter[i].name] += p.second[i];
+        }
+    }
+    if (!invalid_record_counts.empty()) {
+        static auto debug_log = logging::get_debug_log();
+        if (debug_log) {
+            for (const auto& p : invalid_record_counts) {
+                stream(*debug_log) << "Dropped " << p.second << " invalid records for sample " << p.first
+                                   << " in " << region << " from " << file_path_;
+            }
+        }
+    }
+    return result;
+}
+
 std::vector<GenomicRegion::ContigName> HtslibSamFacade::reference_contigs() const
 {
     std::vector<GenomicRegion::ContigName> result {};
@@ -591,6 +675,85 @@ boost::optional<std::vector<GenomicRegion::ContigName>> HtslibSamFacade::mapped_
     return result;
 }
 
+namespace {
+
+// Typical ratio of uncompressed to compressed bytes in a BAM BGZF block
+constexpr std::uint64_t nominalBgzfCompressionRatio {3};
+
+// Estimates the compressed size of the data between two BGZF virtual offsets. The high 48 bits of a virtual
+// offset are the compressed offset of the BGZF block and the low 16 bits the offset into the uncompressed block,
+// so data within a single block is measured by its uncompressed span instead.
+std::uint64_t estimate_compressed_bytes(const std::uint64_t begin, const std::uint64_t end) noexcept
+{
+    const auto begin_block = begin >> 16, end_block = end >> 16;
+    if (begin_block < end_block) return end_block - begin_block;
+    const auto uncompressed_bytes = (end & 0xFFFF) - std::min(begin & 0xFFFF, end & 0xFFFF);
+    return std::max(uncompressed_bytes / nominalBgzfCompressionRatio, std::uint64_t {1});
+}
+
+} // namespace
+
+boost::optional<std::vector<std::size_t>>
+HtslibSamFacade::estimate_read_counts(const GenomicRegion& region, const GenomicRegion::Size window_size) const
+{
+    // CRAM indices have no bin chunks or mapped read stats
+    if (!is_open() || hts_file_->is_cram || window_size == 0) return boost::none;
+    if (hts_targets_.count(region.contig_name()) == 0) {
+        return std::vector<std::size_t>((size(region) + window_size - 1) / window_size, 0);
+    }
+    const auto target = get_htslib_target(region.contig_name());
+    std::uint64_t num_mapped {}, num_unmapped {};
+    if (hts_idx_get_stat(hts_index_.get(), target, &num_mapped, &num_unmapped) < 0) return boost::none;
+    std::vector<std::size_t> result((size(region) + window_size - 1) / window_size, 0);
+    if (num_mapped == 0) return result;
+    // Scale the compressed size of the chunks overlapping each window by the contig's mean reads per byte
+    const auto contig_bytes = count_compressed_bytes(target);
+    if (contig_bytes == 0) return boost::none;
+    const auto reads_per_byte = static_cast<double>(num_mapped) / contig_bytes;
+    std::vector<std::vector<IndexChunk>> window_chunks(result.size());
+    for (std::size_t i {0}; i < result.size(); ++i) {
+        const auto window_begin = region.begin() + static_cast<GenomicRegion::Position>(i * window_size);
+        const auto window_end = std::min(window_begin + window_size, region.end());
+        window_chunks[i] = get_index_chunks(target, window_begin, window_end);
+    }
+    // Chunks from coarse bins are returned for every window the bin spans, so split the offsets between
+    // the boundaries of all chunks into segments and share each segment's bytes between the windows using it
+    std::vector<std::uint64_t> boundaries {};
+    for (const auto& chunks : window_chunks) {
+        for (const auto& chunk : chunks) {
+            boundaries.push_back(chunk.first);
+            boundaries.push_back(chunk.second);
+        }
+    }
+    std::sort(std::begin(boundaries), std::end(boundaries));
+    boundaries.erase(std::unique(std::begin(boundaries), std::end(boundaries)), std::end(boundaries));
+    const auto boundary_index = [&] (const std::uint64_t offset) {
+        return std::distance(std::cbegin(boundaries), std::lower_bound(std::cbegin(boundaries), std::cend(boundaries), offset));
+    };
+    std::vector<int> segment_depths(boundaries.size(), 0);
+    for (const auto& chunks : window_chunks) {
+        for (const auto& chunk : chunks) {
+            ++segment_depths[boundary_index(chunk.first)];
+            --segment_depths[boundary_index(chunk.second)];
+        }
+    }
+    std::partial_sum(std::cbegin(segment_depths), std::cend(segment_depths), std::begin(segment_depths));
+    std::vector<double> shared_bytes(boundaries.size(), 0); // shared_bytes[i] is the sum over segments before boundary i
+    for (std::size_t i {1}; i < boundaries.size(); ++i) {
+        const auto depth = segment_depths[i - 1];
+        const auto segment_bytes = depth > 0 ? estimate_compressed_bytes(boundaries[i - 1], boundaries[i]) : 0;
+        shared_bytes[i] = shared_bytes[i - 1] + (depth > 0 ? static_cast<double>(segment_bytes) / depth : 0.0);
+    }
+    for (std::size_t i {0}; i < result.size(); ++i) {
+        double window_bytes {0};
+        for (const auto& chunk : window_chunks[i]) {
+            window_bytes += shared_bytes[boundary_index(chunk.second)] - shared_bytes[boundary_index(chunk.first)];
+        }
+        result[i] = static_cast<std::size_t>(std::ceil(window_bytes * reads_per_byte));
+    }
+    return result;
+}
+
 void HtslibSamFacade::write(const AlignedRead& read)
 {
     if (!hts_file_ || !hts_header_) {
@@ -611,8 +774,7 @@ void HtslibSamFacade::write(const AlignedRead& read)
 HtslibSamFacade::ReadContainer HtslibSamFacade::fetch_all_reads(const GenomicRegion& region) const
 {
     HtslibIterator it {*this, region};
-    ReadContainer result {};
-    result.reserve(defaultReserve_);
+    auto result = acquire_read_buffer(defaultReserve_);
     while (++it) {
         try {
             result.emplace_back(*it);
@@ -673,8 +835,9 @@ void HtslibSamFacade::init_maps()
                 e.set_reason("a sample tag (SM) in @RG lines is required but was not found");
                 throw e;
             }
-            sample_names_.emplace(extract_tag_value(line, readGroupIdTag),
-                                  extract_tag_value(line, sampleIdTag));
+            auto read_group = extract_tag_value(line, readGroupIdTag);
+            read_groups_.emplace(read_group, std::make_shared<const ReadGroupIdType>(read_group));
+            sample_names_.emplace(std::move(read_group), extract_tag_value(line, sampleIdTag));
             ++num_read_groups;
         }
     }
@@ -696,6 +859,41 @@ const std::string& HtslibSamFacade::get_contig_name(HtsTid target) const
     return contig_names_.at(target);
 }
 
+std::vector<HtslibSamFacade::IndexChunk>
+HtslibSamFacade::get_index_chunks(const HtsTid target, const GenomicRegion::Position begin,
+                                  const GenomicRegion::Position end) const
+{
+    const std::unique_ptr<hts_itr_t, decltype(&hts_itr_destroy)> itr {
+        sam_itr_queryi(hts_index_.get(), target, static_cast<int>(begin), static_cast<int>(end)),
+        hts_itr_destroy};
+    std::vector<IndexChunk> result {};
+    if (!itr) return result;
+    result.reserve(itr->n_off);
+    for (int i {0}; i < itr->n_off; ++i) {
+        if (itr->off[i].u < itr->off[i].v) result.emplace_back(itr->off[i].u, itr->off[i].v);
+    }
+    return result;
+}
+
+std::uint64_t HtslibSamFacade::count_compressed_bytes(const HtsTid target) const
+{
+    const auto itr = contig_compressed_bytes_.find(target);
+    if (itr != std::cend(contig_compressed_bytes_)) return itr->second;
+    std::uint64_t result {0};
+    for (const auto& chunk : get_index_chunks(target, 0, reference_size(get_contig_name(target)))) {
+        result += estimate_compressed_bytes(chunk.first, chunk.second);
+    }
+    contig_compressed_bytes_.emplace(target, result);
+    return result;
+}
+
+AlignedRead::ReadGroupPtr HtslibSamFacade::get_read_group(const ReadGroupIdType& read_group) const
+{
+    const auto itr = read_groups_.find(read_group);
+    if (itr != std::cend(read_groups_)) return itr->second;
+    return std::make_shared<const ReadGroupIdType>(read_group);
+}
+
 // HtslibIterator
 
 auto make_hts_iterator(const hts_idx_t* idx, bam_hdr_t* hdr, const GenomicRegion& region)
@@ -840,6 +1038,30 @@ auto extract_next_segment_flags(const bam1_core_t& c) noexcept
     return result;
 }
 
+bool HtslibSamFacade::HtslibIterator::passes(const ReadPrefilter::Clause& clause) const noexcept
+{
+    using Test = ReadPrefilter::Test;
+    const auto& info = hts_bam1_->core;
+    const auto sequence_length = static_cast<std::size_t>(info.l_qseq);
+    switch (clause.test) {
+        case Test::mapped: return (info.flag & BAM_FUNMAP) == 0;
+        case Test::notSecondary: return (info.flag & BAM_FSECONDARY) == 0;
+        case Test::notSupplementary: return (info.flag & BAM_FSUPPLEMENTARY) == 0;
+        case Test::notDuplicate: return (info.flag & BAM_FDUP) == 0;
+        case Test::notQcFail: return (info.flag & BAM_FQCFAIL) == 0;
+        case Test::minMappingQuality: return mapping_quality(info) >= clause.value;
+        case Test::minLength: return sequence_length >= clause.value;
+        // Reads overhanging the start of the contig are trimmed on construction, so
+        // only reject long reads that cannot overhang
+        case Test::maxLength: return sequence_length <= clause.value || info.pos < info.l_qseq;
+        case Test::notChimeric: return !has_multiple_segments(info);
+        case Test::nextSegmentMapped: return !has_multiple_segments(info) || (info.flag & BAM_FMUNMAP) == 0;
+        case Test::properTemplate: return !has_multiple_segments(info) || (info.flag & BAM_FPROPER_PAIR) != 0;
+        case Test::localTemplate: return !has_multiple_segments(info) || info.mtid == info.tid;
+    }
+    return true;
+}
+
 AlignedRead HtslibSamFacade::HtslibIterator::operator*() const
 {
     using std::begin; using std::end; using std::next; using std::move;
@@ -876,7 +1098,7 @@ AlignedRead HtslibSamFacade::HtslibIterator::operator*() const
             move(cigar),
             mapping_quality(info),
             extract_flags(info),
-            read_group(),
+            hts_facade_.get_read_group(read_group()),
             hts_facade_.get_contig_name(info.mtid),
             next_segment_position(info),
             template_length(info),
@@ -891,7 +1113,7 @@ AlignedRead HtslibSamFacade::HtslibIterator::operator*() const
             move(cigar),
             mapping_quality(info),
             extract_flags(info),
-            read_group()
+            hts_facade_.get_read_group(read_group())
         };
     }
 }
@@ -925,6 +1147,11 @@ std::size_t HtslibSamFacade::HtslibIterator::begin() const noexcept
     return hts_bam1_->core.pos;
 }
 
+std::size_t HtslibSamFacade::HtslibIterator::end() const noexcept
+{
+    return bam_endpos(hts_bam1_.get());
+}
+
 namespace {
 
 void set_contig(const std::int32_t tid, bam1_t* result) noexcept
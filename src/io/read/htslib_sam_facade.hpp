@@ -20,6 +20,7 @@
 
 #include "basics/aligned_read.hpp"
 #include "read_reader_impl.hpp"
+#include "htslib_thread_pool.hpp"
 
 namespace octopus {
 
@@ -37,6 +38,7 @@ public:
     using IReadReaderImpl::ReadContainer;
     using IReadReaderImpl::SampleReadMap;
     using IReadReaderImpl::PositionList;
+    using IReadReaderImpl::SampleFilterCountMap;
     
     using NucleotideSequence = AlignedRead::NucleotideSequence;
     
@@ -45,6 +47,7 @@ public:
     HtslibSamFacade() = delete;
     
     HtslibSamFacade(Path file_path);
+    HtslibSamFacade(Path file_path, std::shared_ptr<const HtslibThreadPool> decompression_pool);
     HtslibSamFacade(Path sam_out, Path sam_template);
     
     HtslibSamFacade(const HtslibSamFacade&)            = delete;
@@ -87,10 +90,16 @@ public:
                               const GenomicRegion& region) const override;
     SampleReadMap fetch_reads(const std::vector<SampleName>& samples,
                               const GenomicRegion& region) const override;
+    SampleReadMap fetch_reads(const std::vector<SampleName>& samples,
+                              const GenomicRegion& region,
+                              const ReadPrefilter& prefilter,
+                              SampleFilterCountMap& filter_counts) const override;
     
     GenomicRegion::Size reference_size(const GenomicRegion::ContigName& contig) const override;
     std::vector<GenomicRegion::ContigName> reference_contigs() const override;
     boost::optional<std::vector<GenomicRegion::ContigName>> mapped_contigs() const override;
+    boost::optional<std::vector<std::size_t>>
+    estimate_read_counts(const GenomicRegion& region, GenomicRegion::Size window_size) const override;
     
     void write(const AlignedRead& read);
     
@@ -134,8 +143,11 @@ private:
         
         HtslibSamFacade::ReadGroupIdType read_group() const;
         
+        bool passes(const ReadPrefilter::Clause& clause) const noexcept;
+        
         bool is_good() const noexcept;
         std::size_t begin() const noexcept;
+        std::size_t end() const noexcept;
     
     private:
         struct HtsIteratorDeleter
@@ -155,6 +167,7 @@ private:
     
     Path file_path_;
     
+    std::shared_ptr<const HtslibThreadPool> decompression_pool_;
     std::unique_ptr<htsFile, HtsFileDeleter> hts_file_;
     std::unique_ptr<bam_hdr_t, HtsHeaderDeleter> hts_header_;
     std::unique_ptr<hts_idx_t, HtsIndexDeleter> hts_index_;
@@ -162,13 +175,20 @@ private:
     std::unordered_map<GenomicRegion::ContigName, HtsTid> hts_targets_;
     std::unordered_map<HtsTid, GenomicRegion::ContigName> contig_names_;
     std::unordered_map<ReadGroupIdType, SampleName> sample_names_;
+    std::unordered_map<ReadGroupIdType, AlignedRead::ReadGroupPtr> read_groups_;
     
     std::vector<SampleName> samples_;
     
+    mutable std::unordered_map<HtsTid, std::uint64_t> contig_compressed_bytes_;
+    
     void init_maps();
     HtsTid get_htslib_target(const GenomicRegion::ContigName& contig) const;
     const GenomicRegion::ContigName& get_contig_name(HtsTid target) const;
+    AlignedRead::ReadGroupPtr get_read_group(const ReadGroupIdType& read_group) const;
     std::uint64_t get_num_mapped_reads(const GenomicRegion::ContigName& contig) const;
+    using IndexChunk = std::pair<std::uint64_t, std::uint64_t>; // BGZF virtual offsets [begin, end)
+    std::vector<IndexChunk> get_index_chunks(HtsTid target, GenomicRegion::Position begin, GenomicRegion::Position end) const;
+    std::uint64_t count_compressed_bytes(HtsTid target) const;
     ReadContainer fetch_all_reads(const GenomicRegion& region) const;
     void write(const AlignedRead& read, bam1_t* result) const;
 };
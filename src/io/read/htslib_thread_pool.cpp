@@ -0,0 +1,40 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "htslib_thread_pool.hpp"
+
+#include <stdexcept>
+
+namespace octopus { namespace io {
+
+HtslibThreadPool::HtslibThreadPool(const unsigned num_threads, const unsigned queue_size)
+: num_threads_ {num_threads}
+, pool_ {hts_tpool_init(static_cast<int>(num_threads)), HtsThreadPoolDeleter {}}
+, handle_ {}
+{
+    if (!pool_) {
+        throw std::runtime_error {"HtslibThreadPool: could not create htslib thread pool"};
+    }
+    handle_.pool = pool_.get();
+    // htslib uses twice the number of pool threads as the per-file queue size when this is zero
+    handle_.qsize = static_cast<int>(queue_size);
+}
+
+unsigned HtslibThreadPool::num_threads() const noexcept
+{
+    return num_threads_;
+}
+
+unsigned HtslibThreadPool::queue_size() const noexcept
+{
+    return handle_.qsize > 0 ? static_cast<unsigned>(handle_.qsize) : 2 * num_threads_;
+}
+
+bool HtslibThreadPool::attach(htsFile* file) const noexcept
+{
+    // htslib only reads the pool handle during the call, so sharing handle_ is safe
+    return file != nullptr && hts_set_opt(file, HTS_OPT_THREAD_POOL, &handle_) == 0;
+}
+
+} // namespace io
+} // namespace octopus
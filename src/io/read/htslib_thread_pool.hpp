@@ -0,0 +1,56 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef htslib_thread_pool_hpp
+#define htslib_thread_pool_hpp
+
+#include <memory>
+
+#include "htslib/hts.h"
+#include "htslib/thread_pool.h"
+
+namespace octopus { namespace io {
+
+/*
+ HtslibThreadPool owns an htslib thread pool that can be shared by any number of open htsFiles.
+ Attached files offload BGZF inflation and CRAM container decoding to the pool, and read ahead
+ up to queue_size blocks per file, so decoding overlaps with the caller consuming records.
+ 
+ The pool must outlive every file it is attached to.
+ */
+class HtslibThreadPool
+{
+public:
+    HtslibThreadPool() = delete;
+    
+    HtslibThreadPool(unsigned num_threads, unsigned queue_size = 0);
+    
+    HtslibThreadPool(const HtslibThreadPool&)            = delete;
+    HtslibThreadPool& operator=(const HtslibThreadPool&) = delete;
+    HtslibThreadPool(HtslibThreadPool&&)                 = delete;
+    HtslibThreadPool& operator=(HtslibThreadPool&&)      = delete;
+    
+    ~HtslibThreadPool() = default;
+    
+    unsigned num_threads() const noexcept;
+    unsigned queue_size() const noexcept;
+    
+    // Returns false if htslib could not attach the pool, in which case the file is
+    // still usable but decodes on the calling thread.
+    bool attach(htsFile* file) const noexcept;
+    
+private:
+    struct HtsThreadPoolDeleter
+    {
+        void operator()(hts_tpool* pool) const { hts_tpool_destroy(pool); }
+    };
+    
+    unsigned num_threads_;
+    std::unique_ptr<hts_tpool, HtsThreadPoolDeleter> pool_;
+    mutable htsThreadPool handle_;
+};
+
+} // namespace io
+} // namespace octopus
+
+#endif
@@ -0,0 +1,123 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "read_buffer_pool.hpp"
+
+#include <mutex>
+#include <algorithm>
+#include <utility>
+
+namespace octopus { namespace io {
+
+namespace {
+
+struct CachedBuffer
+{
+    ReadBuffer buffer;
+    std::size_t num_bytes;
+    MemoryBudget::Charge charge;
+};
+
+constexpr std::size_t maxCachedBuffers {32};
+constexpr std::size_t maxUnbudgetedCachedBytes {512 * 1024 * 1024};
+
+std::mutex pool_mutex {};
+std::shared_ptr<MemoryBudget> pool_budget {}; // must outlive the charges of cached_buffers
+std::vector<CachedBuffer> cached_buffers {};
+std::size_t num_cached_bytes {0};
+std::map<std::thread::id, std::size_t> high_water_marks {};
+
+std::size_t footprint(const ReadBuffer& buffer) noexcept
+{
+    return buffer.capacity() * sizeof(AlignedRead);
+}
+
+bool can_cache(const std::size_t num_bytes) noexcept
+{
+    if (num_bytes == 0 || cached_buffers.size() >= maxCachedBuffers) return false;
+    if (pool_budget) {
+        return num_bytes <= pool_budget->num_available_bytes();
+    } else {
+        return num_cached_bytes + num_bytes <= maxUnbudgetedCachedBytes;
+    }
+}
+
+} // namespace
+
+ReadBuffer acquire_read_buffer(const std::size_t min_capacity)
+{
+    ReadBuffer result {};
+    {
+        std::lock_guard<std::mutex> lock {pool_mutex};
+        if (!cached_buffers.empty()) {
+            // Prefer the largest buffer as it is most likely to avoid a reallocation
+            const auto largest = std::max_element(std::begin(cached_buffers), std::end(cached_buffers),
+                                                  [] (const auto& lhs, const auto& rhs) {
+                                                      return lhs.buffer.capacity() < rhs.buffer.capacity();
+                                                  });
+            result = std::move(largest->buffer);
+            num_cached_bytes -= largest->num_bytes;
+            *largest = std::move(cached_buffers.back());
+            cached_buffers.pop_back();
+        }
+    }
+    result.reserve(min_capacity);
+    return result;
+}
+
+void release_read_buffer(ReadBuffer& buffer)
+{
+    // The buffer may have held more reads than it does now (reads are filtered out or moved on before release),
+    // and the storage it touched then stays resident, so charge the capacity rather than the current size
+    const auto num_bytes = footprint(buffer);
+    buffer.clear();
+    std::unique_lock<std::mutex> lock {pool_mutex};
+    auto& high_water_mark = high_water_marks[std::this_thread::get_id()];
+    high_water_mark = std::max(high_water_mark, num_bytes);
+    if (can_cache(num_bytes)) {
+        num_cached_bytes += num_bytes;
+        auto charge = pool_budget ? pool_budget->charge(num_bytes) : MemoryBudget::Charge {};
+        cached_buffers.push_back({std::move(buffer), num_bytes, std::move(charge)});
+        buffer = ReadBuffer {};
+    } else {
+        lock.unlock();
+        ReadBuffer {}.swap(buffer);
+    }
+}
+
+void release_cached_read_buffers()
+{
+    std::vector<CachedBuffer> released {};
+    {
+        std::lock_guard<std::mutex> lock {pool_mutex};
+        released.swap(cached_buffers);
+        num_cached_bytes = 0;
+    }
+}
+
+void set_read_buffer_pool_budget(std::shared_ptr<MemoryBudget> budget)
+{
+    std::shared_ptr<MemoryBudget> old_budget {}; // must outlive the charges of released
+    std::vector<CachedBuffer> released {};
+    {
+        std::lock_guard<std::mutex> lock {pool_mutex};
+        released.swap(cached_buffers);
+        num_cached_bytes = 0;
+        old_budget = std::exchange(pool_budget, std::move(budget));
+    }
+}
+
+std::size_t num_cached_read_buffer_bytes()
+{
+    std::lock_guard<std::mutex> lock {pool_mutex};
+    return num_cached_bytes;
+}
+
+std::map<std::thread::id, std::size_t> read_buffer_high_water_marks()
+{
+    std::lock_guard<std::mutex> lock {pool_mutex};
+    return high_water_marks;
+}
+
+} // namespace io
+} // namespace octopus
@@ -0,0 +1,51 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef read_buffer_pool_hpp
+#define read_buffer_pool_hpp
+
+#include <vector>
+#include <map>
+#include <thread>
+#include <cstddef>
+#include <memory>
+
+#include "basics/aligned_read.hpp"
+#include "utils/memory_budget.hpp"
+
+namespace octopus { namespace io {
+
+/*
+ The read buffer pool recycles the large vectors that reads are decoded into. Each fetch reserves room
+ for millions of reads, which the allocator serves with a fresh mapping that is page faulted in as reads
+ are added and unmapped again once the reads have been moved on. Released buffers are cleared and kept
+ so later fetches, on any thread, can reuse the pages. Once the pool has a read memory budget, cached
+ buffers are charged to it and a buffer is only cached if the budget has room for it; until then the
+ cache is bounded by a fixed number of bytes.
+
+ The pool also records, for each thread that releases buffers, the largest buffer footprint it has seen.
+ */
+
+using ReadBuffer = std::vector<AlignedRead>;
+
+// Returns a recycled buffer if one is available, otherwise a new one. Either way the buffer is empty
+// and has capacity for at least min_capacity reads.
+ReadBuffer acquire_read_buffer(std::size_t min_capacity);
+
+// Clears the buffer and returns its storage to the pool. buffer is left empty without capacity.
+void release_read_buffer(ReadBuffer& buffer);
+
+// Frees all buffers held by the pool.
+void release_cached_read_buffers();
+
+// Frees all buffers held by the pool and charges those cached from now on to budget.
+void set_read_buffer_pool_budget(std::shared_ptr<MemoryBudget> budget);
+
+std::size_t num_cached_read_buffer_bytes();
+
+std::map<std::thread::id, std::size_t> read_buffer_high_water_marks();
+
+} // namespace io
+} // namespace octopus
+
+#endif
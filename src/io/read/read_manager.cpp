@@ -8,6 +8,8 @@
 #include <utility>
 #include <deque>
 #include <numeric>
+#include <future>
+#include <functional>
 #include <cassert>
 
 #include <boost/filesystem/operations.hpp>
@@ -15,12 +17,34 @@
 #include "basics/aligned_read.hpp"
 #include "utils/append.hpp"
 #include "utils/coverage_tracker.hpp"
+#include "read_buffer_pool.hpp"
 
 namespace octopus { namespace io {
 
+namespace {
+
+std::shared_ptr<const HtslibThreadPool> make_decompression_pool(const unsigned num_threads)
+{
+    if (num_threads == 0) return nullptr;
+    return std::make_shared<HtslibThreadPool>(num_threads);
+}
+
+} // namespace
+
 ReadManager::ReadManager(std::vector<Path> read_file_paths, unsigned max_open_files)
+: ReadManager {std::move(read_file_paths), max_open_files, 0}
+{}
+
+ReadManager::ReadManager(std::vector<Path> read_file_paths, unsigned max_open_files, unsigned num_decompression_threads)
+: ReadManager {std::move(read_file_paths), max_open_files, num_decompression_threads, nullptr}
+{}
+
+ReadManager::ReadManager(std::vector<Path> read_file_paths, unsigned max_open_files, unsigned num_decompression_threads,
+                         std::shared_ptr<ThreadPool> workers)
 : max_open_files_ {max_open_files}
 , num_files_ {static_cast<unsigned>(read_file_paths.size())}
+, decompression_pool_ {make_decompression_pool(num_decompression_threads)}
+, workers_ {std::move(workers)}
 , closed_readers_ {
     std::make_move_iterator(std::begin(read_file_paths)),
     std::make_move_iterator(std::end(read_file_paths))}
@@ -48,6 +72,8 @@ ReadManager::ReadManager(ReadManager&& other)
 num_files_ {std::move(other.num_files_)}
 {
     std::lock_guard<std::mutex> lock {other.mutex_};
+    decompression_pool_             = std::move(other.decompression_pool_);
+    workers_                        = std::move(other.workers_);
     closed_readers_                 = std::move(other.closed_readers_);
     open_readers_                   = std::move(other.open_readers_);
     reader_paths_containing_sample_ = std::move(other.reader_paths_containing_sample_);
@@ -61,6 +87,8 @@ void swap(ReadManager& lhs, ReadManager& rhs) noexcept
     std::lock(lhs.mutex_, rhs.mutex_);
     std::lock_guard<std::mutex> lock_lhs {lhs.mutex_, std::adopt_lock}, lock_rhs {rhs.mutex_, std::adopt_lock};
     using std::swap;
+    swap(lhs.decompression_pool_,             rhs.decompression_pool_);
+    swap(lhs.workers_,                        rhs.workers_);
     swap(lhs.closed_readers_,                 rhs.closed_readers_);
     swap(lhs.open_readers_,                   rhs.open_readers_);
     swap(lhs.reader_paths_containing_sample_, rhs.reader_paths_containing_sample_);
@@ -77,7 +105,7 @@ void ReadManager::close() const noexcept
 bool ReadManager::good() const noexcept
 {
     return std::all_of(std::cbegin(open_readers_), std::cend(open_readers_),
-                       [] (const auto& p) { return p.second.is_open(); });
+                       [] (const auto& p) { return p.second->is_open(); });
 }
 
 unsigned ReadManager::num_files() const noexcept
@@ -110,6 +138,11 @@ const std::vector<ReadManager::SampleName>& ReadManager::samples() const
     return samples_;
 }
 
+std::shared_ptr<ThreadPool> ReadManager::workers() const noexcept
+{
+    return workers_;
+}
+
 unsigned ReadManager::drop_samples(std::vector<SampleName> samples)
 {
     std::sort(std::begin(samples), std::end(samples));
@@ -167,20 +200,15 @@ bool ReadManager::has_reads(const std::vector<SampleName>& samples, const Genomi
 {
     if (all_readers_are_open()) {
         return std::any_of(std::cbegin(open_readers_), std::cend(open_readers_),
-                           [&] (const auto& p) { return p.second.has_reads(samples, region); });
+                           [&] (const auto& p) { return p.second->has_reads(samples, region); });
     } else {
-        std::lock_guard<std::mutex> lock {mutex_};
         auto reader_paths = get_reader_paths_containing_samples(samples);
-        auto reader_itr = partition_open(reader_paths);
         while (!reader_paths.empty()) {
-            if (std::any_of(reader_itr, end(reader_paths),
-                            [this, &region, &samples] (const auto& reader_path) {
-                                return open_readers_.at(reader_path).has_reads(samples, region);
-                            })) {
+            const auto readers = acquire_readers(reader_paths);
+            if (std::any_of(std::cbegin(readers), std::cend(readers),
+                            [&] (const auto& reader) { return reader->has_reads(samples, region); })) {
                 return true;
             }
-            reader_paths.erase(reader_itr, end(reader_paths));
-            reader_itr = open_readers(begin(reader_paths), end(reader_paths));
         }
         return false;
     }
@@ -190,20 +218,15 @@ bool ReadManager::has_reads(const GenomicRegion& region) const
 {
     if (all_readers_are_open()) {
         return std::any_of(std::cbegin(open_readers_), std::cend(open_readers_),
-                           [&] (const auto& p) { return p.second.has_reads(region); });
+                           [&] (const auto& p) { return p.second->has_reads(region); });
     } else {
-        std::lock_guard<std::mutex> lock {mutex_};
         auto reader_paths = get_reader_paths_containing_samples(samples());
-        auto reader_itr = partition_open(reader_paths);
         while (!reader_paths.empty()) {
-            if (std::any_of(reader_itr, end(reader_paths),
-                            [this, &region] (const auto& reader_path) {
-                                return open_readers_.at(reader_path).has_reads(region);
-                            })) {
+            const auto readers = acquire_readers(reader_paths);
+            if (std::any_of(std::cbegin(readers), std::cend(readers),
+                            [&] (const auto& reader) { return reader->has_reads(region); })) {
                 return true;
             }
-            reader_paths.erase(reader_itr, end(reader_paths));
-            reader_itr = open_readers(begin(reader_paths), end(reader_paths));
         }
         return false;
     }
@@ -214,20 +237,15 @@ std::size_t ReadManager::count_reads(const SampleName& sample, const GenomicRegi
     if (all_readers_are_open()) {
         return std::accumulate(std::cbegin(open_readers_), std::cend(open_readers_), std::size_t {0},
                                [&] (std::size_t curr, const auto& p) {
-                                   return curr + p.second.count_reads(sample, region);
+                                   return curr + p.second->count_reads(sample, region);
                                });
     } else {
-        std::lock_guard<std::mutex> lock {mutex_};
         auto reader_paths = get_possible_reader_paths({sample}, region);
-        auto reader_itr = partition_open(reader_paths);
         std::size_t result {0};
         while (!reader_paths.empty()) {
-            using std::begin; using std::end; using std::for_each;
-            for_each(reader_itr, end(reader_paths), [this, &sample, &region, &result] (const auto& reader_path) {
-                result += open_readers_.at(reader_path).count_reads(sample, region);
-            });
-            reader_paths.erase(reader_itr, end(reader_paths));
-            reader_itr = open_readers(begin(reader_paths), end(reader_paths));
+            for (const auto& reader : acquire_readers(reader_paths)) {
+                result += reader->count_reads(sample, region);
+            }
         }
         return result;
     }
@@ -238,20 +256,15 @@ std::size_t ReadManager::count_reads(const std::vector<SampleName>& samples, con
     if (all_readers_are_open()) {
         return std::accumulate(std::cbegin(open_readers_), std::cend(open_readers_), std::size_t {0},
                                [&] (std::size_t curr, const auto& p) {
-                                   return curr + p.second.count_reads(samples, region);
+                                   return curr + p.second->count_reads(samples, region);
                                });
     } else {
-        std::lock_guard<std::mutex> lock {mutex_};
         auto reader_paths = get_possible_reader_paths(samples, region);
-        auto reader_itr = partition_open(reader_paths);
         std::size_t result {0};
         while (!reader_paths.empty()) {
-            using std::begin; using std::end; using std::for_each;
-            for_each(reader_itr, end(reader_paths), [this, &samples, &region, &result] (const auto& reader_path) {
-                result += open_readers_.at(reader_path).count_reads(samples, region);
-            });
-            reader_paths.erase(reader_itr, end(reader_paths));
-            reader_itr = open_readers(begin(reader_paths), end(reader_paths));
+            for (const auto& reader : acquire_readers(reader_paths)) {
+                result += reader->count_reads(samples, region);
+            }
         }
         return result;
     }
@@ -314,25 +327,21 @@ GenomicRegion ReadManager::find_covered_subregion(const std::vector<SampleName>&
     if (all_readers_are_open()) {
         for (const auto& p : open_readers_) {
             // Request one more than the max so we can determine if the entire request region can be included
-            const auto positions = p.second.extract_read_positions(samples, region, max_reads + 1);
+            const auto positions = p.second->extract_read_positions(samples, region, max_reads + 1);
             for (auto position : positions) {
                 add(position, position_tracker);
             }
         }
     } else {
-        std::lock_guard<std::mutex> lock {mutex_};
         auto reader_paths = get_possible_reader_paths(samples, region);
-        auto reader_itr = partition_open(reader_paths);
         while (!reader_paths.empty()) {
-            std::for_each(reader_itr, end(reader_paths), [&] (const auto& reader_path) {
+            for (const auto& reader : acquire_readers(reader_paths)) {
                 // Request one more than the max so we can determine if the entire request region can be included
-                const auto positions = open_readers_.at(reader_path).extract_read_positions(samples, region, max_reads + 1);
+                const auto positions = reader->extract_read_positions(samples, region, max_reads + 1);
                 for (auto position : positions) {
                     add(position, position_tracker);
                 }
-            });
-            reader_paths.erase(reader_itr, end(reader_paths));
-            reader_itr = open_readers(begin(reader_paths), end(reader_paths));
+            }
         }
     }
     return max_head_region(position_tracker, region, max_reads);
@@ -343,74 +352,128 @@ GenomicRegion ReadManager::find_covered_subregion(const GenomicRegion& region, c
     return find_covered_subregion(samples(), region, max_reads);
 }
 
+boost::optional<std::vector<std::size_t>>
+ReadManager::estimate_read_counts(const std::vector<SampleName>& samples, const GenomicRegion& region,
+                                  const GenomicRegion::Size window_size) const
+{
+    if (window_size == 0) return boost::none;
+    std::vector<std::size_t> result((size(region) + window_size - 1) / window_size, 0);
+    auto reader_paths = get_possible_reader_paths(samples, region);
+    while (!reader_paths.empty()) {
+        for (const auto& reader : acquire_readers(reader_paths)) {
+            const auto reader_counts = reader->estimate_read_counts(region, window_size);
+            if (!reader_counts) return boost::none;
+            assert(reader_counts->size() == result.size());
+            std::transform(std::cbegin(*reader_counts), std::cend(*reader_counts), std::cbegin(result), std::begin(result),
+                           std::plus<> {});
+        }
+    }
+    return result;
+}
+
 namespace {
 
-template <typename Container>
-void merge_insert(Container&& src, Container& dst)
+// Merges the sorted sources into dst (which must be empty), keeping the relative order of equivalent
+// elements from different sources. Each source is released once merged.
+void k_way_merge(std::vector<ReadBuffer*>& sources, ReadBuffer& dst)
 {
-    auto itr = octopus::utils::append(std::move(src), dst);
-    std::inplace_merge(std::begin(dst), itr, std::end(dst));
+    assert(dst.empty());
+    if (sources.empty()) return;
+    if (sources.size() == 1) {
+        dst = std::move(*sources.front());
+        return;
+    }
+    std::size_t total_size {0};
+    for (const auto* source : sources) total_size += source->size();
+    dst = acquire_read_buffer(total_size);
+    struct Cursor
+    {
+        ReadBuffer::iterator first, last;
+        std::size_t source;
+    };
+    std::vector<Cursor> heap {};
+    heap.reserve(sources.size());
+    for (std::size_t i {0}; i < sources.size(); ++i) {
+        heap.push_back({std::begin(*sources[i]), std::end(*sources[i]), i});
+    }
+    const auto greater = [] (const Cursor& lhs, const Cursor& rhs) {
+        return *rhs.first < *lhs.first || (!(*lhs.first < *rhs.first) && rhs.source < lhs.source);
+    };
+    std::make_heap(std::begin(heap), std::end(heap), greater);
+    while (!heap.empty()) {
+        std::pop_heap(std::begin(heap), std::end(heap), greater);
+        auto& cursor = heap.back();
+        dst.push_back(std::move(*cursor.first));
+        if (++cursor.first == cursor.last) {
+            heap.pop_back();
+        } else {
+            std::push_heap(std::begin(heap), std::end(heap), greater);
+        }
+    }
+    for (auto* source : sources) {
+        release_read_buffer(*source);
+    }
 }
 
-} // namespace
-
-ReadManager::ReadContainer ReadManager::fetch_reads(const SampleName& sample, const GenomicRegion& region) const
+void merge_reads(std::vector<IReadReaderImpl::SampleReadMap>& reader_reads, IReadReaderImpl::SampleReadMap& result)
 {
-    ReadContainer result {};
-    if (all_readers_are_open()) {
-        for (const auto& p : open_readers_) {
-            merge_insert(p.second.fetch_reads(sample, region), result);
+    std::vector<IReadReaderImpl::ReadContainer*> sources {};
+    sources.reserve(reader_reads.size());
+    for (auto& p : result) {
+        sources.clear();
+        for (auto& reads : reader_reads) {
+            auto sample_itr = reads.find(p.first);
+            if (sample_itr != std::end(reads) && !sample_itr->second.empty()) {
+                sources.push_back(&sample_itr->second);
+            }
         }
-    } else {
-        std::lock_guard<std::mutex> lock {mutex_};
-        auto reader_paths = get_possible_reader_paths({sample}, region);
-        auto reader_itr = partition_open(reader_paths);
-        while (!reader_paths.empty()) {
-            using std::begin; using std::end; using std::make_move_iterator; using std::for_each;
-            for_each(reader_itr, end(reader_paths), [&] (const auto& reader_path) {
-                merge_insert(open_readers_.at(reader_path).fetch_reads(sample, region), result);
-            });
-            reader_paths.erase(reader_itr, end(reader_paths));
-            reader_itr = open_readers(begin(reader_paths), end(reader_paths));
+        k_way_merge(sources, p.second);
+    }
+}
+
+void add(const IReadReaderImpl::SampleFilterCountMap& src, IReadReaderImpl::SampleFilterCountMap& dst)
+{
+    for (const auto& sample_counts : src) {
+        auto& dst_counts = dst[sample_counts.first];
+        for (const auto& p : sample_counts.second) {
+            dst_counts[p.first] += p.second;
         }
     }
-    return result;
+}
+
+} // namespace
+
+ReadManager::ReadContainer ReadManager::fetch_reads(const SampleName& sample, const GenomicRegion& region) const
+{
+    auto reads = fetch_reads(std::vector<SampleName> {sample}, region);
+    return std::move(reads.at(sample));
 }
 
 ReadManager::SampleReadMap ReadManager::fetch_reads(const std::vector<SampleName>& samples, const GenomicRegion& region) const
+{
+    SampleFilterCountMap filter_counts {};
+    return fetch_reads(samples, region, ReadPrefilter {}, filter_counts);
+}
+
+ReadManager::SampleReadMap ReadManager::fetch_reads(const std::vector<SampleName>& samples, const GenomicRegion& region,
+                                                    const ReadPrefilter& prefilter, SampleFilterCountMap& filter_counts) const
 {
     SampleReadMap result {samples.size()};
     // Populate here so we can do unchcked access
     for (const auto& sample : samples) {
         result.emplace(std::piecewise_construct, std::forward_as_tuple(sample), std::forward_as_tuple());
     }
+    std::vector<SampleReadMap> reader_reads {};
     if (all_readers_are_open()) {
-        for (const auto& p : open_readers_) {
-            auto reads = p.second.fetch_reads(samples, region);
-            for (auto&& r : reads) {
-                merge_insert(std::move(r.second), result.at(r.first));
-                r.second.clear();
-                r.second.shrink_to_fit();
-            }
-        }
+        reader_reads = fetch_reads(get_open_readers(), samples, region, prefilter, filter_counts);
     } else {
-        std::lock_guard<std::mutex> lock {mutex_};
         auto reader_paths = get_possible_reader_paths(samples, region);
-        auto reader_itr = partition_open(reader_paths);
         while (!reader_paths.empty()) {
-            using std::begin; using std::end; using std::make_move_iterator; using std::for_each;
-            for_each(reader_itr, end(reader_paths), [&] (const auto& reader_path) {
-                auto reads = open_readers_.at(reader_path).fetch_reads(samples, region);
-                for (auto&& r : reads) {
-                    merge_insert(std::move(r.second), result.at(r.first));
-                    r.second.clear();
-                    r.second.shrink_to_fit();
-                }
-            });
-            reader_paths.erase(reader_itr, end(reader_paths));
-            reader_itr = open_readers(begin(reader_paths), end(reader_paths));
+            auto reads = fetch_reads(acquire_readers(reader_paths), samples, region, prefilter, filter_counts);
+            utils::append(std::move(reads), reader_reads);
         }
     }
+    merge_reads(reader_reads, result);
     return result;
 }
 
@@ -445,18 +508,18 @@ void ReadManager::setup_reader_samples_and_regions()
 {
     for (const auto& reader_path : closed_readers_) {
         auto reader = make_reader(reader_path);
-        auto possible_reader_regions = reader.mapped_regions();
+        auto possible_reader_regions = reader->mapped_regions();
         if (possible_reader_regions) {
             add_possible_regions_to_reader_map(reader_path, *possible_reader_regions);
         } else {
-            auto possible_reader_contigs = reader.mapped_contigs();
+            auto possible_reader_contigs = reader->mapped_contigs();
             if (possible_reader_contigs) {
-                add_possible_regions_to_reader_map(reader_path, extract_spanning_regions(*possible_reader_contigs, reader));
+                add_possible_regions_to_reader_map(reader_path, extract_spanning_regions(*possible_reader_contigs, *reader));
             } else {
-                add_possible_regions_to_reader_map(reader_path, extract_spanning_regions(reader.reference_contigs(), reader));
+                add_possible_regions_to_reader_map(reader_path, extract_spanning_regions(reader->reference_contigs(), *reader));
             }
         }
-        add_reader_to_sample_map(reader_path, reader.extract_samples());
+        add_reader_to_sample_map(reader_path, reader->extract_samples());
     }
 }
 
@@ -470,9 +533,9 @@ void ReadManager::open_initial_files()
     open_readers(begin(reader_paths), begin(reader_paths) + num_files_to_open);
 }
 
-ReadReader ReadManager::make_reader(const Path& reader_path) const
+ReadManager::ReaderHandle ReadManager::make_reader(const Path& reader_path) const
 {
-    return ReadReader {reader_path};
+    return std::make_shared<ReadReader>(reader_path, decompression_pool_);
 }
 
 bool ReadManager::all_readers_are_open() const noexcept
@@ -558,6 +621,60 @@ void ReadManager::close_readers(unsigned n) const
     }
 }
 
+std::vector<ReadManager::ReaderHandle> ReadManager::acquire_readers(std::vector<Path>& reader_paths) const
+{
+    // Only the reader cache is guarded; the returned readers are used without holding the lock
+    std::lock_guard<std::mutex> lock {mutex_};
+    auto reader_itr = partition_open(reader_paths);
+    if (reader_itr == std::end(reader_paths)) {
+        reader_itr = open_readers(std::begin(reader_paths), std::end(reader_paths));
+    }
+    std::vector<ReaderHandle> result {};
+    result.reserve(std::distance(reader_itr, std::end(reader_paths)));
+    std::transform(reader_itr, std::end(reader_paths), std::back_inserter(result),
+                   [this] (const Path& reader_path) { return open_readers_.at(reader_path); });
+    reader_paths.erase(reader_itr, std::end(reader_paths));
+    return result;
+}
+
+std::vector<ReadManager::ReaderHandle> ReadManager::get_open_readers() const
+{
+    std::vector<ReaderHandle> result {};
+    result.reserve(open_readers_.size());
+    for (const auto& p : open_readers_) {
+        result.push_back(p.second);
+    }
+    return result;
+}
+
+std::vector<ReadManager::SampleReadMap>
+ReadManager::fetch_reads(const std::vector<ReaderHandle>& readers,
+                         const std::vector<SampleName>& samples, const GenomicRegion& region,
+                         const ReadPrefilter& prefilter, SampleFilterCountMap& filter_counts) const
+{
+    std::vector<SampleReadMap> result(readers.size());
+    if (workers_ && readers.size() > 1) {
+        std::vector<SampleFilterCountMap> reader_filter_counts(readers.size());
+        std::vector<std::future<SampleReadMap>> futures {};
+        futures.reserve(readers.size());
+        for (std::size_t i {0}; i < readers.size(); ++i) {
+            futures.push_back(workers_->push([&, i] () {
+                return readers[i]->fetch_reads(samples, region, prefilter, reader_filter_counts[i]);
+            }));
+        }
+        // Tasks reference locals so all must finish before any exception propagates
+        for (auto& future : futures) future.wait();
+        for (std::size_t i {0}; i < readers.size(); ++i) {
+            result[i] = futures[i].get();
+            add(reader_filter_counts[i], filter_counts);
+        }
+    } else {
+        std::transform(std::cbegin(readers), std::cend(readers), std::begin(result),
+                       [&] (const auto& reader) { return reader->fetch_reads(samples, region, prefilter, filter_counts); });
+    }
+    return result;
+}
+
 void ReadManager::add_possible_regions_to_reader_map(const Path& reader_path, const std::vector<GenomicRegion>& regions)
 {
     for (const auto& region : regions) {
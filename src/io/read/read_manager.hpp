@@ -11,6 +11,7 @@
 #include <initializer_list>
 #include <cstddef>
 #include <mutex>
+#include <memory>
 
 #include <boost/filesystem.hpp>
 
@@ -20,6 +21,8 @@
 #include "utils/hash_functions.hpp"
 #include "read_reader.hpp"
 #include "read_reader_impl.hpp"
+#include "htslib_thread_pool.hpp"
+#include "utils/thread_pool.hpp"
 
 namespace octopus {
 
@@ -35,10 +38,17 @@ public:
     using SampleName    = IReadReaderImpl::SampleName;
     using ReadContainer = IReadReaderImpl::ReadContainer;
     using SampleReadMap = IReadReaderImpl::SampleReadMap;
+    using SampleFilterCountMap = IReadReaderImpl::SampleFilterCountMap;
     
     ReadManager() = default;
     
     ReadManager(std::vector<Path> read_file_paths, unsigned max_open_files);
+    // All readers share a single pool of num_decompression_threads threads (none if zero)
+    ReadManager(std::vector<Path> read_file_paths, unsigned max_open_files, unsigned num_decompression_threads);
+    // Files that may overlap a fetch are read concurrently on workers (if given), which may be shared with other
+    // components as long as none of them fetch from this ReadManager while running on the pool
+    ReadManager(std::vector<Path> read_file_paths, unsigned max_open_files, unsigned num_decompression_threads,
+                std::shared_ptr<ThreadPool> workers);
     ReadManager(std::initializer_list<Path> read_file_paths);
     
     ReadManager(const ReadManager&)            = delete;
@@ -57,6 +67,7 @@ public:
     unsigned num_samples() const noexcept;
     const std::vector<SampleName>& samples() const;
     unsigned drop_samples(std::vector<SampleName> samples);
+    std::shared_ptr<ThreadPool> workers() const noexcept;
     
     bool has_reads(const SampleName& sample, const GenomicRegion& region) const;
     bool has_reads(const std::vector<SampleName>& samples, const GenomicRegion& region) const;
@@ -72,8 +83,16 @@ public:
                                          std::size_t max_reads) const;
     GenomicRegion find_covered_subregion(const GenomicRegion& region, std::size_t max_reads) const;
     
+    // Estimated number of reads in each consecutive window_size block of region using only the read file
+    // indices, so no reads are read. boost::none if any file that may contain the samples cannot be estimated.
+    boost::optional<std::vector<std::size_t>>
+    estimate_read_counts(const std::vector<SampleName>& samples, const GenomicRegion& region,
+                         GenomicRegion::Size window_size) const;
+    
     ReadContainer fetch_reads(const SampleName& sample,  const GenomicRegion& region) const;
     SampleReadMap fetch_reads(const std::vector<SampleName>& samples, const GenomicRegion& region) const;
+    SampleReadMap fetch_reads(const std::vector<SampleName>& samples, const GenomicRegion& region,
+                              const ReadPrefilter& prefilter, SampleFilterCountMap& filter_counts) const;
     SampleReadMap fetch_reads(const GenomicRegion& region) const;
     
 private:
@@ -84,7 +103,9 @@ private:
         bool operator()(const Path& lhs, const Path& rhs) const;
     };
     
-    using OpenReaderMap           = std::map<Path, ReadReader, FileSizeCompare>;
+    // Readers are shared so a reader can be closed while other threads are still reading from it
+    using ReaderHandle            = std::shared_ptr<ReadReader>;
+    using OpenReaderMap           = std::map<Path, ReaderHandle, FileSizeCompare>;
     using ClosedReaderSet         = std::unordered_set<Path, PathHash>;
     using SampleIdToReaderPathMap = std::unordered_map<SampleName, std::vector<Path>>;
     using ContigMap               = MappableMap<GenomicRegion::ContigName, ContigRegion>;
@@ -93,6 +114,9 @@ private:
     unsigned max_open_files_ = 200;
     unsigned num_files_;
     
+    std::shared_ptr<const HtslibThreadPool> decompression_pool_;
+    std::shared_ptr<ThreadPool> workers_;
+    
     mutable ClosedReaderSet closed_readers_;
     mutable OpenReaderMap open_readers_;
     
@@ -105,7 +129,7 @@ private:
     void setup_reader_samples_and_regions();
     void open_initial_files();
     
-    ReadReader make_reader(const Path& reader_path) const;
+    ReaderHandle make_reader(const Path& reader_path) const;
     bool all_readers_are_open() const noexcept;
     bool is_open(const Path& reader_path) const noexcept;
     std::vector<Path>::iterator partition_open(std::vector<Path>& reader_paths) const;
@@ -118,6 +142,11 @@ private:
     void close_reader(const Path& reader_path) const;
     Path choose_reader_to_close() const;
     void close_readers(unsigned n) const;
+    std::vector<ReaderHandle> acquire_readers(std::vector<Path>& reader_paths) const;
+    std::vector<ReaderHandle> get_open_readers() const;
+    std::vector<SampleReadMap> fetch_reads(const std::vector<ReaderHandle>& readers,
+                                           const std::vector<SampleName>& samples, const GenomicRegion& region,
+                                           const ReadPrefilter& prefilter, SampleFilterCountMap& filter_counts) const;
     
     void add_possible_regions_to_reader_map(const Path& reader_path, const std::vector<GenomicRegion>& regions);
     void add_reader_to_sample_map(const Path& reader_path, const std::vector<SampleName>& samples_in_reader);
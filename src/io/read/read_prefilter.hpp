@@ -0,0 +1,101 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef read_prefilter_hpp
+#define read_prefilter_hpp
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <utility>
+
+#include <boost/optional.hpp>
+
+namespace octopus { namespace io {
+
+/*
+ ReadPrefilter is a conjunction of simple tests on the fixed fields of an alignment record (flags,
+ mapping quality, and sequence length) that a reader can evaluate before it constructs an AlignedRead.
+ 
+ A prefilter is compiled from read filters and must only reject reads those filters would also
+ reject, so a reader is always free to ignore it.
+ 
+ A prefilter may also carry a coverage limit, which lets a reader downsample reads as they are decoded
+ (see StreamingDownsampler) rather than after they have all been constructed.
+ */
+class ReadPrefilter
+{
+public:
+    using SampleName           = std::string;
+    using FilterCountMap       = std::unordered_map<std::string, std::size_t>;
+    using SampleFilterCountMap = std::unordered_map<SampleName, FilterCountMap>;
+    
+    enum class Test
+    {
+        mapped,
+        notSecondary,
+        notSupplementary,
+        notDuplicate,
+        notQcFail,
+        minMappingQuality,
+        minLength,
+        maxLength,
+        notChimeric,
+        nextSegmentMapped,
+        properTemplate,
+        localTemplate
+    };
+    
+    struct Clause
+    {
+        std::string name; // name of the filter the clause was compiled from
+        Test test;
+        std::size_t value;
+    };
+    
+    struct CoverageLimit
+    {
+        unsigned trigger_coverage, target_coverage;
+    };
+    
+    using ClauseIterator = std::vector<Clause>::const_iterator;
+    
+    ReadPrefilter() = default;
+    
+    ReadPrefilter(const ReadPrefilter&)            = default;
+    ReadPrefilter& operator=(const ReadPrefilter&) = default;
+    ReadPrefilter(ReadPrefilter&&)                 = default;
+    ReadPrefilter& operator=(ReadPrefilter&&)      = default;
+    
+    ~ReadPrefilter() = default;
+    
+    void add(std::string name, Test test, std::size_t value = 0)
+    {
+        clauses_.push_back({std::move(name), test, value});
+    }
+    
+    void set_coverage_limit(unsigned trigger_coverage, unsigned target_coverage)
+    {
+        coverage_limit_ = CoverageLimit {trigger_coverage, target_coverage};
+    }
+    
+    const boost::optional<CoverageLimit>& coverage_limit() const noexcept { return coverage_limit_; }
+    
+    bool empty() const noexcept { return clauses_.empty() && !coverage_limit_; }
+    std::size_t size() const noexcept { return clauses_.size(); }
+    
+    const Clause& operator[](std::size_t n) const noexcept { return clauses_[n]; }
+    
+    ClauseIterator begin() const noexcept { return std::cbegin(clauses_); }
+    ClauseIterator end() const noexcept { return std::cend(clauses_); }
+    
+private:
+    std::vector<Clause> clauses_;
+    boost::optional<CoverageLimit> coverage_limit_;
+};
+
+} // namespace io
+} // namespace octopus
+
+#endif
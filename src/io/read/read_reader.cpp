@@ -67,19 +67,23 @@ bool is_valid_read_file_type(const boost::filesystem::path& file_path)
     return includes(validReadFileExtensions, get_extension(file_path));
 }
 
-auto make_reader(const boost::filesystem::path& file_path)
+auto make_reader(const boost::filesystem::path& file_path, std::shared_ptr<const HtslibThreadPool> decompression_pool)
 {
     if (!is_valid_read_file_type(file_path)) {
         throw UnknownReadFileFormat {file_path};
     }
-    return std::make_unique<HtslibSamFacade>(file_path);
+    return std::make_unique<HtslibSamFacade>(file_path, std::move(decompression_pool));
 }
 
 } //namespace
 
 ReadReader::ReadReader(const boost::filesystem::path& file_path)
+: ReadReader {file_path, nullptr}
+{}
+
+ReadReader::ReadReader(const boost::filesystem::path& file_path, std::shared_ptr<const HtslibThreadPool> decompression_pool)
 : file_path_ {file_path}
-, impl_ {make_reader(file_path_)}
+, impl_ {make_reader(file_path_, std::move(decompression_pool))}
 {}
 
 ReadReader::ReadReader(ReadReader&& other)
@@ -158,6 +162,13 @@ boost::optional<std::vector<GenomicRegion>> ReadReader::mapped_regions() const
     return impl_->mapped_regions();
 }
 
+boost::optional<std::vector<std::size_t>>
+ReadReader::estimate_read_counts(const GenomicRegion& region, const GenomicRegion::Size window_size) const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    return impl_->estimate_read_counts(region, window_size);
+}
+
 bool ReadReader::has_reads(const GenomicRegion& region) const
 {
     std::lock_guard<std::mutex> lock {mutex_};
@@ -237,6 +248,15 @@ ReadReader::SampleReadMap ReadReader::fetch_reads(const std::vector<SampleName>&
     return impl_->fetch_reads(samples, region);
 }
 
+ReadReader::SampleReadMap ReadReader::fetch_reads(const std::vector<SampleName>& samples,
+                                                  const GenomicRegion& region,
+                                                  const ReadPrefilter& prefilter,
+                                                  SampleFilterCountMap& filter_counts) const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    return impl_->fetch_reads(samples, region, prefilter, filter_counts);
+}
+
 bool operator==(const ReadReader& lhs, const ReadReader& rhs)
 {
     return lhs.path() == rhs.path();
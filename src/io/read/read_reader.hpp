@@ -24,6 +24,8 @@ class AlignedRead;
 
 namespace io {
 
+class HtslibThreadPool;
+
 /*
  ReadReader is a simple RAII threadsafe wrapper around a IReadReaderImpl
  */
@@ -37,9 +39,12 @@ public:
     using SampleReadMap   = IReadReaderImpl::SampleReadMap;
     using PositionList    = IReadReaderImpl::PositionList;
     
+    using SampleFilterCountMap = IReadReaderImpl::SampleFilterCountMap;
+    
     ReadReader() = default;
     
     ReadReader(const Path& file_path);
+    ReadReader(const Path& file_path, std::shared_ptr<const HtslibThreadPool> decompression_pool);
     
     ReadReader(const ReadReader&)            = delete;
     ReadReader& operator=(const ReadReader&) = delete;
@@ -64,6 +69,8 @@ public:
     GenomicRegion::Size reference_size(const GenomicRegion::ContigName& contig) const;
     boost::optional<std::vector<GenomicRegion::ContigName>> mapped_contigs() const;
     boost::optional<std::vector<GenomicRegion>> mapped_regions() const;
+    boost::optional<std::vector<std::size_t>>
+    estimate_read_counts(const GenomicRegion& region, GenomicRegion::Size window_size) const;
     
     bool has_reads(const GenomicRegion& region) const;
     bool has_reads(const SampleName& sample,
@@ -91,6 +98,10 @@ public:
                               const GenomicRegion& region) const;
     SampleReadMap fetch_reads(const std::vector<SampleName>& samples,
                               const GenomicRegion& region) const;
+    SampleReadMap fetch_reads(const std::vector<SampleName>& samples,
+                              const GenomicRegion& region,
+                              const ReadPrefilter& prefilter,
+                              SampleFilterCountMap& filter_counts) const;
     
 private:
     Path file_path_;
@@ -14,6 +14,7 @@
 
 #include "basics/genomic_region.hpp"
 #include "basics/aligned_read.hpp"
+#include "read_prefilter.hpp"
 
 namespace octopus { namespace io {
 
@@ -25,6 +26,8 @@ public:
     using SampleReadMap   = std::unordered_map<SampleName, ReadContainer>;
     using PositionList    = std::vector<GenomicRegion::Position>;
     
+    using SampleFilterCountMap = ReadPrefilter::SampleFilterCountMap;
+    
     virtual ~IReadReaderImpl() noexcept = default;
     
     virtual bool is_open() const noexcept = 0;
@@ -60,12 +63,25 @@ public:
                                       const GenomicRegion& region) const = 0;
     virtual SampleReadMap fetch_reads(const std::vector<SampleName>& samples,
                                       const GenomicRegion& region) const = 0;
+    // Reads rejected by prefilter are not returned, and are counted in filter_counts by clause name
+    virtual SampleReadMap fetch_reads(const std::vector<SampleName>& samples,
+                                      const GenomicRegion& region,
+                                      const ReadPrefilter& prefilter,
+                                      SampleFilterCountMap& filter_counts) const
+    {
+        return fetch_reads(samples, region);
+    }
     
     virtual std::vector<GenomicRegion::ContigName> reference_contigs() const = 0;
     virtual GenomicRegion::Size reference_size(const GenomicRegion::ContigName& contig) const = 0;
     
     virtual boost::optional<std::vector<GenomicRegion::ContigName>> mapped_contigs() const { return boost::none; };
     virtual boost::optional<std::vector<GenomicRegion>> mapped_regions() const { return boost::none; };
+    
+    // Approximate number of reads overlapping each consecutive window_size block of region, derived from the
+    // index alone. boost::none if the index cannot provide an estimate.
+    virtual boost::optional<std::vector<std::size_t>>
+    estimate_read_counts(const GenomicRegion& region, GenomicRegion::Size window_size) const { return boost::none; };
 };
 
 } // namespace io
@@ -0,0 +1,71 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "streaming_downsampler.hpp"
+
+#include <algorithm>
+
+namespace octopus { namespace io {
+
+StreamingDownsampler::StreamingDownsampler(const unsigned trigger_coverage, const unsigned target_coverage)
+: trigger_coverage_ {trigger_coverage}
+, target_coverage_ {std::min(target_coverage, trigger_coverage)}
+, seen_ends_ {}
+, kept_ends_ {}
+, group_begin_ {}
+, group_first_ {0}
+, group_size_ {0}
+, group_ends_ {}
+, num_discarded_ {0}
+, generator_ {}
+{}
+
+boost::optional<std::size_t> StreamingDownsampler::add(const Position begin, const Position end, const std::size_t num_stored)
+{
+    if (group_size_ == 0 || begin != group_begin_) {
+        start_group(begin, num_stored);
+    }
+    seen_ends_.push(end);
+    ++group_size_;
+    if (seen_ends_.size() <= trigger_coverage_) {
+        group_ends_.push_back(end);
+        return num_stored;
+    }
+    // Reads kept before this group still cover begin, so only the remaining target depth is available
+    const auto num_slots = std::max(target_coverage_ > kept_ends_.size() ? target_coverage_ - kept_ends_.size() : 0,
+                                    group_ends_.size());
+    if (group_ends_.size() < num_slots) {
+        group_ends_.push_back(end);
+        return num_stored;
+    }
+    ++num_discarded_;
+    if (group_ends_.empty()) return boost::none;
+    std::uniform_int_distribution<std::size_t> dist {0, group_size_ - 1};
+    const auto slot = dist(generator_);
+    if (slot < group_ends_.size()) {
+        group_ends_[slot] = end;
+        return group_first_ + slot;
+    }
+    return boost::none;
+}
+
+std::size_t StreamingDownsampler::num_discarded() const noexcept
+{
+    return num_discarded_;
+}
+
+// private methods
+
+void StreamingDownsampler::start_group(const Position begin, const std::size_t num_stored)
+{
+    for (auto end : group_ends_) kept_ends_.push(end);
+    group_ends_.clear();
+    while (!seen_ends_.empty() && seen_ends_.top() <= begin) seen_ends_.pop();
+    while (!kept_ends_.empty() && kept_ends_.top() <= begin) kept_ends_.pop();
+    group_begin_ = begin;
+    group_first_ = num_stored;
+    group_size_ = 0;
+}
+
+} // namespace io
+} // namespace octopus
@@ -0,0 +1,67 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef streaming_downsampler_hpp
+#define streaming_downsampler_hpp
+
+#include <vector>
+#include <queue>
+#include <functional>
+#include <random>
+#include <cstddef>
+
+#include <boost/optional.hpp>
+
+#include "basics/genomic_region.hpp"
+
+namespace octopus { namespace io {
+
+/*
+ StreamingDownsampler decides which reads of a single sample to keep as they are decoded, so reads at
+ positions that will be downsampled are never constructed.
+ 
+ Reads must be offered in order of begin position. Reads starting at the same position form a group;
+ while the true coverage (all offered reads) exceeds trigger_coverage, a group is reservoir sampled so the
+ coverage of kept reads is brought down to target_coverage. This mirrors readpipe::Downsampler, which can
+ still be applied afterwards.
+ */
+class StreamingDownsampler
+{
+public:
+    using Position = GenomicRegion::Position;
+    
+    StreamingDownsampler() = delete;
+    
+    StreamingDownsampler(unsigned trigger_coverage, unsigned target_coverage);
+    
+    StreamingDownsampler(const StreamingDownsampler&)            = default;
+    StreamingDownsampler& operator=(const StreamingDownsampler&) = default;
+    StreamingDownsampler(StreamingDownsampler&&)                 = default;
+    StreamingDownsampler& operator=(StreamingDownsampler&&)      = default;
+    
+    ~StreamingDownsampler() = default;
+    
+    // Returns the index the read should be stored at in a container of num_stored kept reads; num_stored to
+    // append, less than num_stored to replace a previously kept read, or boost::none to discard the read.
+    boost::optional<std::size_t> add(Position begin, Position end, std::size_t num_stored);
+    
+    std::size_t num_discarded() const noexcept;
+    
+private:
+    using EndQueue = std::priority_queue<Position, std::vector<Position>, std::greater<>>;
+    
+    unsigned trigger_coverage_, target_coverage_;
+    EndQueue seen_ends_, kept_ends_;
+    Position group_begin_;
+    std::size_t group_first_, group_size_;
+    std::vector<Position> group_ends_;
+    std::size_t num_discarded_;
+    std::default_random_engine generator_;
+    
+    void start_group(Position begin, std::size_t num_stored);
+};
+
+} // namespace io
+} // namespace octopus
+
+#endif
@@ -64,6 +64,50 @@ public:
     MalformedFastaIndex(Fasta::Path file) : MalformedFileError {std::move(file), "fasta"} {}
 };
 
+namespace {
+
+bool is_valid_fasta(const Fasta::Path& fasta_path) noexcept
+{
+    const auto extension = fasta_path.extension().string();
+    if (extension != ".fa" && extension != ".fasta") {
+        return false;
+    }
+    return true; // TODO: could actually check valid fasta format
+}
+
+bool is_valid_fasta_index(const Fasta::Path& fasta_index_path) noexcept
+{
+    const auto extension = fasta_index_path.extension().string();
+    if (extension != ".fai") {
+        return false;
+    }
+    return true; // TODO: could actually check valid fasta format
+}
+
+} // namespace
+
+Fasta::Path resolve_fasta_index_path(const Fasta::Path& fasta_path, Fasta::Path fasta_index_path)
+{
+    using boost::filesystem::exists;
+    if (!exists(fasta_path)) {
+        throw MissingFasta {fasta_path};
+    }
+    if (!is_valid_fasta(fasta_path)) {
+        throw MalformedFasta {fasta_path};
+    }
+    if (!exists(fasta_index_path)) {
+        fasta_index_path = fasta_path;
+        fasta_index_path.replace_extension("fai");
+        if (!exists(fasta_index_path)) {
+            throw MissingFastaIndex {fasta_path};
+        }
+    }
+    if (!is_valid_fasta_index(fasta_index_path)) {
+        throw MalformedFastaIndex {fasta_index_path};
+    }
+    return fasta_index_path;
+}
+
 Fasta::Fasta(Path fasta_path)
 : Fasta {fasta_path, fasta_path.string() + ".fai", Options {}}
 {}
@@ -78,26 +122,9 @@ Fasta::Fasta(Path fasta_path, Path fasta_index_path)
 
 Fasta::Fasta(Path fasta_path, Path fasta_index_path, Options options)
 : path_ {std::move(fasta_path)}
-, index_path_ {std::move(fasta_index_path)}
+, index_path_ {resolve_fasta_index_path(path_, std::move(fasta_index_path))}
 , options_ {options}
 {
-    using boost::filesystem::exists;
-    if (!exists(path_)) {
-        throw MissingFasta {path_};
-    }
-    if (!is_valid_fasta()) {
-        throw MalformedFasta {path_};
-    }
-    if (!exists(index_path_)) {
-        index_path_ = path_;
-        index_path_.replace_extension("fai");
-        if (!exists(index_path_)) {
-            throw MissingFastaIndex {path_};
-        }
-    }
-    if (!is_valid_fasta_index()) {
-        throw MalformedFastaIndex {index_path_};
-    }
     fasta_       = std::ifstream(path_.string());
     fasta_index_ = bioio::read_fasta_index(index_path_.string());
 }
@@ -153,25 +180,25 @@ Fasta::GenomicSize Fasta::do_fetch_contig_size(const ContigName& contig) const
     return static_cast<GenomicSize>(fasta_index_.at(contig).length);
 }
 
-class BadReferenceRequestRegion : public ProgramError
+BadReferenceRequestRegion::BadReferenceRequestRegion(GenomicRegion region, std::string where)
+: region_ {std::move(region)}
+, where_ {std::move(where)}
+{}
+
+std::string BadReferenceRequestRegion::do_why() const
+{
+    return "Requested bad reference region " + to_string(region_);
+}
+
+std::string BadReferenceRequestRegion::do_help() const
 {
-    GenomicRegion region;
-    
-    std::string do_why() const override
-    {
-        return "Requested bad reference region " + to_string(region);
-    }
-    std::string do_help() const override
-    {
-        return "Send a debug report";
-    }
-    std::string do_where() const override
-    {
-        return "Fasta";
-    }
-public:
-    BadReferenceRequestRegion(GenomicRegion region) : region {std::move(region)} {}
-};
+    return "Send a debug report";
+}
+
+std::string BadReferenceRequestRegion::do_where() const
+{
+    return where_;
+}
 
 Fasta::GeneticSequence Fasta::do_fetch_sequence(const GenomicRegion& region) const
 {
@@ -199,24 +226,6 @@ Fasta::GeneticSequence Fasta::do_fetch_sequence(const GenomicRegion& region) con
     }
 }
 
-bool Fasta::is_valid_fasta() const noexcept
-{
-    const auto extension = path_.extension().string();
-    if (extension != ".fa" && extension != ".fasta") {
-        return false;
-    }
-    return true; // TODO: could actually check valid fasta format
-}
-
-bool Fasta::is_valid_fasta_index() const noexcept
-{
-    const auto extension = index_path_.extension().string();
-    if (extension != ".fai") {
-        return false;
-    }
-    return true; // TODO: could actually check valid fasta format
-}
-
 bool Fasta::is_capitalisation_requested() const noexcept
 {
     return options_.base_transform_policy == Options::BaseTransformPolicy::capitalise;
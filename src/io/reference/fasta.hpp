@@ -14,13 +14,11 @@
 
 #include "bioio.hpp"
 
+#include "basics/genomic_region.hpp"
+#include "exceptions/program_error.hpp"
 #include "reference_reader.hpp"
 
-namespace octopus {
-
-class GenomicRegion;
-
-namespace io {
+namespace octopus { namespace io {
 
 class Fasta : public ReferenceReader
 {
@@ -67,11 +65,26 @@ private:
     GenomicSize do_fetch_contig_size(const ContigName& contig) const override;
     GeneticSequence do_fetch_sequence(const GenomicRegion& region) const override;
     
-    bool is_valid_fasta() const noexcept;
-    bool is_valid_fasta_index() const noexcept;
     bool is_capitalisation_requested() const noexcept;
 };
 
+// Throws if the fasta or its index are missing or malformed. Returns the index path to use, which is the
+// fasta path with a .fai extension if the given index path does not exist.
+Fasta::Path resolve_fasta_index_path(const Fasta::Path& fasta_path, Fasta::Path fasta_index_path);
+
+// Thrown by FASTA readers when a region outside a contig is requested with BaseFillPolicy::throw_exception
+class BadReferenceRequestRegion : public ProgramError
+{
+    GenomicRegion region_;
+    std::string where_;
+    
+    std::string do_why() const override;
+    std::string do_help() const override;
+    std::string do_where() const override;
+public:
+    BadReferenceRequestRegion(GenomicRegion region, std::string where = "Fasta");
+};
+
 } // namespace io
 } // namespace octopus
 
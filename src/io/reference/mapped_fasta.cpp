@@ -0,0 +1,102 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "mapped_fasta.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "basics/genomic_region.hpp"
+#include "utils/sequence_utils.hpp"
+
+namespace octopus { namespace io {
+
+MappedFasta::MappedFasta(Path fasta_path)
+: MappedFasta {fasta_path, fasta_path.string() + ".fai", Options {}}
+{}
+
+MappedFasta::MappedFasta(Path fasta_path, Options options)
+: MappedFasta {fasta_path, fasta_path.string() + ".fai", options}
+{}
+
+MappedFasta::MappedFasta(Path fasta_path, Path fasta_index_path)
+: MappedFasta {std::move(fasta_path), std::move(fasta_index_path), Options {}}
+{}
+
+MappedFasta::MappedFasta(Path fasta_path, Path fasta_index_path, Options options)
+: path_ {std::move(fasta_path)}
+, index_path_ {resolve_fasta_index_path(path_, std::move(fasta_index_path))}
+, fasta_ {path_.string()}
+, fasta_index_ {std::make_shared<bioio::FastaIndex>(bioio::read_fasta_index(index_path_.string()))}
+, options_ {options}
+{}
+
+// virtual private methods
+
+std::unique_ptr<ReferenceReader> MappedFasta::do_clone() const
+{
+    return std::make_unique<MappedFasta>(*this);
+}
+
+bool MappedFasta::do_is_open() const noexcept
+{
+    return fasta_.is_open();
+}
+
+std::string MappedFasta::do_fetch_reference_name() const
+{
+    return path_.stem().string();
+}
+
+std::vector<MappedFasta::ContigName> MappedFasta::do_fetch_contig_names() const
+{
+    return bioio::read_fasta_index_contig_names(index_path_.string());
+}
+
+MappedFasta::GenomicSize MappedFasta::do_fetch_contig_size(const ContigName& contig) const
+{
+    return static_cast<GenomicSize>(contig_index(contig).length);
+}
+
+MappedFasta::GeneticSequence MappedFasta::do_fetch_sequence(const GenomicRegion& region) const
+{
+    const auto& index = contig_index(contig_name(region));
+    const std::size_t end {std::min(static_cast<std::size_t>(mapped_end(region)), index.length)};
+    std::size_t position {std::min(static_cast<std::size_t>(mapped_begin(region)), end)};
+    GeneticSequence result {};
+    result.reserve(size(region));
+    while (position < end) {
+        // Copy the rest of the line containing position, skipping the line terminator
+        const auto line_offset = position % index.line_length;
+        const auto file_offset = index.offset + (position / index.line_length) * index.line_byte_length + line_offset;
+        if (file_offset >= fasta_.size()) break; // truncated file
+        const auto num_bases = std::min({index.line_length - line_offset, end - position, fasta_.size() - file_offset});
+        result.append(fasta_.data() + file_offset, num_bases);
+        position += num_bases;
+    }
+    if (is_capitalisation_requested()) {
+        utils::capitalise(result);
+    }
+    if (result.size() < size(region) && options_.base_fill_policy != Options::BaseFillPolicy::ignore) {
+        if (options_.base_fill_policy == Options::BaseFillPolicy::throw_exception) {
+            throw BadReferenceRequestRegion {region, "MappedFasta"};
+        }
+        result.resize(size(region), 'N');
+    }
+    return result;
+}
+
+// private methods
+
+const bioio::FastaContigIndex& MappedFasta::contig_index(const ContigName& contig) const
+{
+    return fasta_index_->at(contig);
+}
+
+bool MappedFasta::is_capitalisation_requested() const noexcept
+{
+    return options_.base_transform_policy == Options::BaseTransformPolicy::capitalise;
+}
+
+} // namespace io
+} // namespace octopus
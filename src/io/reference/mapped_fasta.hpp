@@ -0,0 +1,75 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef mapped_fasta_hpp
+#define mapped_fasta_hpp
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "bioio.hpp"
+
+#include "reference_reader.hpp"
+#include "fasta.hpp"
+
+namespace octopus {
+
+class GenomicRegion;
+
+namespace io {
+
+/*
+ MappedFasta reads an indexed FASTA file through a read-only memory map. Sequence is located with the
+ .fai line offsets and copied straight out of the mapping, so fetches make no system calls and hold no
+ locks; any number of threads can fetch concurrently, and clones share the same mapping.
+ */
+class MappedFasta : public ReferenceReader
+{
+public:
+    using Path    = Fasta::Path;
+    using Options = Fasta::Options;
+
+    using ContigName      = ReferenceReader::ContigName;
+    using GenomicSize     = ReferenceReader::GenomicSize;
+    using GeneticSequence = ReferenceReader::GeneticSequence;
+
+    MappedFasta() = delete;
+
+    MappedFasta(Path fasta_path);
+    MappedFasta(Path fasta_path, Options options);
+    MappedFasta(Path fasta_path, Path fasta_index_path);
+    MappedFasta(Path fasta_path, Path fasta_index_path, Options options);
+
+    MappedFasta(const MappedFasta&)            = default;
+    MappedFasta& operator=(const MappedFasta&) = default;
+    MappedFasta(MappedFasta&&)                 = default;
+    MappedFasta& operator=(MappedFasta&&)      = default;
+
+private:
+    Path path_;
+    Path index_path_;
+
+    boost::iostreams::mapped_file_source fasta_;
+    std::shared_ptr<const bioio::FastaIndex> fasta_index_;
+
+    Options options_;
+
+    std::unique_ptr<ReferenceReader> do_clone() const override;
+    bool do_is_open() const noexcept override;
+    std::string do_fetch_reference_name() const override;
+    std::vector<ContigName> do_fetch_contig_names() const override;
+    GenomicSize do_fetch_contig_size(const ContigName& contig) const override;
+    GeneticSequence do_fetch_sequence(const GenomicRegion& region) const override;
+
+    const bioio::FastaContigIndex& contig_index(const ContigName& contig) const;
+    bool is_capitalisation_requested() const noexcept;
+};
+
+} // namespace io
+} // namespace octopus
+
+#endif
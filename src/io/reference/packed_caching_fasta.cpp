@@ -0,0 +1,229 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "packed_caching_fasta.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <cassert>
+
+#include "basics/genomic_region.hpp"
+#include "packed_sequence.hpp"
+
+namespace octopus { namespace io {
+
+namespace {
+
+constexpr std::uint32_t blockSize {16'384}; // bases, 4KB packed
+constexpr std::size_t maxNumShards {64};
+
+auto estimate_block_footprint() noexcept
+{
+    return blockSize / 4 + 256; // packed bases plus a few runs and bookkeeping
+}
+
+auto calculate_num_shards(const std::size_t max_cache_bytes) noexcept
+{
+    // Each shard should have room for a reasonable number of blocks
+    const auto num_shards = max_cache_bytes / (16 * estimate_block_footprint());
+    return std::max(std::min(num_shards, maxNumShards), std::size_t {1});
+}
+
+auto make_key(const std::uint32_t contig_id, const std::uint32_t block_index) noexcept
+{
+    return (static_cast<std::uint64_t>(contig_id) << 32) | block_index;
+}
+
+} // namespace
+
+PackedCachingFasta::PackedCachingFasta(std::unique_ptr<ReferenceReader> fasta, const std::size_t max_cache_bytes)
+: fasta_ {std::move(fasta)}
+, contigs_ {}
+, max_cache_bytes_ {max_cache_bytes}
+, max_shard_bytes_ {}
+, shards_ {}
+{
+    setup_cache();
+}
+
+PackedCachingFasta::PackedCachingFasta(const PackedCachingFasta& other)
+: fasta_ {other.fasta_->clone()}
+, contigs_ {other.contigs_}
+, max_cache_bytes_ {other.max_cache_bytes_}
+, max_shard_bytes_ {}
+, shards_ {}
+{
+    setup_cache();
+}
+
+PackedCachingFasta& PackedCachingFasta::operator=(PackedCachingFasta other)
+{
+    using std::swap;
+    swap(fasta_, other.fasta_);
+    swap(contigs_, other.contigs_);
+    swap(max_cache_bytes_, other.max_cache_bytes_);
+    swap(max_shard_bytes_, other.max_shard_bytes_);
+    swap(shards_, other.shards_);
+    return *this;
+}
+
+// virtual private methods
+
+std::unique_ptr<ReferenceReader> PackedCachingFasta::do_clone() const
+{
+    return std::make_unique<PackedCachingFasta>(*this);
+}
+
+bool PackedCachingFasta::do_is_open() const noexcept
+{
+    return fasta_->is_open();
+}
+
+std::string PackedCachingFasta::do_fetch_reference_name() const
+{
+    return fasta_->fetch_reference_name();
+}
+
+std::vector<PackedCachingFasta::ContigName> PackedCachingFasta::do_fetch_contig_names() const
+{
+    return fasta_->fetch_contig_names();
+}
+
+PackedCachingFasta::GenomicSize PackedCachingFasta::do_fetch_contig_size(const ContigName& contig) const
+{
+    return contigs_.at(contig).size;
+}
+
+PackedCachingFasta::GeneticSequence PackedCachingFasta::do_fetch_sequence(const GenomicRegion& region) const
+{
+    if (is_empty(region)) return {};
+    const auto& contig = contigs_.at(region.contig_name());
+    if (region.begin() >= contig.size || size(region) / 4 > max_cache_bytes_ / 2) {
+        return fasta_->fetch_sequence(region);
+    }
+    const auto end = std::min(region.end(), contig.size);
+    GeneticSequence result {};
+    result.reserve(size(region));
+    for (auto block_index = region.begin() / blockSize; block_index * blockSize < end; ++block_index) {
+        const auto block = get_block(region.contig_name(), contig, block_index);
+        const auto block_begin = block_index * blockSize;
+        const auto first = std::max(region.begin(), block_begin) - block_begin;
+        const auto last  = std::min<GenomicSize>(end - block_begin, block->size);
+        if (first >= last) break; // the reader returned less sequence than the contig size
+        unpack(*block, first, last, result);
+        if (block->size < blockSize && last < end - block_begin) break;
+    }
+    if (result.size() < size(region)) {
+        // Let the reader apply its own policy for requests beyond the sequence
+        const auto tail_begin = region.begin() + static_cast<GenomicSize>(result.size());
+        result += fasta_->fetch_sequence(GenomicRegion {region.contig_name(), tail_begin, region.end()});
+    }
+    return result;
+}
+
+// non-virtual private methods
+
+void PackedCachingFasta::setup_cache()
+{
+    if (contigs_.empty()) {
+        const auto contig_names = fasta_->fetch_contig_names();
+        contigs_.reserve(contig_names.size());
+        for (const auto& contig_name : contig_names) {
+            const auto id = static_cast<std::uint32_t>(contigs_.size());
+            contigs_.emplace(contig_name, Contig {id, fasta_->fetch_contig_size(contig_name)});
+        }
+    }
+    const auto num_shards = calculate_num_shards(max_cache_bytes_);
+    max_shard_bytes_ = max_cache_bytes_ / num_shards;
+    shards_.clear();
+    shards_.reserve(num_shards);
+    std::generate_n(std::back_inserter(shards_), num_shards, [] () { return std::make_unique<Shard>(); });
+}
+
+std::shared_ptr<const PackedCachingFasta::Block>
+PackedCachingFasta::get_block(const ContigName& contig_name, const Contig& contig, const std::uint32_t block_index) const
+{
+    const auto key = make_key(contig.id, block_index);
+    auto& shard = *shards_[((key * 0x9E3779B97F4A7C15) >> 32) % shards_.size()];
+    auto result = find_block(shard, key);
+    if (!result) {
+        const GenomicSize block_begin {block_index * blockSize};
+        const GenomicRegion block_region {contig_name, block_begin, std::min(block_begin + blockSize, contig.size)};
+        result = insert_block(shard, key, std::make_shared<Block>(pack(fasta_->fetch_sequence(block_region))));
+    }
+    return result;
+}
+
+std::shared_ptr<const PackedCachingFasta::Block>
+PackedCachingFasta::find_block(Shard& shard, const BlockKey key) const
+{
+    std::lock_guard<std::mutex> lock {shard.mutex};
+    const auto itr = shard.blocks.find(key);
+    if (itr == std::end(shard.blocks)) return nullptr;
+    itr->second.referenced = true;
+    return itr->second.block;
+}
+
+std::shared_ptr<const PackedCachingFasta::Block>
+PackedCachingFasta::insert_block(Shard& shard, const BlockKey key, std::shared_ptr<const Block> block) const
+{
+    const auto block_footprint = footprint(*block);
+    std::lock_guard<std::mutex> lock {shard.mutex};
+    const auto p = shard.blocks.emplace(key, CacheEntry {std::move(block), block_footprint, false});
+    if (p.second) {
+        // Another thread may have inserted the block while we were fetching it, in which case that is used
+        shard.clock.push_back(key);
+        shard.footprint += block_footprint;
+        evict(shard, key);
+    }
+    return p.first->second.block;
+}
+
+void PackedCachingFasta::evict(Shard& shard, const BlockKey keep) const
+{
+    while (shard.footprint > max_shard_bytes_ && shard.clock.size() > 1) {
+        if (shard.clock_hand >= shard.clock.size()) shard.clock_hand = 0;
+        const auto key = shard.clock[shard.clock_hand];
+        auto& entry = shard.blocks.at(key);
+        if (key == keep || entry.referenced) {
+            entry.referenced = false;
+            ++shard.clock_hand;
+        } else {
+            shard.footprint -= entry.footprint;
+            shard.blocks.erase(key);
+            shard.clock[shard.clock_hand] = shard.clock.back();
+            shard.clock.pop_back();
+        }
+    }
+}
+
+PackedCachingFasta::Block PackedCachingFasta::pack(const GeneticSequence& sequence)
+{
+    assert(sequence.size() <= blockSize);
+    Block result {static_cast<std::uint32_t>(sequence.size()), {}, {}, {}};
+    io::pack(sequence, 0, result.packed_bases, result.ambiguous_runs, result.lower_case_runs);
+    result.ambiguous_runs.shrink_to_fit();
+    result.lower_case_runs.shrink_to_fit();
+    return result;
+}
+
+void PackedCachingFasta::unpack(const Block& block, const std::uint32_t first, const std::uint32_t last,
+                                GeneticSequence& result)
+{
+    assert(first <= last && last <= block.size);
+    const PackedSequenceView view {block.packed_bases.data(),
+                                   block.ambiguous_runs.data(), block.ambiguous_runs.size(),
+                                   block.lower_case_runs.data(), block.lower_case_runs.size()};
+    io::unpack(view, first, last, result);
+}
+
+std::size_t PackedCachingFasta::footprint(const Block& block) noexcept
+{
+    return sizeof(Block) + sizeof(CacheEntry) + sizeof(BlockKey)
+           + block.packed_bases.capacity() * sizeof(std::uint8_t)
+           + (block.ambiguous_runs.capacity() + block.lower_case_runs.capacity()) * sizeof(PackedBaseRun);
+}
+
+} // namespace io
+} // namespace octopus
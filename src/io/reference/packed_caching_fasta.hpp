@@ -0,0 +1,106 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef packed_caching_fasta_hpp
+#define packed_caching_fasta_hpp
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <memory>
+
+#include "reference_reader.hpp"
+#include "packed_sequence.hpp"
+
+namespace octopus {
+
+class GenomicRegion;
+
+namespace io {
+
+/*
+ PackedCachingFasta caches reference sequence in fixed size blocks of 2-bit packed bases. Bases other than
+ ACGT, and runs of lower case (soft masked) bases, are kept in small side tables of runs, so a block of
+ ordinary sequence costs about a quarter of a byte per base.
+
+ Blocks are spread over independently locked shards, each evicting with the CLOCK (second chance) policy.
+ A shard lock is only held to look up or insert a block pointer; decoding and fetching missed blocks
+ from the underlying reader happen outside the lock, so concurrent fetches rarely contend.
+ */
+class PackedCachingFasta : public ReferenceReader
+{
+public:
+    using ContigName      = ReferenceReader::ContigName;
+    using GenomicSize     = ReferenceReader::GenomicSize;
+    using GeneticSequence = ReferenceReader::GeneticSequence;
+
+    PackedCachingFasta() = delete;
+
+    // The underlying reader must be thread-safe if the cache is to be used by multiple threads
+    PackedCachingFasta(std::unique_ptr<ReferenceReader> fasta, std::size_t max_cache_bytes);
+
+    PackedCachingFasta(const PackedCachingFasta&);
+    PackedCachingFasta& operator=(PackedCachingFasta);
+    PackedCachingFasta(PackedCachingFasta&&)            = default;
+    PackedCachingFasta& operator=(PackedCachingFasta&&) = default;
+
+    ~PackedCachingFasta() = default;
+
+private:
+    struct Block
+    {
+        std::uint32_t size;
+        std::vector<std::uint8_t> packed_bases;
+        std::vector<PackedBaseRun> ambiguous_runs, lower_case_runs;
+    };
+    struct CacheEntry
+    {
+        std::shared_ptr<const Block> block;
+        std::size_t footprint;
+        bool referenced;
+    };
+    using BlockKey = std::uint64_t;
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<BlockKey, CacheEntry> blocks;
+        std::vector<BlockKey> clock;
+        std::size_t clock_hand = 0, footprint = 0;
+    };
+    struct Contig
+    {
+        std::uint32_t id;
+        GenomicSize size;
+    };
+
+    std::unique_ptr<ReferenceReader> fasta_;
+    std::unordered_map<ContigName, Contig> contigs_;
+    std::size_t max_cache_bytes_, max_shard_bytes_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::unique_ptr<ReferenceReader> do_clone() const override;
+    bool do_is_open() const noexcept override;
+    std::string do_fetch_reference_name() const override;
+    std::vector<ContigName> do_fetch_contig_names() const override;
+    GenomicSize do_fetch_contig_size(const ContigName& contig) const override;
+    GeneticSequence do_fetch_sequence(const GenomicRegion& region) const override;
+
+    void setup_cache();
+    std::shared_ptr<const Block> get_block(const ContigName& contig_name, const Contig& contig,
+                                           std::uint32_t block_index) const;
+    std::shared_ptr<const Block> find_block(Shard& shard, BlockKey key) const;
+    std::shared_ptr<const Block> insert_block(Shard& shard, BlockKey key, std::shared_ptr<const Block> block) const;
+    void evict(Shard& shard, BlockKey keep) const;
+
+    static Block pack(const GeneticSequence& sequence);
+    static void unpack(const Block& block, std::uint32_t first, std::uint32_t last, GeneticSequence& result);
+    static std::size_t footprint(const Block& block) noexcept;
+};
+
+} // namespace io
+} // namespace octopus
+
+#endif
@@ -0,0 +1,312 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "packed_reference.hpp"
+
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+
+#include <boost/filesystem/operations.hpp>
+
+#include "basics/genomic_region.hpp"
+#include "utils/sequence_utils.hpp"
+#include "exceptions/malformed_file_error.hpp"
+#include "exceptions/unwritable_file_error.hpp"
+#include "reference_genome.hpp"
+#include "packed_sequence.hpp"
+
+namespace octopus { namespace io {
+
+/*
+ File layout (integers are in native byte order, so files are not portable between platforms of different
+ endianness; sections are 8-byte aligned):
+
+ Header
+ ContigEntry[num_contigs]
+ reference name
+ for each contig: contig name, packed bases, PackedBaseRun[] ambiguous runs, PackedBaseRun[] lower case runs
+ */
+
+namespace {
+
+constexpr char packed_magic[8] {'O', 'C', 'T', 'O', 'P', 'R', 'E', 'F'};
+constexpr std::uint32_t packed_version {1};
+constexpr GenomicRegion::Size build_chunk_size {10'000'000};
+
+} // namespace
+
+struct PackedReference::Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t num_contigs;
+    std::uint64_t name_offset, name_length;
+};
+
+struct PackedReference::ContigEntry
+{
+    std::uint64_t name_offset, name_length;
+    std::uint64_t size;
+    std::uint64_t bases_offset;
+    std::uint64_t ambiguous_runs_offset, num_ambiguous_runs;
+    std::uint64_t lower_case_runs_offset, num_lower_case_runs;
+};
+
+class MalformedPackedReference : public MalformedFileError
+{
+    std::string do_where() const override
+    {
+        return "PackedReference";
+    }
+
+    std::string do_help() const override
+    {
+        return "rebuild the packed reference with the --pack-reference command line option";
+    }
+public:
+    MalformedPackedReference(PackedReference::Path file, std::string reason)
+    : MalformedFileError {std::move(file), "octopus packed reference"}
+    {
+        set_reason(std::move(reason));
+    }
+};
+
+class UnwritablePackedReference : public UnwritableFileError
+{
+    std::string do_where() const override
+    {
+        return "PackedReference";
+    }
+public:
+    UnwritablePackedReference(PackedReference::Path file)
+    : UnwritableFileError {std::move(file), "octopus packed reference"}
+    {}
+};
+
+PackedReference::PackedReference(Path packed_reference_path)
+: PackedReference {std::move(packed_reference_path), Options {}}
+{}
+
+PackedReference::PackedReference(Path packed_reference_path, Options options)
+: path_ {std::move(packed_reference_path)}
+, file_ {path_.string()}
+, header_ {nullptr}
+, contigs_ {}
+, options_ {options}
+{
+    if (file_.size() < sizeof(Header)) {
+        throw MalformedPackedReference {path_, "the file is truncated"};
+    }
+    header_ = at<Header>(0);
+    if (std::memcmp(header_->magic, packed_magic, sizeof(packed_magic)) != 0) {
+        throw MalformedPackedReference {path_, "the file is not a packed reference"};
+    }
+    if (header_->version != packed_version) {
+        throw MalformedPackedReference {path_, "the packed reference version is not supported"};
+    }
+    const auto contigs_end = sizeof(Header) + header_->num_contigs * sizeof(ContigEntry);
+    if (file_.size() < contigs_end || file_.size() < header_->name_offset + header_->name_length) {
+        throw MalformedPackedReference {path_, "the file is truncated"};
+    }
+    auto contigs = std::make_shared<std::unordered_map<ContigName, const ContigEntry*>>();
+    contigs->reserve(header_->num_contigs);
+    for (std::uint32_t i {0}; i < header_->num_contigs; ++i) {
+        const auto contig = at<ContigEntry>(sizeof(Header) + i * sizeof(ContigEntry));
+        const auto sections_end = std::max({contig->name_offset + contig->name_length,
+                                            contig->bases_offset + (contig->size + 3) / 4,
+                                            contig->ambiguous_runs_offset + contig->num_ambiguous_runs * sizeof(PackedBaseRun),
+                                            contig->lower_case_runs_offset + contig->num_lower_case_runs * sizeof(PackedBaseRun)});
+        if (sections_end > file_.size()) {
+            throw MalformedPackedReference {path_, "the file is truncated"};
+        }
+        contigs->emplace(ContigName {at<char>(contig->name_offset), contig->name_length}, contig);
+    }
+    contigs_ = std::move(contigs);
+}
+
+PackedReference::Path PackedReference::default_path(const Path& reference_path)
+{
+    return reference_path.string() + ".opr";
+}
+
+bool PackedReference::is_up_to_date(const Path& packed_reference_path, const Path& reference_path)
+{
+    namespace fs = boost::filesystem;
+    boost::system::error_code ec {};
+    if (!fs::exists(packed_reference_path, ec)) return false;
+    const auto packed_write_time = fs::last_write_time(packed_reference_path, ec);
+    if (ec) return false;
+    const auto reference_write_time = fs::last_write_time(reference_path, ec);
+    return !ec && packed_write_time >= reference_write_time;
+}
+
+namespace {
+
+template <typename T>
+void write(std::ostream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void write(std::ostream& out, const std::vector<T>& values)
+{
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+void pad(std::ostream& out)
+{
+    static constexpr char zeros[8] {};
+    const auto remainder = static_cast<std::size_t>(out.tellp()) % sizeof(zeros);
+    if (remainder > 0) out.write(zeros, sizeof(zeros) - remainder);
+}
+
+} // namespace
+
+void PackedReference::build(const ReferenceGenome& reference, const Path& packed_reference_path)
+{
+    namespace fs = boost::filesystem;
+    const auto contigs = reference.contig_names();
+    for (const auto& contig : contigs) {
+        if (reference.contig_size(contig) > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::invalid_argument {"PackedReference: contig " + contig + " is too large to pack"};
+        }
+    }
+    // Write to a temporary file first so an interrupted build never leaves a truncated file that looks up to date
+    const Path temp_path {packed_reference_path.string() + ".tmp"};
+    try {
+        std::ofstream out {temp_path.string(), std::ios::binary | std::ios::trunc};
+        if (!out) throw UnwritablePackedReference {temp_path};
+        Header header {};
+        std::copy(std::cbegin(packed_magic), std::cend(packed_magic), header.magic);
+        header.version = packed_version;
+        header.num_contigs = static_cast<std::uint32_t>(contigs.size());
+        write(out, header); // placeholder
+        std::vector<ContigEntry> entries(contigs.size());
+        for (const auto& entry : entries) write(out, entry); // placeholders
+        const auto& reference_name = reference.name();
+        header.name_offset = out.tellp();
+        header.name_length = reference_name.size();
+        out.write(reference_name.data(), reference_name.size());
+        for (std::size_t i {0}; i < contigs.size(); ++i) {
+            const auto& contig = contigs[i];
+            const auto contig_size = reference.contig_size(contig);
+            auto& entry = entries[i];
+            entry.size = contig_size;
+            entry.name_offset = out.tellp();
+            entry.name_length = contig.size();
+            out.write(contig.data(), contig.size());
+            std::vector<std::uint8_t> packed_bases {};
+            packed_bases.reserve((contig_size + 3) / 4);
+            std::vector<PackedBaseRun> ambiguous_runs {}, lower_case_runs {};
+            for (GenomicRegion::Position chunk_begin {0}; chunk_begin < contig_size; chunk_begin += build_chunk_size) {
+                const GenomicRegion chunk {contig, chunk_begin, std::min(chunk_begin + build_chunk_size, contig_size)};
+                pack(reference.fetch_sequence(chunk), chunk_begin, packed_bases, ambiguous_runs, lower_case_runs);
+            }
+            pad(out);
+            entry.bases_offset = out.tellp();
+            write(out, packed_bases);
+            pad(out);
+            entry.ambiguous_runs_offset = out.tellp();
+            entry.num_ambiguous_runs = ambiguous_runs.size();
+            write(out, ambiguous_runs);
+            pad(out);
+            entry.lower_case_runs_offset = out.tellp();
+            entry.num_lower_case_runs = lower_case_runs.size();
+            write(out, lower_case_runs);
+        }
+        pad(out);
+        out.seekp(0);
+        write(out, header);
+        for (const auto& entry : entries) write(out, entry);
+        out.close();
+        if (!out) throw UnwritablePackedReference {temp_path};
+        fs::rename(temp_path, packed_reference_path);
+    } catch (...) {
+        boost::system::error_code ec {};
+        fs::remove(temp_path, ec);
+        throw;
+    }
+}
+
+// virtual private methods
+
+std::unique_ptr<ReferenceReader> PackedReference::do_clone() const
+{
+    return std::make_unique<PackedReference>(*this);
+}
+
+bool PackedReference::do_is_open() const noexcept
+{
+    return file_.is_open();
+}
+
+std::string PackedReference::do_fetch_reference_name() const
+{
+    return {at<char>(header_->name_offset), header_->name_length};
+}
+
+std::vector<PackedReference::ContigName> PackedReference::do_fetch_contig_names() const
+{
+    std::vector<ContigName> result {};
+    result.reserve(header_->num_contigs);
+    for (std::uint32_t i {0}; i < header_->num_contigs; ++i) {
+        const auto contig = at<ContigEntry>(sizeof(Header) + i * sizeof(ContigEntry));
+        result.emplace_back(at<char>(contig->name_offset), contig->name_length);
+    }
+    return result;
+}
+
+PackedReference::GenomicSize PackedReference::do_fetch_contig_size(const ContigName& contig) const
+{
+    return static_cast<GenomicSize>(contig_entry(contig).size);
+}
+
+PackedReference::GeneticSequence PackedReference::do_fetch_sequence(const GenomicRegion& region) const
+{
+    const auto& contig = contig_entry(contig_name(region));
+    const auto end = static_cast<std::uint32_t>(std::min(std::uint64_t {mapped_end(region)}, contig.size));
+    const auto begin = std::min(static_cast<std::uint32_t>(mapped_begin(region)), end);
+    const PackedSequenceView sequence {at<std::uint8_t>(contig.bases_offset),
+                                       at<PackedBaseRun>(contig.ambiguous_runs_offset), contig.num_ambiguous_runs,
+                                       at<PackedBaseRun>(contig.lower_case_runs_offset), contig.num_lower_case_runs};
+    GeneticSequence result {};
+    result.reserve(size(region));
+    unpack(sequence, begin, end, result);
+    if (is_capitalisation_requested()) {
+        utils::capitalise(result);
+    }
+    if (result.size() < size(region) && options_.base_fill_policy != Options::BaseFillPolicy::ignore) {
+        if (options_.base_fill_policy == Options::BaseFillPolicy::throw_exception) {
+            throw BadReferenceRequestRegion {region, "PackedReference"};
+        }
+        result.resize(size(region), 'N');
+    }
+    return result;
+}
+
+// private methods
+
+template <typename T>
+const T* PackedReference::at(const std::uint64_t offset) const noexcept
+{
+    return reinterpret_cast<const T*>(file_.data() + offset);
+}
+
+const PackedReference::ContigEntry& PackedReference::contig_entry(const ContigName& contig) const
+{
+    return *contigs_->at(contig);
+}
+
+bool PackedReference::is_capitalisation_requested() const noexcept
+{
+    return options_.base_transform_policy == Options::BaseTransformPolicy::capitalise;
+}
+
+} // namespace io
+} // namespace octopus
@@ -0,0 +1,88 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef packed_reference_hpp
+#define packed_reference_hpp
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "reference_reader.hpp"
+#include "fasta.hpp"
+
+namespace octopus {
+
+class GenomicRegion;
+class ReferenceGenome;
+
+namespace io {
+
+/*
+ PackedReference reads a binary copy of a reference genome written by build: a contig table followed by
+ each contig's 2-bit packed bases and its tables of ambiguous and lower case base runs (see packed_sequence.hpp).
+
+ The file is memory-mapped and the contig table is read in place, so opening the reference costs the same
+ whatever the genome size, and fetches only touch the pages covering the requested region. Fetches hold no
+ locks, and clones share the same mapping.
+
+ The file is conventionally stored next to the FASTA it was built from (see default_path).
+ */
+class PackedReference : public ReferenceReader
+{
+public:
+    using Path    = Fasta::Path;
+    using Options = Fasta::Options;
+
+    using ContigName      = ReferenceReader::ContigName;
+    using GenomicSize     = ReferenceReader::GenomicSize;
+    using GeneticSequence = ReferenceReader::GeneticSequence;
+
+    PackedReference() = delete;
+
+    PackedReference(Path packed_reference_path);
+    PackedReference(Path packed_reference_path, Options options);
+
+    PackedReference(const PackedReference&)            = default;
+    PackedReference& operator=(const PackedReference&) = default;
+    PackedReference(PackedReference&&)                 = default;
+    PackedReference& operator=(PackedReference&&)      = default;
+
+    ~PackedReference() = default;
+
+    static Path default_path(const Path& reference_path);
+    // The packed reference exists and was written after the reference was last modified
+    static bool is_up_to_date(const Path& packed_reference_path, const Path& reference_path);
+    static void build(const ReferenceGenome& reference, const Path& packed_reference_path);
+
+private:
+    struct Header;
+    struct ContigEntry;
+
+    Path path_;
+    boost::iostreams::mapped_file_source file_;
+    const Header* header_;
+    std::shared_ptr<const std::unordered_map<ContigName, const ContigEntry*>> contigs_;
+    Options options_;
+
+    std::unique_ptr<ReferenceReader> do_clone() const override;
+    bool do_is_open() const noexcept override;
+    std::string do_fetch_reference_name() const override;
+    std::vector<ContigName> do_fetch_contig_names() const override;
+    GenomicSize do_fetch_contig_size(const ContigName& contig) const override;
+    GeneticSequence do_fetch_sequence(const GenomicRegion& region) const override;
+
+    template <typename T> const T* at(std::uint64_t offset) const noexcept;
+    const ContigEntry& contig_entry(const ContigName& contig) const;
+    bool is_capitalisation_requested() const noexcept;
+};
+
+} // namespace io
+} // namespace octopus
+
+#endif
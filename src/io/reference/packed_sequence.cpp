@@ -0,0 +1,97 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "packed_sequence.hpp"
+
+#include <array>
+#include <algorithm>
+#include <iterator>
+#include <cctype>
+
+namespace octopus { namespace io {
+
+namespace {
+
+constexpr std::uint8_t nonACGT {4};
+
+constexpr std::array<char, 4> bases {'A', 'C', 'G', 'T'};
+
+auto make_base_codes() noexcept
+{
+    std::array<std::uint8_t, 256> result {};
+    result.fill(nonACGT);
+    for (std::uint8_t code {0}; code < bases.size(); ++code) {
+        result[static_cast<unsigned char>(bases[code])] = code;
+    }
+    return result;
+}
+
+const auto baseCodes = make_base_codes();
+
+void extend_runs(std::vector<PackedBaseRun>& runs, const std::uint32_t position, const char base)
+{
+    if (!runs.empty() && runs.back().begin + runs.back().length == position && runs.back().base == base) {
+        ++runs.back().length;
+    } else {
+        runs.push_back({position, 1, base});
+    }
+}
+
+template <typename F>
+void apply_runs(const PackedBaseRun* first_run, const PackedBaseRun* last_run,
+                const std::uint32_t first, const std::uint32_t last, F f)
+{
+    // Runs are sorted and non-overlapping, so also sorted by end
+    auto run_itr = std::partition_point(first_run, last_run,
+                                        [=] (const auto& run) { return run.begin + run.length <= first; });
+    for (; run_itr != last_run && run_itr->begin < last; ++run_itr) {
+        const auto run_first = std::max(run_itr->begin, first);
+        const auto run_last  = std::min(run_itr->begin + run_itr->length, last);
+        for (auto position = run_first; position < run_last; ++position) {
+            f(position - first, *run_itr);
+        }
+    }
+}
+
+} // namespace
+
+void pack(const std::string& sequence, const std::uint32_t offset, std::vector<std::uint8_t>& packed_bases,
+          std::vector<PackedBaseRun>& ambiguous_runs, std::vector<PackedBaseRun>& lower_case_runs)
+{
+    const auto end = offset + static_cast<std::uint32_t>(sequence.size());
+    packed_bases.resize((end + 3) / 4, 0);
+    for (auto position = offset; position < end; ++position) {
+        const auto base = sequence[position - offset];
+        if (std::islower(static_cast<unsigned char>(base))) {
+            extend_runs(lower_case_runs, position, 'a');
+        }
+        const auto upper_base = static_cast<char>(std::toupper(static_cast<unsigned char>(base)));
+        auto code = baseCodes[static_cast<unsigned char>(upper_base)];
+        if (code == nonACGT) {
+            extend_runs(ambiguous_runs, position, upper_base);
+            code = 0;
+        }
+        packed_bases[position / 4] |= code << (2 * (position % 4));
+    }
+}
+
+void unpack(const PackedSequenceView& sequence, const std::uint32_t first, const std::uint32_t last, std::string& result)
+{
+    if (first >= last) return;
+    const auto offset = result.size();
+    result.resize(offset + (last - first));
+    for (auto position = first; position < last; ++position) {
+        const auto code = (sequence.bases[position / 4] >> (2 * (position % 4))) & 3;
+        result[offset + (position - first)] = bases[code];
+    }
+    const auto ambiguous_runs_end = sequence.ambiguous_runs + sequence.num_ambiguous_runs;
+    apply_runs(sequence.ambiguous_runs, ambiguous_runs_end, first, last,
+               [&] (const auto i, const PackedBaseRun& run) { result[offset + i] = run.base; });
+    const auto lower_case_runs_end = sequence.lower_case_runs + sequence.num_lower_case_runs;
+    apply_runs(sequence.lower_case_runs, lower_case_runs_end, first, last, [&] (const auto i, const PackedBaseRun&) {
+        result[offset + i] = static_cast<char>(std::tolower(static_cast<unsigned char>(result[offset + i])));
+    });
+}
+
+} // namespace io
+} // namespace octopus
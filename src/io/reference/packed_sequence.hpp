@@ -0,0 +1,45 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef packed_sequence_hpp
+#define packed_sequence_hpp
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace octopus { namespace io {
+
+/*
+ Sequence is packed as 2-bit base codes, four bases per byte with the first base in the low bits. Bases
+ other than ACGT are packed as A and recorded in a run table, and lower case (soft masked) bases are
+ recorded in a second run table, so packing is lossless.
+ */
+
+struct PackedBaseRun
+{
+    std::uint32_t begin, length;
+    char base;
+};
+
+struct PackedSequenceView
+{
+    const std::uint8_t* bases;
+    const PackedBaseRun* ambiguous_runs;
+    std::size_t num_ambiguous_runs;
+    const PackedBaseRun* lower_case_runs;
+    std::size_t num_lower_case_runs;
+};
+
+// Packs sequence as the bases starting at position offset, which must be the number of bases already packed
+void pack(const std::string& sequence, std::uint32_t offset, std::vector<std::uint8_t>& packed_bases,
+          std::vector<PackedBaseRun>& ambiguous_runs, std::vector<PackedBaseRun>& lower_case_runs);
+
+// Appends the bases in [first, last) to result
+void unpack(const PackedSequenceView& sequence, std::uint32_t first, std::uint32_t last, std::string& result);
+
+} // namespace io
+} // namespace octopus
+
+#endif
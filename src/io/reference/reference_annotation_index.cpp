@@ -0,0 +1,303 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "reference_annotation_index.hpp"
+
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include <bitset>
+
+#include <boost/filesystem/operations.hpp>
+
+#include "reference_genome.hpp"
+#include "exceptions/malformed_file_error.hpp"
+#include "exceptions/unwritable_file_error.hpp"
+
+namespace octopus {
+
+/*
+ File layout (integers are in native byte order, so files are not portable between platforms of different
+ endianness; sections are 8-byte aligned):
+
+ Header
+ ContigEntry[num_contigs]
+ for each contig: contig name, GC bitmap (one bit per base, 64 bases per word),
+                  GC counts (number of G and C bases before each multiple of gcCountInterval)
+ */
+
+namespace {
+
+constexpr char index_magic[8] {'O', 'C', 'T', 'O', 'A', 'N', 'N', '\0'};
+constexpr std::uint32_t index_version {3};
+constexpr GenomicRegion::Size build_chunk_size {10'000'000};
+constexpr std::uint64_t gcWordSize {64};
+constexpr std::uint64_t gcCountInterval {512}; // bases, so at most 8 bitmap words are counted per query
+
+} // namespace
+
+struct ReferenceAnnotationIndex::Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t num_contigs;
+};
+
+struct ReferenceAnnotationIndex::ContigEntry
+{
+    std::uint64_t name_offset, name_length;
+    std::uint64_t size;
+    std::uint64_t gc_bits_offset, gc_counts_offset;
+};
+
+namespace {
+
+std::uint64_t num_gc_words(const std::uint64_t contig_size) noexcept
+{
+    return (contig_size + gcWordSize - 1) / gcWordSize;
+}
+
+std::uint64_t num_gc_counts(const std::uint64_t contig_size) noexcept
+{
+    return contig_size / gcCountInterval + 1;
+}
+
+} // namespace
+
+class MalformedReferenceAnnotationIndex : public MalformedFileError
+{
+    std::string do_where() const override
+    {
+        return "ReferenceAnnotationIndex";
+    }
+
+    std::string do_help() const override
+    {
+        return "rebuild the index with the --index-reference command line option";
+    }
+public:
+    MalformedReferenceAnnotationIndex(ReferenceAnnotationIndex::Path file, std::string reason)
+    : MalformedFileError {std::move(file), "octopus reference annotation index"}
+    {
+        set_reason(std::move(reason));
+    }
+};
+
+class UnwritableReferenceAnnotationIndex : public UnwritableFileError
+{
+    std::string do_where() const override
+    {
+        return "ReferenceAnnotationIndex";
+    }
+public:
+    UnwritableReferenceAnnotationIndex(ReferenceAnnotationIndex::Path file)
+    : UnwritableFileError {std::move(file), "octopus reference annotation index"}
+    {}
+};
+
+ReferenceAnnotationIndex::ReferenceAnnotationIndex(Path index_path)
+: path_ {std::move(index_path)}
+, file_ {path_.string()}
+, header_ {nullptr}
+, contigs_ {}
+{
+    if (file_.size() < sizeof(Header)) {
+        throw MalformedReferenceAnnotationIndex {path_, "the file is truncated"};
+    }
+    header_ = at<Header>(0);
+    if (std::memcmp(header_->magic, index_magic, sizeof(index_magic)) != 0) {
+        throw MalformedReferenceAnnotationIndex {path_, "the file is not an annotation index"};
+    }
+    if (header_->version != index_version) {
+        throw MalformedReferenceAnnotationIndex {path_, "the index version is not supported"};
+    }
+    const auto contigs_end = sizeof(Header) + header_->num_contigs * sizeof(ContigEntry);
+    if (file_.size() < contigs_end) {
+        throw MalformedReferenceAnnotationIndex {path_, "the file is truncated"};
+    }
+    contigs_.reserve(header_->num_contigs);
+    for (std::uint32_t i {0}; i < header_->num_contigs; ++i) {
+        const auto contig = at<ContigEntry>(sizeof(Header) + i * sizeof(ContigEntry));
+        const auto sections_end = std::max({contig->name_offset + contig->name_length,
+                                            contig->gc_bits_offset + num_gc_words(contig->size) * sizeof(std::uint64_t),
+                                            contig->gc_counts_offset + num_gc_counts(contig->size) * sizeof(std::uint64_t)});
+        if (sections_end > file_.size()) {
+            throw MalformedReferenceAnnotationIndex {path_, "the file is truncated"};
+        }
+        contigs_.emplace(ContigName {at<char>(contig->name_offset), contig->name_length}, contig);
+    }
+}
+
+const ReferenceAnnotationIndex::Path& ReferenceAnnotationIndex::path() const noexcept
+{
+    return path_;
+}
+
+bool ReferenceAnnotationIndex::has_contig(const ContigName& contig) const noexcept
+{
+    return contigs_.count(contig) == 1;
+}
+
+bool ReferenceAnnotationIndex::is_compatible(const ReferenceGenome& reference) const
+{
+    if (contigs_.size() != reference.num_contigs()) return false;
+    return std::all_of(std::cbegin(contigs_), std::cend(contigs_),
+                       [&] (const auto& p) {
+                           return reference.has_contig(p.first) && reference.contig_size(p.first) == p.second->size;
+                       });
+}
+
+double ReferenceAnnotationIndex::gc_content(const GenomicRegion& region) const
+{
+    const auto contig = find(region.contig_name());
+    if (!contig) return 0;
+    // Clipped like the fetched sequence, so an empty region gives NaN just as utils::gc_content does
+    const auto region_end = std::min(std::uint64_t {region.end()}, contig->size);
+    const auto region_begin = std::min(std::uint64_t {region.begin()}, region_end);
+    const auto gc_count = count_gc(*contig, region_end) - count_gc(*contig, region_begin);
+    return static_cast<double>(gc_count) / (region_end - region_begin);
+}
+
+ReferenceAnnotationIndex::Path ReferenceAnnotationIndex::default_path(const Path& reference_path)
+{
+    return reference_path.string() + ".oai";
+}
+
+bool ReferenceAnnotationIndex::is_up_to_date(const Path& index_path, const Path& reference_path)
+{
+    namespace fs = boost::filesystem;
+    boost::system::error_code ec {};
+    if (!fs::exists(index_path, ec)) return false;
+    const auto index_write_time = fs::last_write_time(index_path, ec);
+    if (ec) return false;
+    const auto reference_write_time = fs::last_write_time(reference_path, ec);
+    return !ec && index_write_time >= reference_write_time;
+}
+
+namespace {
+
+template <typename T>
+void write(std::ostream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void write(std::ostream& out, const std::vector<T>& values)
+{
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+void pad(std::ostream& out)
+{
+    static constexpr char zeros[8] {};
+    const auto remainder = static_cast<std::size_t>(out.tellp()) % sizeof(zeros);
+    if (remainder > 0) out.write(zeros, sizeof(zeros) - remainder);
+}
+
+bool is_gc(const char base) noexcept
+{
+    // Soft-masked bases are lower case, but callers see the capitalised reference
+    return base == 'G' || base == 'C' || base == 'g' || base == 'c';
+}
+
+unsigned popcount(const std::uint64_t word) noexcept
+{
+    return static_cast<unsigned>(std::bitset<gcWordSize> {word}.count());
+}
+
+} // namespace
+
+void ReferenceAnnotationIndex::build(const ReferenceGenome& reference, const Path& index_path)
+{
+    namespace fs = boost::filesystem;
+    const auto contigs = reference.contig_names();
+    // Write to a temporary file first so an interrupted build never leaves a truncated file that looks up to date
+    const Path temp_path {index_path.string() + ".tmp"};
+    try {
+        std::ofstream out {temp_path.string(), std::ios::binary | std::ios::trunc};
+        if (!out) throw UnwritableReferenceAnnotationIndex {temp_path};
+        Header header {};
+        std::copy(std::cbegin(index_magic), std::cend(index_magic), header.magic);
+        header.version = index_version;
+        header.num_contigs = static_cast<std::uint32_t>(contigs.size());
+        write(out, header);
+        std::vector<ContigEntry> entries(contigs.size());
+        for (const auto& entry : entries) write(out, entry); // placeholders
+        for (std::size_t i {0}; i < contigs.size(); ++i) {
+            const auto& contig = contigs[i];
+            const auto contig_size = reference.contig_size(contig);
+            auto& entry = entries[i];
+            entry.size = contig_size;
+            entry.name_offset = out.tellp();
+            entry.name_length = contig.size();
+            out.write(contig.data(), contig.size());
+            std::vector<std::uint64_t> gc_bits(num_gc_words(contig_size));
+            for (GenomicRegion::Position chunk_begin {0}; chunk_begin < contig_size; chunk_begin += build_chunk_size) {
+                const GenomicRegion chunk {contig, chunk_begin, std::min(chunk_begin + build_chunk_size, contig_size)};
+                std::uint64_t position {chunk_begin};
+                for (const char base : reference.fetch_sequence(chunk)) {
+                    if (is_gc(base)) gc_bits[position / gcWordSize] |= std::uint64_t {1} << (position % gcWordSize);
+                    ++position;
+                }
+            }
+            std::vector<std::uint64_t> gc_counts {};
+            gc_counts.reserve(num_gc_counts(contig_size));
+            gc_counts.push_back(0);
+            std::uint64_t gc_count {0};
+            for (std::size_t word {0}; word < gc_bits.size(); ++word) {
+                gc_count += popcount(gc_bits[word]);
+                if ((word + 1) % (gcCountInterval / gcWordSize) == 0) gc_counts.push_back(gc_count);
+            }
+            pad(out);
+            entry.gc_bits_offset = out.tellp();
+            write(out, gc_bits);
+            entry.gc_counts_offset = out.tellp();
+            write(out, gc_counts);
+        }
+        pad(out);
+        out.seekp(sizeof(Header));
+        for (const auto& entry : entries) write(out, entry);
+        out.close();
+        if (!out) throw UnwritableReferenceAnnotationIndex {temp_path};
+        fs::rename(temp_path, index_path);
+    } catch (...) {
+        boost::system::error_code ec {};
+        fs::remove(temp_path, ec);
+        throw;
+    }
+}
+
+// private methods
+
+template <typename T>
+const T* ReferenceAnnotationIndex::at(const std::uint64_t offset) const noexcept
+{
+    return reinterpret_cast<const T*>(file_.data() + offset);
+}
+
+const ReferenceAnnotationIndex::ContigEntry* ReferenceAnnotationIndex::find(const ContigName& contig) const noexcept
+{
+    const auto itr = contigs_.find(contig);
+    return itr != std::cend(contigs_) ? itr->second : nullptr;
+}
+
+std::uint64_t ReferenceAnnotationIndex::count_gc(const ContigEntry& contig, const std::uint64_t end) const noexcept
+{
+    const auto words = at<std::uint64_t>(contig.gc_bits_offset);
+    auto result = at<std::uint64_t>(contig.gc_counts_offset)[end / gcCountInterval];
+    const auto last_word = end / gcWordSize;
+    for (auto word = (end / gcCountInterval) * (gcCountInterval / gcWordSize); word < last_word; ++word) {
+        result += popcount(words[word]);
+    }
+    const auto num_tail_bases = end % gcWordSize;
+    if (num_tail_bases > 0) {
+        result += popcount(words[last_word] & ((std::uint64_t {1} << num_tail_bases) - 1));
+    }
+    return result;
+}
+
+} // namespace octopus
@@ -0,0 +1,74 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef reference_annotation_index_hpp
+#define reference_annotation_index_hpp
+
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "basics/genomic_region.hpp"
+
+namespace octopus {
+
+class ReferenceGenome;
+
+/**
+ A ReferenceAnnotationIndex is a read-only view of a binary sidecar file containing static annotations
+ of a reference genome, currently a bitmap of G and C bases with running GC counts, which gives the exact
+ GC content of any region. The file is memory-mapped, so only the pages covering requested regions are
+ ever read.
+
+ The sidecar is written once by build, and is conventionally stored next to the FASTA (see default_path).
+ */
+class ReferenceAnnotationIndex
+{
+public:
+    using Path       = boost::filesystem::path;
+    using ContigName = GenomicRegion::ContigName;
+
+    ReferenceAnnotationIndex() = delete;
+
+    ReferenceAnnotationIndex(Path index_path);
+
+    ReferenceAnnotationIndex(const ReferenceAnnotationIndex&)            = delete;
+    ReferenceAnnotationIndex& operator=(const ReferenceAnnotationIndex&) = delete;
+    ReferenceAnnotationIndex(ReferenceAnnotationIndex&&)                 = default;
+    ReferenceAnnotationIndex& operator=(ReferenceAnnotationIndex&&)      = default;
+
+    ~ReferenceAnnotationIndex() = default;
+
+    const Path& path() const noexcept;
+
+    bool has_contig(const ContigName& contig) const noexcept;
+    bool is_compatible(const ReferenceGenome& reference) const;
+
+    // GC fraction of the region, the same as utils::gc_content of the capitalised reference sequence
+    double gc_content(const GenomicRegion& region) const;
+
+    static Path default_path(const Path& reference_path);
+    // The index exists and was written after the reference was last modified
+    static bool is_up_to_date(const Path& index_path, const Path& reference_path);
+    static void build(const ReferenceGenome& reference, const Path& index_path);
+
+private:
+    struct Header;
+    struct ContigEntry;
+
+    Path path_;
+    boost::iostreams::mapped_file_source file_;
+    const Header* header_;
+    std::unordered_map<ContigName, const ContigEntry*> contigs_;
+
+    template <typename T> const T* at(std::uint64_t offset) const noexcept;
+    const ContigEntry* find(const ContigName& contig) const noexcept;
+    std::uint64_t count_gc(const ContigEntry& contig, std::uint64_t end) const noexcept;
+};
+
+} // namespace octopus
+
+#endif
@@ -9,8 +9,11 @@
 #include <numeric>
 
 #include "fasta.hpp"
+#include "mapped_fasta.hpp"
 #include "threadsafe_fasta.hpp"
-#include "caching_fasta.hpp"
+#include "packed_caching_fasta.hpp"
+#include "packed_reference.hpp"
+#include "reference_annotation_index.hpp"
 
 namespace octopus {
 
@@ -18,6 +21,7 @@ ReferenceGenome::ReferenceGenome(std::unique_ptr<io::ReferenceReader> impl)
 : impl_ {std::move(impl)}
 , name_{}
 , contig_sizes_ {}
+, annotations_ {}
 {
     if (impl_->is_open()) {
         try {
@@ -40,6 +44,7 @@ ReferenceGenome::ReferenceGenome(const ReferenceGenome& other)
 , name_ {other.name_}
 , contig_sizes_ {other.contig_sizes_}
 , ordered_contigs_ {other.ordered_contigs_}
+, annotations_ {other.annotations_}
 {}
 
 ReferenceGenome& ReferenceGenome::operator=(ReferenceGenome other)
@@ -49,6 +54,7 @@ ReferenceGenome& ReferenceGenome::operator=(ReferenceGenome other)
     swap(name_,            other.name_);
     swap(contig_sizes_,    other.contig_sizes_);
     swap(ordered_contigs_, other.ordered_contigs_);
+    swap(annotations_,     other.annotations_);
     return *this;
 }
 
@@ -92,12 +98,28 @@ ReferenceGenome::GeneticSequence ReferenceGenome::fetch_sequence(const GenomicRe
     return impl_->fetch_sequence(region);
 }
 
+bool ReferenceGenome::has_annotations() const noexcept
+{
+    return static_cast<bool>(annotations_);
+}
+
+const ReferenceAnnotationIndex& ReferenceGenome::annotations() const noexcept
+{
+    return *annotations_;
+}
+
+void ReferenceGenome::set_annotations(std::shared_ptr<const ReferenceAnnotationIndex> annotations) noexcept
+{
+    annotations_ = std::move(annotations);
+}
+
 // non-member functions
 
 ReferenceGenome make_reference(boost::filesystem::path reference_path,
                                const MemoryFootprint max_cache_size,
                                const bool is_threaded,
-                               bool capitalise_bases)
+                               bool capitalise_bases,
+                               const bool memory_map)
 {
     using namespace io;
     std::unique_ptr<ReferenceReader> impl_ {};
@@ -106,21 +128,34 @@ ReferenceGenome make_reference(boost::filesystem::path reference_path,
         options.base_transform_policy = Fasta::Options::BaseTransformPolicy::capitalise;
     }
     options.base_fill_policy = Fasta::Options::BaseFillPolicy::fill_with_ns;
+    if (memory_map) {
+        // Fetches are lock free and served from the page cache, so neither locking nor caching is needed
+        return ReferenceGenome {std::make_unique<MappedFasta>(std::move(reference_path), options)};
+    }
     if (is_threaded) {
         impl_ = std::make_unique<ThreadsafeFasta>(std::make_unique<Fasta>(reference_path, options));
     } else {
         impl_ = std::make_unique<Fasta>(std::move(reference_path), options);
     }
     if (max_cache_size.num_bytes() > 0) {
-        double locality_bias {0.99}, forward_bias {0.99};
-        if (is_threaded) locality_bias = 0.25;
-        return ReferenceGenome {std::make_unique<CachingFasta>(std::move(impl_), max_cache_size.num_bytes(),
-                                                               locality_bias, forward_bias)};
+        return ReferenceGenome {std::make_unique<PackedCachingFasta>(std::move(impl_), max_cache_size.num_bytes())};
     } else {
         return ReferenceGenome {std::move(impl_)};
     }
 }
 
+ReferenceGenome make_packed_reference(boost::filesystem::path packed_reference_path, const bool capitalise_bases)
+{
+    using namespace io;
+    PackedReference::Options options {};
+    if (capitalise_bases) {
+        options.base_transform_policy = PackedReference::Options::BaseTransformPolicy::capitalise;
+    }
+    options.base_fill_policy = PackedReference::Options::BaseFillPolicy::fill_with_ns;
+    // Fetches are lock free and the packed sequence is already compact, so neither locking nor caching is needed
+    return ReferenceGenome {std::make_unique<PackedReference>(std::move(packed_reference_path), options)};
+}
+
 std::vector<GenomicRegion> get_all_contig_regions(const ReferenceGenome& reference)
 {
     std::vector<GenomicRegion> result {};
@@ -18,6 +18,8 @@
 
 namespace octopus {
 
+class ReferenceAnnotationIndex;
+
 class ReferenceGenome
 {
 public:
@@ -47,11 +49,16 @@ public:
     
     GeneticSequence fetch_sequence(const GenomicRegion& region) const;
     
+    bool has_annotations() const noexcept;
+    const ReferenceAnnotationIndex& annotations() const noexcept;
+    void set_annotations(std::shared_ptr<const ReferenceAnnotationIndex> annotations) noexcept;
+    
 private:
     std::unique_ptr<io::ReferenceReader> impl_;
     std::string name_;
     std::unordered_map<ContigName, ContigRegion::Size> contig_sizes_;
     std::vector<ContigName> ordered_contigs_;
+    std::shared_ptr<const ReferenceAnnotationIndex> annotations_;
 };
 
 // non-member functions
@@ -59,7 +66,12 @@ private:
 ReferenceGenome make_reference(boost::filesystem::path reference_path,
                                MemoryFootprint max_cache_size = 0,
                                bool is_threaded = false,
-                               bool capitalise_bases = true);
+                               bool capitalise_bases = true,
+                               bool memory_map = false);
+
+// Opens a packed reference written by io::PackedReference::build
+ReferenceGenome make_packed_reference(boost::filesystem::path packed_reference_path,
+                                      bool capitalise_bases = true);
 
 std::vector<GenomicRegion> get_all_contig_regions(const ReferenceGenome& reference);
 
@@ -18,6 +18,9 @@
 #include <boost/optional.hpp>
 #include <boost/container/small_vector.hpp>
 
+#include "htslib/bgzf.h"
+#include "htslib/hfile.h"
+
 #include "basics/genomic_region.hpp"
 #include "utils/string_utils.hpp"
 #include "vcf_spec.hpp"
@@ -82,9 +85,11 @@ std::string get_hts_mode(const HtslibBcfFacade::Path& file_path, HtslibBcfFacade
 
 HtslibBcfFacade::HtslibBcfFacade()
 : file_path_ {}
+, thread_pool_ {}
 , file_ {bcf_open("-", "[w]"), HtsFileDeleter {}}
 , header_ {bcf_hdr_init("w"), HtsHeaderDeleter {}}
 , samples_ {}
+, write_buffer_ {}
 {
     if (file_ == nullptr) {
         throw std::runtime_error {"HtslibBcfFacade: could not open stdout writer"};
@@ -95,10 +100,16 @@ HtslibBcfFacade::HtslibBcfFacade()
 }
 
 HtslibBcfFacade::HtslibBcfFacade(Path file_path, Mode mode)
+: HtslibBcfFacade {std::move(file_path), mode, nullptr}
+{}
+
+HtslibBcfFacade::HtslibBcfFacade(Path file_path, Mode mode, std::shared_ptr<const io::HtslibThreadPool> thread_pool)
 : file_path_ {std::move(file_path)}
+, thread_pool_ {std::move(thread_pool)}
 , file_ {nullptr, HtsFileDeleter {}}
 , header_ {nullptr, HtsHeaderDeleter {}}
 , samples_ {}
+, write_buffer_ {}
 {
     const auto hts_mode = get_hts_mode(file_path_, mode);
     if (mode == Mode::read) {
@@ -115,6 +126,8 @@ HtslibBcfFacade::HtslibBcfFacade(Path file_path, Mode mode)
         }
     } else {
         file_.reset(bcf_open(file_path_.c_str(), hts_mode.c_str()));
+        // Uncompressed output ignores the pool, so attaching is harmless whatever the mode
+        if (file_ && thread_pool_) thread_pool_->attach(file_.get());
         header_.reset(bcf_hdr_init(hts_mode.c_str()));
     }
 }
@@ -189,6 +202,33 @@ std::size_t HtslibBcfFacade::count_records(const GenomicRegion& region) const
     return count_records(sr);
 }
 
+namespace {
+
+// The names belong to the index or header, only the array is ours
+std::vector<std::string> take_contig_names(const char** names, const int num_names)
+{
+    std::vector<std::string> result(names, names + num_names);
+    std::free(names);
+    return result;
+}
+
+} // namespace
+
+boost::optional<std::vector<std::string>> HtslibBcfFacade::fetch_indexed_contigs() const
+{
+    if (file_ == nullptr || header_ == nullptr) return boost::none;
+    int num_contigs {0};
+    if (hts_get_format(file_.get())->format == bcf) {
+        std::unique_ptr<hts_idx_t, HtsIndexDeleter> index {bcf_index_load(file_path_.c_str()), HtsIndexDeleter {}};
+        if (index == nullptr) return boost::none;
+        return take_contig_names(bcf_index_seqnames(index.get(), header_.get(), &num_contigs), num_contigs);
+    } else {
+        std::unique_ptr<tbx_t, HtsTbxDeleter> index {tbx_index_load(file_path_.c_str()), HtsTbxDeleter {}};
+        if (index == nullptr) return boost::none;
+        return take_contig_names(tbx_seqnames(index.get(), &num_contigs), num_contigs);
+    }
+}
+
 HtslibBcfFacade::RecordIteratorPtrPair HtslibBcfFacade::iterate(const UnpackPolicy level) const
 {
     HtsBcfSrPtr sr {bcf_sr_init(), HtsSrsDeleter {}};
@@ -198,7 +238,7 @@ HtslibBcfFacade::RecordIteratorPtrPair HtslibBcfFacade::iterate(const UnpackPoli
         throw std::runtime_error {"failed to open file " + file_path_.string()};
     }
     
-    return std::make_pair(std::make_unique<RecordIterator>(*this, std::move(sr), level),
+    return std::make_pair(std::make_unique<RecordIterator>(*this, std::move(sr), get_field_ids(level)),
                           std::make_unique<RecordIterator>(*this));
 }
 
@@ -215,7 +255,7 @@ HtslibBcfFacade::iterate(const std::string& contig, const UnpackPolicy level) co
         throw std::runtime_error {"failed to open file " + file_path_.string()};
     }
     
-    return std::make_pair(std::make_unique<RecordIterator>(*this, std::move(sr), level),
+    return std::make_pair(std::make_unique<RecordIterator>(*this, std::move(sr), get_field_ids(level)),
                           std::make_unique<RecordIterator>(*this));
 }
 
@@ -233,7 +273,38 @@ HtslibBcfFacade::iterate(const GenomicRegion& region, const UnpackPolicy level)
         throw std::runtime_error {"failed to open file " + file_path_.string()};
     }
     
-    return std::make_pair(std::make_unique<RecordIterator>(*this, std::move(sr), level),
+    return std::make_pair(std::make_unique<RecordIterator>(*this, std::move(sr), get_field_ids(level)),
+                          std::make_unique<RecordIterator>(*this));
+}
+
+HtslibBcfFacade::RecordIteratorPtrPair HtslibBcfFacade::iterate(const UnpackFields& fields) const
+{
+    HtsBcfSrPtr sr {bcf_sr_init(), HtsSrsDeleter {}};
+    
+    if (bcf_sr_add_reader(sr.get(), file_path_.c_str()) != 1) {
+        sr.release();
+        throw std::runtime_error {"failed to open file " + file_path_.string()};
+    }
+    
+    return std::make_pair(std::make_unique<RecordIterator>(*this, std::move(sr), get_field_ids(fields)),
+                          std::make_unique<RecordIterator>(*this));
+}
+
+HtslibBcfFacade::RecordIteratorPtrPair
+HtslibBcfFacade::iterate(const GenomicRegion& region, const UnpackFields& fields) const
+{
+    HtsBcfSrPtr sr {bcf_sr_init(), HtsSrsDeleter {}};
+    const auto region_str = to_string(region);
+    
+    if (bcf_sr_set_regions(sr.get(), region_str.c_str(), 0) != 0) {
+        throw std::runtime_error {"failed load region " + region_str};
+    }
+    if (bcf_sr_add_reader(sr.get(), file_path_.c_str()) != 1) {
+        sr.release();
+        throw std::runtime_error {"failed to open file " + file_path_.string()};
+    }
+    
+    return std::make_pair(std::make_unique<RecordIterator>(*this, std::move(sr), get_field_ids(fields)),
                           std::make_unique<RecordIterator>(*this));
 }
 
@@ -248,7 +319,7 @@ HtslibBcfFacade::fetch_records(const UnpackPolicy level) const
         throw std::runtime_error {"failed to open file " + file_path_.string()};
     }
     
-    return fetch_records(sr.get(), level, n_records);
+    return fetch_records(sr.get(), get_field_ids(level), n_records);
 }
 
 HtslibBcfFacade::RecordContainer
@@ -265,7 +336,7 @@ HtslibBcfFacade::fetch_records(const std::string& contig, const UnpackPolicy lev
         throw std::runtime_error {"failed to open file " + file_path_.string()};
     }
     
-    return fetch_records(sr.get(), level, n_records);
+    return fetch_records(sr.get(), get_field_ids(level), n_records);
 }
 
 HtslibBcfFacade::RecordContainer
@@ -283,7 +354,7 @@ HtslibBcfFacade::fetch_records(const GenomicRegion& region, const UnpackPolicy l
         throw std::runtime_error {"failed to open file " + file_path_.string()};
     }
     
-    return fetch_records(sr.get(), level, n_records);
+    return fetch_records(sr.get(), get_field_ids(level), n_records);
 }
 
 auto hts_tag_type(const std::string& tag)
@@ -386,7 +457,13 @@ void HtslibBcfFacade::write(const VcfRecord& record)
         throw std::runtime_error {"HtslibBcfFacade: required contig header line missing for contig \"" + contig + "\""};
     }
     
-    auto hts_record = bcf_init();
+    // The record is reused between writes to avoid reallocating its buffers for every call
+    if (write_buffer_) {
+        bcf_clear(write_buffer_.get());
+    } else {
+        write_buffer_.reset(bcf_init());
+    }
+    const auto hts_record = write_buffer_.get();
     set_chrom(header_.get(), hts_record, contig);
     set_pos(hts_record, record.pos() - 1);
     set_id(hts_record, record.id());
@@ -400,7 +477,166 @@ void HtslibBcfFacade::write(const VcfRecord& record)
         set_samples(header_.get(), hts_record, record, samples_);
     }
     bcf_write(file_.get(), header_.get(), hts_record);
-    bcf_destroy(hts_record);
+}
+
+namespace {
+
+bool have_same_dictionary(const bcf_hdr_t* lhs, const bcf_hdr_t* rhs, const int type) noexcept
+{
+    if (lhs->n[type] != rhs->n[type]) return false;
+    for (int i {0}; i < lhs->n[type]; ++i) {
+        const auto& l = lhs->id[type][i];
+        const auto& r = rhs->id[type][i];
+        if ((l.key == nullptr) != (r.key == nullptr)) return false;
+        if (l.key == nullptr) continue;
+        if (std::strcmp(l.key, r.key) != 0) return false;
+        if (type != BCF_DT_SAMPLE && !std::equal(std::cbegin(l.val->info), std::cend(l.val->info), std::cbegin(r.val->info))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Maps each contig id of src to the id of the same contig in dst, or boost::none if dst lacks any of src's contigs
+boost::optional<std::vector<std::int32_t>> map_contig_ids(const bcf_hdr_t* src, const bcf_hdr_t* dst)
+{
+    std::vector<std::int32_t> result(src->n[BCF_DT_CTG], -1);
+    for (int i {0}; i < src->n[BCF_DT_CTG]; ++i) {
+        const auto contig = src->id[BCF_DT_CTG][i].key;
+        if (contig == nullptr) continue;
+        result[i] = bcf_hdr_name2id(dst, contig);
+        if (result[i] < 0) return boost::none;
+    }
+    return result;
+}
+
+bool is_identity(const std::vector<std::int32_t>& ids) noexcept
+{
+    for (std::size_t i {0}; i < ids.size(); ++i) {
+        if (ids[i] >= 0 && static_cast<std::size_t>(ids[i]) != i) return false;
+    }
+    return true;
+}
+
+constexpr std::array<std::uint8_t, 28> bgzfEofMarker {
+    0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x06, 0x00, 0x42, 0x43,
+    0x02, 0x00, 0x1b, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+void bgzf_write_all(BGZF* dst, const char* data, const std::size_t length)
+{
+    if (bgzf_write(dst, data, length) != static_cast<ssize_t>(length)) {
+        throw std::runtime_error {"HtslibBcfFacade: failed to append records"};
+    }
+}
+
+void bgzf_raw_write_all(BGZF* dst, const char* data, const std::size_t length)
+{
+    if (bgzf_raw_write(dst, data, length) != static_cast<ssize_t>(length)) {
+        throw std::runtime_error {"HtslibBcfFacade: failed to append compressed blocks"};
+    }
+}
+
+// Copies the rest of src to dst, dropping src's end-of-file marker. Records sharing src's
+// current block are recompressed; all following blocks are copied without being decompressed.
+void copy_blocks(BGZF* src, BGZF* dst)
+{
+    if (src->block_offset < src->block_length) {
+        bgzf_write_all(dst, static_cast<const char*>(src->uncompressed_block) + src->block_offset,
+                       static_cast<std::size_t>(src->block_length - src->block_offset));
+    }
+    if (bgzf_flush(dst) != 0) {
+        throw std::runtime_error {"HtslibBcfFacade: failed to append records"};
+    }
+    static constexpr std::size_t chunkSize {1 << 20};
+    std::vector<char> buffer(chunkSize + bgzfEofMarker.size());
+    std::size_t num_held {0}; // the last bytes read, which might be the marker
+    while (true) {
+        const auto num_read = hread(src->fp, buffer.data() + num_held, chunkSize);
+        if (num_read < 0) {
+            throw std::runtime_error {"HtslibBcfFacade: failed to read compressed blocks"};
+        }
+        if (num_read == 0) break;
+        const auto num_available = num_held + static_cast<std::size_t>(num_read);
+        const auto num_writable = num_available > bgzfEofMarker.size() ? num_available - bgzfEofMarker.size() : 0;
+        bgzf_raw_write_all(dst, buffer.data(), num_writable);
+        num_held = num_available - num_writable;
+        std::memmove(buffer.data(), buffer.data() + num_writable, num_held);
+    }
+    const auto is_eof_marker = num_held == bgzfEofMarker.size()
+        && std::equal(std::cbegin(bgzfEofMarker), std::cend(bgzfEofMarker), std::cbegin(buffer),
+                      [] (const std::uint8_t marker, const char c) { return marker == static_cast<std::uint8_t>(c); });
+    if (!is_eof_marker) bgzf_raw_write_all(dst, buffer.data(), num_held);
+}
+
+std::uint32_t read_le_uint32(const char* data) noexcept
+{
+    const auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+}
+
+void write_le_uint32(const std::uint32_t value, char* data) noexcept
+{
+    for (int i {0}; i < 4; ++i) data[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+// Copies the remaining BCF records of src to dst, rewriting each record's contig id, which is the only
+// field that refers to the contig dictionary. Records are decompressed but not decoded.
+void copy_bcf_records(BGZF* src, BGZF* dst, const std::vector<std::int32_t>& contig_ids)
+{
+    std::array<char, 8> lengths {}; // l_shared, l_indiv
+    std::vector<char> record {};
+    while (true) {
+        const auto num_read = bgzf_read(src, lengths.data(), lengths.size());
+        if (num_read == 0) break;
+        if (num_read != static_cast<ssize_t>(lengths.size())) {
+            throw std::runtime_error {"HtslibBcfFacade: truncated record in appended file"};
+        }
+        const std::size_t record_length {read_le_uint32(lengths.data()) + std::size_t {read_le_uint32(lengths.data() + 4)}};
+        record.resize(record_length);
+        if (record_length < 4 || bgzf_read(src, record.data(), record_length) != static_cast<ssize_t>(record_length)) {
+            throw std::runtime_error {"HtslibBcfFacade: truncated record in appended file"};
+        }
+        const auto contig_id = static_cast<std::int32_t>(read_le_uint32(record.data()));
+        if (contig_id < 0 || static_cast<std::size_t>(contig_id) >= contig_ids.size() || contig_ids[contig_id] < 0) {
+            throw std::runtime_error {"HtslibBcfFacade: record with unknown contig in appended file"};
+        }
+        write_le_uint32(static_cast<std::uint32_t>(contig_ids[contig_id]), record.data());
+        bgzf_write_all(dst, lengths.data(), lengths.size());
+        bgzf_write_all(dst, record.data(), record.size());
+    }
+}
+
+} // namespace
+
+bool HtslibBcfFacade::append_compressed(const Path& source_path)
+{
+    if (file_ == nullptr || header_ == nullptr) {
+        throw std::runtime_error {"HtslibBcfFacade: trying to append to a file without a header"};
+    }
+    const auto format = hts_get_format(file_.get());
+    if (format->compression != bgzf) return false;
+    std::unique_ptr<htsFile, HtsFileDeleter> source {bcf_open(source_path.c_str(), "r"), HtsFileDeleter {}};
+    if (source == nullptr) return false;
+    const auto source_format = hts_get_format(source.get());
+    if (source_format->format != format->format || source_format->compression != bgzf) return false;
+    std::unique_ptr<bcf_hdr_t, HtsHeaderDeleter> source_header {bcf_hdr_read(source.get()), HtsHeaderDeleter {}};
+    if (source_header == nullptr
+        || !have_same_dictionary(header_.get(), source_header.get(), BCF_DT_ID)
+        || !have_same_dictionary(header_.get(), source_header.get(), BCF_DT_SAMPLE)) {
+        return false;
+    }
+    const auto contig_ids = map_contig_ids(source_header.get(), header_.get());
+    if (!contig_ids) return false;
+    const auto src = hts_get_bgzfp(source.get());
+    const auto dst = hts_get_bgzfp(file_.get());
+    // VCF records name their contig, but BCF records refer to it by index
+    if (format->format == bcf && !is_identity(*contig_ids)) {
+        copy_bcf_records(src, dst, *contig_ids);
+    } else {
+        copy_blocks(src, dst);
+    }
+    return true;
 }
 
 // HtslibBcfFacade::RecordIterator
@@ -408,19 +644,19 @@ void HtslibBcfFacade::write(const VcfRecord& record)
 HtslibBcfFacade::RecordIterator::RecordIterator(const HtslibBcfFacade& facade)
 : facade_ {facade}
 , hts_iterator_ {nullptr}
-, level_ {}
+, fields_ {}
 , record_ {nullptr}
 {}
 
 HtslibBcfFacade::RecordIterator::RecordIterator(const HtslibBcfFacade& facade,
                                                 HtsBcfSrPtr hts_iterator,
-                                                UnpackPolicy level)
+                                                FieldIds fields)
 : facade_ {facade}
 , hts_iterator_ {std::move(hts_iterator)}
-, level_ {level}
+, fields_ {std::move(fields)}
 {
     if (bcf_sr_next_line(hts_iterator_.get())) {
-        record_ = std::make_shared<VcfRecord>(facade_.get().fetch_record(hts_iterator_.get(), level_));
+        record_ = std::make_shared<VcfRecord>(facade_.get().fetch_record(hts_iterator_.get(), fields_));
     } else {
         hts_iterator_ = nullptr;
     }
@@ -439,7 +675,7 @@ HtslibBcfFacade::RecordIterator::pointer HtslibBcfFacade::RecordIterator::operat
 void HtslibBcfFacade::RecordIterator::next()
 {
     if (bcf_sr_next_line(hts_iterator_.get())) {
-        *record_ = facade_.get().fetch_record(hts_iterator_.get(), level_);
+        *record_ = facade_.get().fetch_record(hts_iterator_.get(), fields_);
     } else {
         hts_iterator_ = nullptr;
     }
@@ -561,14 +797,20 @@ void set_filter(const bcf_hdr_t* header, bcf1_t* record, const std::vector<std::
     }
 }
 
-void extract_info(const bcf_hdr_t* header, bcf1_t* record, VcfRecord::Builder& builder)
+bool is_selected(const int key_id, const boost::optional<std::vector<int>>& selection) noexcept
+{
+    return !selection || std::find(std::cbegin(*selection), std::cend(*selection), key_id) != std::cend(*selection);
+}
+
+void extract_info(const bcf_hdr_t* header, bcf1_t* record, VcfRecord::Builder& builder,
+                  const boost::optional<std::vector<int>>& selection)
 {
     int* intinfo {nullptr};
     float* floatinfo {nullptr};
     char* stringinfo {nullptr};
     int* flaginfo {nullptr}; // not actually populated
     
-    builder.reserve_info(record->n_info);
+    builder.reserve_info(selection ? std::min(selection->size(), std::size_t {record->n_info}) : record->n_info);
     
     for (unsigned i {0}; i < record->n_info; ++i) {
         int nintinfo {0};
@@ -580,6 +822,7 @@ void extract_info(const bcf_hdr_t* header, bcf1_t* record, VcfRecord::Builder& b
         if (key_id >= header->n[BCF_DT_ID]) {
             throw std::runtime_error {"HtslibBcfFacade: found INFO key not present in header file"};
         }
+        if (!is_selected(key_id, selection)) continue;
         
         const char* key {header->id[BCF_DT_ID][key_id].key};
         std::vector<std::string> values {};
@@ -634,13 +877,36 @@ float get_bcf_float_missing() noexcept
     return result;
 }
 
+template <typename T, typename OutputIterator>
+OutputIterator to_bcf_values(const VcfRecord::NumericValues& values, OutputIterator result)
+{
+    // Numeric values need no parsing, which is the bulk of encoding cost for most records
+    return std::transform(std::cbegin(values.values), std::cend(values.values), result,
+                          [] (const double value) { return static_cast<T>(value); });
+}
+
 void set_info(const bcf_hdr_t* header, bcf1_t* dest, const VcfRecord& source)
 {
     for (const auto& key : source.info_keys()) {
+        static constexpr std::size_t defaultBufferCapacity {100};
+        const auto type = bcf_hdr_id2type(header, BCF_HL_INFO, bcf_hdr_id2int(header, BCF_DT_ID, key.c_str()));
+        const auto numeric_values = source.numeric_info_value(key);
+        if (numeric_values && (type == BCF_HT_INT || type == BCF_HT_REAL)) {
+            const auto num_values = static_cast<int>(numeric_values->values.size());
+            if (type == BCF_HT_INT) {
+                bc::small_vector<int, defaultBufferCapacity> vals(num_values);
+                to_bcf_values<int>(*numeric_values, std::begin(vals));
+                bcf_update_info_int32(header, dest, key.c_str(), vals.data(), num_values);
+            } else {
+                bc::small_vector<float, defaultBufferCapacity> vals(num_values);
+                to_bcf_values<float>(*numeric_values, std::begin(vals));
+                bcf_update_info_float(header, dest, key.c_str(), vals.data(), num_values);
+            }
+            continue;
+        }
         const auto& values    = source.info_value(key);
         const auto num_values = static_cast<int>(values.size());
-        static constexpr std::size_t defaultBufferCapacity {100};
-        switch (bcf_hdr_id2type(header, BCF_HL_INFO, bcf_hdr_id2int(header, BCF_DT_ID, key.c_str()))) {
+        switch (type) {
             case BCF_HT_INT:
             {
                 bc::small_vector<int, defaultBufferCapacity> vals(num_values);
@@ -678,7 +944,7 @@ bool has_samples(const bcf_hdr_t* header)
     return bcf_hdr_nsamples(header) > 0;
 }
 
-auto extract_format(const bcf_hdr_t* header, const bcf1_t* record)
+auto extract_format(const bcf_hdr_t* header, const bcf1_t* record, const boost::optional<std::vector<int>>& selection)
 {
     std::vector<VcfRecord::KeyType> result {};
     result.reserve(record->n_fmt);
@@ -687,18 +953,21 @@ auto extract_format(const bcf_hdr_t* header, const bcf1_t* record)
         if (key_id >= header->n[BCF_DT_ID]) {
             throw std::runtime_error {"HtslibBcfFacade: found FORMAT key not present in header file"};
         }
-        result.emplace_back(header->id[BCF_DT_ID][key_id].key);
+        if (is_selected(key_id, selection)) {
+            result.emplace_back(header->id[BCF_DT_ID][key_id].key);
+        }
     }
     return result;
 }
 
-void extract_samples(const bcf_hdr_t* header, bcf1_t* record, VcfRecord::Builder& builder)
+void extract_samples(const bcf_hdr_t* header, bcf1_t* record, VcfRecord::Builder& builder,
+                     const boost::optional<std::vector<int>>& selection)
 {
-    auto format = extract_format(header, record);
+    auto format = extract_format(header, record, selection);
     const auto num_samples = record->n_sample;
     builder.reserve_samples(num_samples);
     auto first_format = std::cbegin(format);
-    if (format.front() == vcfspec::format::genotype) { // the first key must be GT if present
+    if (!format.empty() && format.front() == vcfspec::format::genotype) { // the first key must be GT if present
         int ngt {}, g {};
         int* gt {nullptr};
         bcf_get_genotypes(header, record, &gt, &ngt); // mallocs gt
@@ -870,11 +1139,19 @@ void set_samples(const bcf_hdr_t* header, bcf1_t* dest, const VcfRecord& source,
               bc::small_vector<int, defaultValueCapacity> typed_values(num_values);
               auto value_itr = std::begin(typed_values);
               for (const auto& sample : samples) {
-                  const auto& values = source.get_sample_value(sample, key);
-                  value_itr = std::transform(std::cbegin(values), std::cend(values), value_itr,
-                                             [] (const auto& v) { return !is_missing(v) ? std::stoi(v) : bcf_int32_missing; });
-                  assert(values.size() <= num_values_per_sample);
-                  value_itr = std::fill_n(value_itr, num_values_per_sample - values.size(), pad);
+                  const auto numeric_values = source.get_numeric_sample_value(sample, key);
+                  std::size_t num_sample_values;
+                  if (numeric_values) {
+                      value_itr = to_bcf_values<int>(*numeric_values, value_itr);
+                      num_sample_values = numeric_values->values.size();
+                  } else {
+                      const auto& values = source.get_sample_value(sample, key);
+                      value_itr = std::transform(std::cbegin(values), std::cend(values), value_itr,
+                                                 [] (const auto& v) { return !is_missing(v) ? std::stoi(v) : bcf_int32_missing; });
+                      num_sample_values = values.size();
+                  }
+                  assert(num_sample_values <= num_values_per_sample);
+                  value_itr = std::fill_n(value_itr, num_values_per_sample - num_sample_values, pad);
               }
               bcf_update_format_int32(header, dest, key.c_str(), typed_values.data(), num_values);
               break;
@@ -885,11 +1162,19 @@ void set_samples(const bcf_hdr_t* header, bcf1_t* dest, const VcfRecord& source,
               bc::small_vector<float, defaultValueCapacity> typed_values(num_values);
               auto value_itr = std::begin(typed_values);
               for (const auto& sample : samples) {
-                  const auto& values = source.get_sample_value(sample, key);
-                  value_itr = std::transform(std::cbegin(values), std::cend(values), value_itr,
-                                             [] (const auto& v) { return !is_missing(v) ? std::stof(v) : get_bcf_float_missing(); });
-                  assert(values.size() <= num_values_per_sample);
-                  value_itr = std::fill_n(value_itr, num_values_per_sample - values.size(), pad);
+                  const auto numeric_values = source.get_numeric_sample_value(sample, key);
+                  std::size_t num_sample_values;
+                  if (numeric_values) {
+                      value_itr = to_bcf_values<float>(*numeric_values, value_itr);
+                      num_sample_values = numeric_values->values.size();
+                  } else {
+                      const auto& values = source.get_sample_value(sample, key);
+                      value_itr = std::transform(std::cbegin(values), std::cend(values), value_itr,
+                                                 [] (const auto& v) { return !is_missing(v) ? std::stof(v) : get_bcf_float_missing(); });
+                      num_sample_values = values.size();
+                  }
+                  assert(num_sample_values <= num_values_per_sample);
+                  value_itr = std::fill_n(value_itr, num_values_per_sample - num_sample_values, pad);
               }
               bcf_update_format_float(header, dest, key.c_str(), typed_values.data(), num_values);
               break;
@@ -930,10 +1215,45 @@ std::size_t HtslibBcfFacade::count_records(HtsBcfSrPtr& sr) const
     return result;
 }
 
-VcfRecord HtslibBcfFacade::fetch_record(const bcf_srs_t* sr, UnpackPolicy level) const
+namespace {
+
+bool is_empty(const boost::optional<std::vector<int>>& selection) noexcept
+{
+    return selection && selection->empty();
+}
+
+void add_ids(const bcf_hdr_t* header, const std::vector<std::string>& keys, std::vector<int>& result)
+{
+    result.reserve(keys.size());
+    for (const auto& key : keys) {
+        const auto id = bcf_hdr_id2int(header, BCF_DT_ID, key.c_str());
+        if (id >= 0) result.push_back(id); // keys missing from the header are never present in records
+    }
+}
+
+} // namespace
+
+HtslibBcfFacade::FieldIds HtslibBcfFacade::get_field_ids(const UnpackPolicy level) const
+{
+    FieldIds result {};
+    if (level == UnpackPolicy::sites) result.format = std::vector<int> {};
+    return result;
+}
+
+HtslibBcfFacade::FieldIds HtslibBcfFacade::get_field_ids(const UnpackFields& fields) const
+{
+    FieldIds result {std::vector<int> {}, std::vector<int> {}};
+    add_ids(header_.get(), fields.info, *result.info);
+    add_ids(header_.get(), fields.format, *result.format);
+    return result;
+}
+
+VcfRecord HtslibBcfFacade::fetch_record(const bcf_srs_t* sr, const FieldIds& fields) const
 {
     auto hts_record = bcf_sr_get_line(sr, 0);
-    bcf_unpack(hts_record, level == UnpackPolicy::all ? BCF_UN_ALL : BCF_UN_SHR);
+    const bool unpack_info {!is_empty(fields.info)};
+    const bool unpack_samples {!is_empty(fields.format) && has_samples(header_.get())};
+    bcf_unpack(hts_record, BCF_UN_STR | BCF_UN_FLT | (unpack_info ? BCF_UN_INFO : 0) | (unpack_samples ? BCF_UN_FMT : 0));
     VcfRecord::Builder record_builder {};
     extract_chrom(header_.get(), hts_record, record_builder);
     extract_pos(hts_record, record_builder);
@@ -942,20 +1262,22 @@ VcfRecord HtslibBcfFacade::fetch_record(const bcf_srs_t* sr, UnpackPolicy level)
     extract_alt(hts_record, record_builder);
     extract_qual(hts_record, record_builder);
     extract_filter(header_.get(), hts_record, record_builder);
-    extract_info(header_.get(), hts_record, record_builder);
-    if (level == UnpackPolicy::all && has_samples(header_.get())) {
-        extract_samples(header_.get(), hts_record, record_builder);
+    if (unpack_info) {
+        extract_info(header_.get(), hts_record, record_builder, fields.info);
+    }
+    if (unpack_samples) {
+        extract_samples(header_.get(), hts_record, record_builder, fields.format);
     }
     return record_builder.build_once();
 }
 
 HtslibBcfFacade::RecordContainer
-HtslibBcfFacade::fetch_records(bcf_srs_t* sr, const UnpackPolicy level, const std::size_t num_records) const
+HtslibBcfFacade::fetch_records(bcf_srs_t* sr, const FieldIds& fields, const std::size_t num_records) const
 {
     RecordContainer result {};
     result.reserve(num_records);
     while (bcf_sr_next_line(sr)) {
-        result.push_back(fetch_record(sr, level));
+        result.push_back(fetch_record(sr, fields));
     }
     return result;
 }
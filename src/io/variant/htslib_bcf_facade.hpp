@@ -5,16 +5,21 @@
 #define htslib_bcf_facade_hpp
 
 #include <string>
+#include <vector>
 #include <set>
 #include <memory>
 #include <cstddef>
 #include <iterator>
 
 #include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
 
 #include "htslib/hts.h"
 #include "htslib/vcf.h"
 #include "htslib/synced_bcf_reader.h"
+#include "htslib/tbx.h"
+
+#include "io/read/htslib_thread_pool.hpp"
 
 #include "vcf_reader_impl.hpp"
 #include "vcf_record.hpp"
@@ -29,6 +34,7 @@ class HtslibBcfFacade : public IVcfReaderImpl
 public:
     using Path = boost::filesystem::path;
     using IVcfReaderImpl::UnpackPolicy;
+    using IVcfReaderImpl::UnpackFields;
     using IVcfReaderImpl::RecordContainer;
     using IVcfReaderImpl::RecordIteratorPtrPair;
     class RecordIterator;
@@ -37,6 +43,8 @@ public:
     
     HtslibBcfFacade(); // write only, goes to stdout
     HtslibBcfFacade(Path file_path, Mode mode = Mode::read);
+    // Written BGZF blocks are compressed on the given pool, which may be shared with other files
+    HtslibBcfFacade(Path file_path, Mode mode, std::shared_ptr<const io::HtslibThreadPool> thread_pool);
     
     HtslibBcfFacade(const HtslibBcfFacade&)            = delete;
     HtslibBcfFacade& operator=(const HtslibBcfFacade&) = delete;
@@ -53,9 +61,13 @@ public:
     std::size_t count_records(const std::string& contig) const override;
     std::size_t count_records(const GenomicRegion& region) const override;
     
+    boost::optional<std::vector<std::string>> fetch_indexed_contigs() const override;
+    
     RecordIteratorPtrPair iterate(UnpackPolicy level) const override;
     RecordIteratorPtrPair iterate(const std::string& contig, UnpackPolicy level) const override;
     RecordIteratorPtrPair iterate(const GenomicRegion& region, UnpackPolicy level) const override;
+    RecordIteratorPtrPair iterate(const UnpackFields& fields) const override;
+    RecordIteratorPtrPair iterate(const GenomicRegion& region, const UnpackFields& fields) const override;
     
     RecordContainer fetch_records(UnpackPolicy level) const override;
     RecordContainer fetch_records(const std::string& contig, UnpackPolicy level) const override;
@@ -64,6 +76,12 @@ public:
     void write(const VcfHeader& header);
     void write(const VcfRecord& record);
     
+    // Appends the records in source_path, which must already be closed, without decoding them: compressed
+    // blocks are copied verbatim unless BCF contig ids need rewriting. Returns false, having written
+    // nothing, unless both files are BGZF compressed in the same format with the same samples and
+    // field definitions, and this header has all of the source's contigs.
+    bool append_compressed(const Path& source_path);
+    
 private:
     struct HtsFileDeleter
     {
@@ -81,18 +99,36 @@ private:
     {
         void operator()(bcf1_t* bcf1) const { bcf_destroy(bcf1); }
     };
+    struct HtsIndexDeleter
+    {
+        void operator()(hts_idx_t* index) const { hts_idx_destroy(index); }
+    };
+    struct HtsTbxDeleter
+    {
+        void operator()(tbx_t* index) const { tbx_destroy(index); }
+    };
     
     using HtsBcfSrPtr = std::unique_ptr<bcf_srs_t, HtsSrsDeleter>;
     using HtsBcf1Ptr  = std::unique_ptr<bcf1_t, HtsBcf1Deleter>;
     
+    // Header ids of the INFO and FORMAT fields to decode, boost::none meaning all of them
+    struct FieldIds
+    {
+        boost::optional<std::vector<int>> info, format;
+    };
+    
     Path file_path_;
+    std::shared_ptr<const io::HtslibThreadPool> thread_pool_; // must outlive file_
     std::unique_ptr<htsFile, HtsFileDeleter> file_;
     std::unique_ptr<bcf_hdr_t, HtsHeaderDeleter> header_;
     std::vector<std::string> samples_;
+    HtsBcf1Ptr write_buffer_;
     
     std::size_t count_records(HtsBcfSrPtr& sr) const;
-    VcfRecord fetch_record(const bcf_srs_t* sr, UnpackPolicy level) const;
-    RecordContainer fetch_records(bcf_srs_t*, UnpackPolicy level, size_t num_records) const;
+    FieldIds get_field_ids(UnpackPolicy level) const;
+    FieldIds get_field_ids(const UnpackFields& fields) const;
+    VcfRecord fetch_record(const bcf_srs_t* sr, const FieldIds& fields) const;
+    RecordContainer fetch_records(bcf_srs_t*, const FieldIds& fields, size_t num_records) const;
     
     friend RecordIterator;
 };
@@ -107,7 +143,7 @@ public:
     using reference         = const VcfRecord&;
     
     RecordIterator(const HtslibBcfFacade& facade);
-    RecordIterator(const HtslibBcfFacade& facade, HtsBcfSrPtr hts_iterator, UnpackPolicy level);
+    RecordIterator(const HtslibBcfFacade& facade, HtsBcfSrPtr hts_iterator, FieldIds fields);
     
     RecordIterator(const RecordIterator&)            = default;
     RecordIterator& operator=(const RecordIterator&) = default;
@@ -135,7 +171,7 @@ private:
     std::reference_wrapper<const HtslibBcfFacade> facade_;
     
     HtsBcfSrSharedPtr hts_iterator_;
-    UnpackPolicy level_;
+    FieldIds fields_;
     
     std::shared_ptr<VcfRecord> record_;
 };
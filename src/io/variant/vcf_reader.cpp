@@ -187,6 +187,12 @@ std::size_t VcfReader::count_records(const GenomicRegion& region) const
     return reader_->count_records(region);
 }
 
+boost::optional<std::vector<std::string>> VcfReader::fetch_indexed_contigs() const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    return reader_->fetch_indexed_contigs();
+}
+
 VcfReader::RecordContainer VcfReader::fetch_records(const UnpackPolicy level) const
 {
     std::lock_guard<std::mutex> lock {mutex_};
@@ -226,6 +232,20 @@ VcfReader::RecordIteratorPair VcfReader::iterate(const GenomicRegion& region, co
     return std::make_pair(std::move(p.first), std::move(p.second));
 }
 
+VcfReader::RecordIteratorPair VcfReader::iterate(const UnpackFields& fields) const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    auto p = reader_->iterate(fields);
+    return std::make_pair(std::move(p.first), std::move(p.second));
+}
+
+VcfReader::RecordIteratorPair VcfReader::iterate(const GenomicRegion& region, const UnpackFields& fields) const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    auto p = reader_->iterate(region, fields);
+    return std::make_pair(std::move(p.first), std::move(p.second));
+}
+
 // non member methods
 
 bool operator==(const VcfReader& lhs, const VcfReader& rhs)
@@ -29,6 +29,7 @@ class VcfReader
 public:
     using Path = boost::filesystem::path;
     using UnpackPolicy = IVcfReaderImpl::UnpackPolicy;
+    using UnpackFields = IVcfReaderImpl::UnpackFields;
     using RecordContainer = IVcfReaderImpl::RecordContainer;
     
     class RecordIterator;
@@ -59,6 +60,8 @@ public:
     std::size_t count_records(const std::string& contig) const;
     std::size_t count_records(const GenomicRegion& region) const;
     
+    boost::optional<std::vector<std::string>> fetch_indexed_contigs() const;
+    
     RecordContainer fetch_records(UnpackPolicy level = UnpackPolicy::all) const;
     RecordContainer fetch_records(const std::string& contig, UnpackPolicy level = UnpackPolicy::all) const;
     RecordContainer fetch_records(const GenomicRegion& region, UnpackPolicy level = UnpackPolicy::all) const;
@@ -66,6 +69,8 @@ public:
     RecordIteratorPair iterate(UnpackPolicy level = UnpackPolicy::all) const;
     RecordIteratorPair iterate(const std::string& contig, UnpackPolicy level = UnpackPolicy::all) const;
     RecordIteratorPair iterate(const GenomicRegion& region, UnpackPolicy level = UnpackPolicy::all) const;
+    RecordIteratorPair iterate(const UnpackFields& fields) const;
+    RecordIteratorPair iterate(const GenomicRegion& region, const UnpackFields& fields) const;
     
 private:
     Path file_path_;
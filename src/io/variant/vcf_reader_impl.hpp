@@ -10,6 +10,8 @@
 #include <memory>
 #include <utility>
 
+#include <boost/optional.hpp>
+
 namespace octopus {
 
 class GenomicRegion;
@@ -21,6 +23,12 @@ class IVcfReaderImpl
 public:
     enum class UnpackPolicy { all, sites };
     
+    // Only the named INFO and FORMAT fields are decoded; CHROM to FILTER always are
+    struct UnpackFields
+    {
+        std::vector<std::string> info = {}, format = {};
+    };
+    
     using RecordContainer = std::vector<VcfRecord>;
     
     class RecordIterator
@@ -53,6 +61,9 @@ public:
     virtual std::size_t count_records(const std::string& contig) const = 0;
     virtual std::size_t count_records(const GenomicRegion& region) const = 0;
     
+    // The contigs named in the file's index, or none if the file is not indexed
+    virtual boost::optional<std::vector<std::string>> fetch_indexed_contigs() const { return boost::none; }
+    
     virtual RecordContainer fetch_records(UnpackPolicy level) const = 0; // fetches all records
     virtual RecordContainer fetch_records(const std::string& contig, UnpackPolicy level) const = 0;
     virtual RecordContainer fetch_records(const GenomicRegion& region, UnpackPolicy level) const = 0;
@@ -61,6 +72,13 @@ public:
     virtual RecordIteratorPtrPair iterate(const std::string& contig, UnpackPolicy level) const  = 0;
     virtual RecordIteratorPtrPair iterate(const GenomicRegion& region, UnpackPolicy level) const = 0;
     
+    // Implementations that cannot decode fields selectively decode everything
+    virtual RecordIteratorPtrPair iterate(const UnpackFields& fields) const { return iterate(UnpackPolicy::all); }
+    virtual RecordIteratorPtrPair iterate(const GenomicRegion& region, const UnpackFields& fields) const
+    {
+        return iterate(region, UnpackPolicy::all);
+    }
+    
     virtual ~IVcfReaderImpl() noexcept = default;
 };
 
@@ -8,6 +8,7 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include "utils/maths.hpp"
 #include "vcf_spec.hpp"
 
 namespace octopus {
@@ -86,6 +87,13 @@ const std::vector<VcfRecord::ValueType>& VcfRecord::info_value(const KeyType& ke
     return info_.at(key);
 }
 
+boost::optional<const VcfRecord::NumericValues&> VcfRecord::numeric_info_value(const KeyType& key) const noexcept
+{
+    const auto itr = numeric_info_.find(key);
+    if (itr != std::cend(numeric_info_)) return itr->second;
+    return boost::none;
+}
+
 bool VcfRecord::has_format(const KeyType& key) const noexcept
 {
     return std::find(std::cbegin(format_), std::cend(format_), key) != std::cend(format_);
@@ -177,6 +185,17 @@ const std::vector<VcfRecord::ValueType>& VcfRecord::get_sample_value(const Sampl
     return (key == vcfspec::format::genotype) ? genotypes_.at(sample).first : samples_.at(sample).at(key);
 }
 
+boost::optional<const VcfRecord::NumericValues&>
+VcfRecord::get_numeric_sample_value(const SampleName& sample, const KeyType& key) const noexcept
+{
+    const auto sample_itr = numeric_samples_.find(sample);
+    if (sample_itr != std::cend(numeric_samples_)) {
+        const auto itr = sample_itr->second.find(key);
+        if (itr != std::cend(sample_itr->second)) return itr->second;
+    }
+    return boost::none;
+}
+
 // helper non-members needed for printing
 
 namespace {
@@ -411,6 +430,21 @@ std::ostream& operator<<(std::ostream& os, const VcfRecord& record)
 
 // VcfRecord::Builder
 
+namespace {
+
+auto to_strings(const VcfRecord::NumericValues& values)
+{
+    std::vector<VcfRecord::ValueType> result {};
+    result.reserve(values.values.size());
+    std::transform(std::cbegin(values.values), std::cend(values.values), std::back_inserter(result),
+                   [&] (const double value) {
+                       return values.is_integer ? std::to_string(static_cast<long long>(value)) : std::to_string(value);
+                   });
+    return result;
+}
+
+} // namespace
+
 VcfRecord::Builder::Builder(const VcfRecord& call)
 : chrom_ {call.chrom()}
 , pos_ {call.pos()}
@@ -423,6 +457,8 @@ VcfRecord::Builder::Builder(const VcfRecord& call)
 , format_ {call.format()}
 , genotypes_ {call.genotypes_}
 , samples_ {call.samples_}
+, numeric_info_ {call.numeric_info_}
+, numeric_samples_ {call.numeric_samples_}
 {}
 
 VcfRecord::Builder& VcfRecord::Builder::set_chrom(std::string name)
@@ -530,10 +566,25 @@ VcfRecord::Builder& VcfRecord::Builder::set_info(const KeyType& key, const Value
 
 VcfRecord::Builder& VcfRecord::Builder::set_info(const KeyType& key, std::vector<ValueType> values)
 {
+    numeric_info_.erase(key);
     info_[key] = std::move(values);
     return *this;
 }
 
+VcfRecord::Builder& VcfRecord::Builder::set_info(const KeyType& key, NumericValues values)
+{
+    info_[key] = to_strings(values);
+    numeric_info_[key] = std::move(values);
+    return *this;
+}
+
+VcfRecord::Builder& VcfRecord::Builder::set_info(const KeyType& key, const double value, const unsigned precision)
+{
+    info_[key] = {utils::to_string(value, precision)};
+    numeric_info_[key] = NumericValues {{maths::round(value, precision)}, false};
+    return *this;
+}
+
 VcfRecord::Builder& VcfRecord::Builder::set_info(const KeyType& key, std::initializer_list<ValueType> values)
 {
     return this->set_info(key, std::vector<ValueType> {values});
@@ -552,12 +603,14 @@ VcfRecord::Builder& VcfRecord::Builder::set_info_missing(const KeyType& key)
 VcfRecord::Builder& VcfRecord::Builder::clear_info() noexcept
 {
     info_.clear();
+    numeric_info_.clear();
     return *this;
 }
 
 VcfRecord::Builder& VcfRecord::Builder::clear_info(const KeyType& key)
 {
     info_.erase(key);
+    numeric_info_.erase(key);
     return *this;
 }
 
@@ -627,10 +680,21 @@ VcfRecord::Builder& VcfRecord::Builder::set_format(const SampleName& sample, con
 
 VcfRecord::Builder& VcfRecord::Builder::set_format(const SampleName& sample, const KeyType& key, std::vector<ValueType> values)
 {
+    const auto numeric_sample_itr = numeric_samples_.find(sample);
+    if (numeric_sample_itr != std::end(numeric_samples_)) {
+        numeric_sample_itr->second.erase(key);
+    }
     samples_[sample][key] = std::move(values);
     return *this;
 }
 
+VcfRecord::Builder& VcfRecord::Builder::set_format(const SampleName& sample, const KeyType& key, NumericValues values)
+{
+    samples_[sample][key] = to_strings(values);
+    numeric_samples_[sample][key] = std::move(values);
+    return *this;
+}
+
 VcfRecord::Builder& VcfRecord::Builder::set_format(const SampleName& sample, const KeyType& key, std::initializer_list<ValueType> values)
 {
     return this->set_format(sample, key, std::vector<ValueType> {values});
@@ -645,6 +709,7 @@ VcfRecord::Builder& VcfRecord::Builder::clear_format() noexcept
 {
     format_.clear();
     samples_.clear();
+    numeric_samples_.clear();
     genotypes_.clear();
     return *this;
 }
@@ -652,6 +717,7 @@ VcfRecord::Builder& VcfRecord::Builder::clear_format() noexcept
 VcfRecord::Builder& VcfRecord::Builder::clear_format(const SampleName& sample) noexcept
 {
     samples_.erase(sample);
+    numeric_samples_.erase(sample);
     genotypes_.erase(sample);
     return *this;
 }
@@ -662,6 +728,10 @@ VcfRecord::Builder& VcfRecord::Builder::clear_format(const SampleName& sample, c
     if (sample_itr != std::cend(samples_)) {
         sample_itr->second.erase(key);
     }
+    const auto numeric_sample_itr = numeric_samples_.find(sample);
+    if (numeric_sample_itr != std::cend(numeric_samples_)) {
+        numeric_sample_itr->second.erase(key);
+    }
     return *this;
 }
 
@@ -718,23 +788,31 @@ GenomicRegion::Position VcfRecord::Builder::pos() const noexcept
 
 VcfRecord VcfRecord::Builder::build() const
 {
+    VcfRecord result {};
     if (genotypes_.empty() && samples_.empty()) {
-        return VcfRecord {chrom_, pos_, id_, ref_, alt_, qual_, filter_, info_};
+        result = VcfRecord {chrom_, pos_, id_, ref_, alt_, qual_, filter_, info_};
     } else {
-        return VcfRecord {chrom_, pos_, id_, ref_, alt_, qual_, filter_, info_, format_, genotypes_, samples_};
+        result = VcfRecord {chrom_, pos_, id_, ref_, alt_, qual_, filter_, info_, format_, genotypes_, samples_};
+        result.numeric_samples_ = numeric_samples_;
     }
+    result.numeric_info_ = numeric_info_;
+    return result;
 }
 
 VcfRecord VcfRecord::Builder::build_once() noexcept
 {
+    VcfRecord result {};
     if (genotypes_.empty() && samples_.empty()) {
-        return VcfRecord {std::move(chrom_), pos_, std::move(id_), std::move(ref_),
-                          std::move(alt_), qual_, std::move(filter_), std::move(info_)};
+        result = VcfRecord {std::move(chrom_), pos_, std::move(id_), std::move(ref_),
+                            std::move(alt_), qual_, std::move(filter_), std::move(info_)};
     } else {
-        return VcfRecord {std::move(chrom_), pos_, std::move(id_), std::move(ref_),
-                          std::move(alt_), qual_, std::move(filter_), std::move(info_),
-                          std::move(format_), std::move(genotypes_), std::move(samples_)};
+        result = VcfRecord {std::move(chrom_), pos_, std::move(id_), std::move(ref_),
+                            std::move(alt_), qual_, std::move(filter_), std::move(info_),
+                            std::move(format_), std::move(genotypes_), std::move(samples_)};
+        result.numeric_samples_ = std::move(numeric_samples_);
     }
+    result.numeric_info_ = std::move(numeric_info_);
+    return result;
 }
 
 } // namespace octopus
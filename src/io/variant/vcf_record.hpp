@@ -13,6 +13,7 @@
 #include <utility>
 #include <initializer_list>
 #include <functional>
+#include <type_traits>
 
 #include <boost/optional.hpp>
 #include <boost/container/flat_map.hpp>
@@ -37,6 +38,16 @@ public:
     using KeyType            = std::string;
     using ValueType          = std::string;
     
+    // INFO and FORMAT values set from numbers are also kept in binary form so writers can encode them without
+    // parsing the formatted strings. They are still formatted when set, as the string accessors return references
+    // and records are sorted and merged as VcfRecord before writing, so a separate typed record was not introduced.
+    // The cost is one to_string and one small vector per numeric field; nearly all of these fields are integers.
+    struct NumericValues
+    {
+        std::vector<double> values;
+        bool is_integer;
+    };
+    
     VcfRecord() = default;
     
     // Constructor without genotype fields
@@ -78,6 +89,7 @@ public:
     bool has_info(const KeyType& key) const noexcept;
     std::vector<KeyType> info_keys() const;
     const std::vector<ValueType>& info_value(const KeyType& key) const;
+    boost::optional<const NumericValues&> numeric_info_value(const KeyType& key) const noexcept;
     
     //
     // Sample releated functions
@@ -96,6 +108,7 @@ public:
     bool has_ref_allele(const SampleName& sample) const;
     bool has_alt_allele(const SampleName& sample) const;
     const std::vector<ValueType>& get_sample_value(const SampleName& sample, const KeyType& key) const;
+    boost::optional<const NumericValues&> get_numeric_sample_value(const SampleName& sample, const KeyType& key) const noexcept;
     
     friend std::ostream& operator<<(std::ostream& os, const VcfRecord& record);
     friend Builder;
@@ -103,6 +116,7 @@ public:
 private:
     using Genotype = std::pair<std::vector<NucleotideSequence>, bool>;
     using ValueMap = boost::container::flat_map<KeyType, std::vector<ValueType>>;
+    using NumericValueMap = boost::container::flat_map<KeyType, NumericValues>;
     
     // mandatory fields
     GenomicRegion region_;
@@ -112,11 +126,13 @@ private:
     boost::optional<QualityType> qual_;
     std::vector<KeyType> filter_;
     ValueMap info_;
+    NumericValueMap numeric_info_;
     
     // optional fields
     std::vector<KeyType> format_;
     boost::container::flat_map<SampleName, Genotype> genotypes_;
     boost::container::flat_map<SampleName, ValueMap> samples_;
+    boost::container::flat_map<SampleName, NumericValueMap> numeric_samples_;
     
     std::string get_allele_number(const NucleotideSequence& allele) const;
     
@@ -157,6 +173,7 @@ public:
     using SampleName         = VcfRecord::SampleName;
     using KeyType            = VcfRecord::KeyType;
     using ValueType          = VcfRecord::ValueType;
+    using NumericValues      = VcfRecord::NumericValues;
     
     enum class Phasing { phased, unphased };
     
@@ -186,8 +203,11 @@ public:
     Builder& reserve_info(unsigned n);
     Builder& add_info(const KeyType& key); // flags
     Builder& set_info(const KeyType& key, const ValueType& value);
-    template <typename T> Builder& set_info(const KeyType& key, const T& value); // calls std::to_string
+    template <typename T> Builder& set_info(const KeyType& key, const T& value); // numbers are kept in binary form, otherwise calls to_string
+    template <typename T> Builder& set_info(const KeyType& key, const std::vector<T>& values); // numbers only
     Builder& set_info(const KeyType& key, std::vector<ValueType> values);
+    Builder& set_info(const KeyType& key, NumericValues values);
+    Builder& set_info(const KeyType& key, double value, unsigned precision); // fixed number of decimal places
     Builder& set_info(const KeyType& key, std::initializer_list<ValueType> values);
     Builder& set_info_flag(KeyType key);
     Builder& set_info_missing(const KeyType& key);
@@ -204,8 +224,11 @@ public:
     Builder& clear_genotype(const SampleName& sample) noexcept;
     Builder& set_format(const SampleName& sample, const KeyType& key, const ValueType& value);
     template <typename T>
-    Builder& set_format(const SampleName& sample, const KeyType& key, const T& value); // calls std::to_string
+    Builder& set_format(const SampleName& sample, const KeyType& key, const T& value); // numbers are kept in binary form, otherwise calls to_string
+    template <typename T>
+    Builder& set_format(const SampleName& sample, const KeyType& key, const std::vector<T>& values); // numbers only
     Builder& set_format(const SampleName& sample, const KeyType& key, std::vector<ValueType> values);
+    Builder& set_format(const SampleName& sample, const KeyType& key, NumericValues values);
     Builder& set_format(const SampleName& sample, const KeyType& key, std::initializer_list<ValueType> values);
     Builder& set_format_missing(const SampleName& sample, const KeyType& key);
     Builder& clear_format() noexcept;
@@ -239,6 +262,12 @@ private:
     decltype(VcfRecord::format_) format_ = {};
     decltype(VcfRecord::genotypes_) genotypes_ = {};
     decltype(VcfRecord::samples_) samples_ = {};
+    decltype(VcfRecord::numeric_info_) numeric_info_ = {};
+    decltype(VcfRecord::numeric_samples_) numeric_samples_ = {};
+    
+    template <typename T> static NumericValues to_values(const T& value, std::true_type);
+    template <typename T> static ValueType to_values(const T& value, std::false_type);
+    template <typename T> static NumericValues to_values(const std::vector<T>& values);
 };
 
 template <typename String1, typename String2, typename Sequence1, typename Sequence2,
@@ -275,17 +304,47 @@ VcfRecord::VcfRecord(String1&& chrom, GenomicRegion::Position pos, String2&& id,
 {}
 
 template <typename T>
-VcfRecord::Builder& VcfRecord::Builder::set_info(const KeyType& key, const T& value)
+VcfRecord::NumericValues VcfRecord::Builder::to_values(const T& value, std::true_type)
+{
+    return {{static_cast<double>(value)}, std::is_integral<T>::value};
+}
+
+template <typename T>
+VcfRecord::ValueType VcfRecord::Builder::to_values(const T& value, std::false_type)
 {
     using std::to_string;
-    return set_info(key, to_string(value));
+    return to_string(value);
+}
+
+template <typename T>
+VcfRecord::NumericValues VcfRecord::Builder::to_values(const std::vector<T>& values)
+{
+    static_assert(std::is_arithmetic<T>::value, "values must be numbers");
+    return {std::vector<double>(std::cbegin(values), std::cend(values)), std::is_integral<T>::value};
+}
+
+template <typename T>
+VcfRecord::Builder& VcfRecord::Builder::set_info(const KeyType& key, const T& value)
+{
+    return set_info(key, to_values(value, std::is_arithmetic<T> {}));
+}
+
+template <typename T>
+VcfRecord::Builder& VcfRecord::Builder::set_info(const KeyType& key, const std::vector<T>& values)
+{
+    return set_info(key, to_values(values));
 }
 
 template <typename T>
 VcfRecord::Builder& VcfRecord::Builder::set_format(const SampleName& sample, const KeyType& key, const T& value)
 {
-    using std::to_string;
-    return set_format(sample, key, to_string(value));
+    return set_format(sample, key, to_values(value, std::is_arithmetic<T> {}));
+}
+
+template <typename T>
+VcfRecord::Builder& VcfRecord::Builder::set_format(const SampleName& sample, const KeyType& key, const std::vector<T>& values)
+{
+    return set_format(sample, key, to_values(values));
 }
 
 } // namespace octopus
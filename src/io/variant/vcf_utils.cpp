@@ -12,6 +12,7 @@
 #include <functional>
 #include <stdexcept>
 #include <numeric>
+#include <future>
 
 #include "htslib/vcf.h"
 #include "htslib/tbx.h"
@@ -415,6 +416,40 @@ void merge(const std::vector<VcfReader>& sources, VcfWriter& dst,
     }
 }
 
+namespace {
+
+// Decodes the next batch of records while the previous one is written
+void stream_records(const VcfReader& src, VcfWriter& dst)
+{
+    constexpr std::size_t batchSize {10000};
+    auto p = src.iterate();
+    const auto read_batch = [&p] () {
+        std::vector<VcfRecord> result {};
+        result.reserve(batchSize);
+        for (; p.first != p.second && result.size() < batchSize; ++p.first) {
+            result.push_back(*p.first);
+        }
+        return result;
+    };
+    auto batch = read_batch();
+    while (!batch.empty()) {
+        auto next_batch = std::async(std::launch::async, read_batch);
+        dst << batch;
+        batch = next_batch.get();
+    }
+}
+
+} // namespace
+
+void concatenate(const std::vector<boost::filesystem::path>& sources, VcfWriter& dst)
+{
+    for (const auto& source : sources) {
+        if (!dst.append_compressed(source)) {
+            stream_records(VcfReader {source}, dst);
+        }
+    }
+}
+
 void merge(const std::vector<VcfReader>& sources, VcfWriter& dst)
 {
     if (sources.empty()) return;
@@ -47,6 +47,10 @@ void merge(const std::vector<VcfReader>& sources, VcfWriter& dst,
 
 void merge(const std::vector<VcfReader>& sources, VcfWriter& dst);
 
+// Appends all records of each (closed) source in turn to dst, which must have a header. Sources encoded
+// identically to dst are appended without decoding; any others are decoded and rewritten.
+void concatenate(const std::vector<boost::filesystem::path>& sources, VcfWriter& dst);
+
 void convert_to_legacy(const VcfReader& src, VcfWriter& dst, bool remove_ref_pad_duplicates = true);
 
 } // namespace octopus    
@@ -17,10 +17,11 @@ namespace octopus {
 
 namespace {
 
-auto make_vcf_writer(boost::optional<VcfWriter::Path> path = boost::none)
+auto make_vcf_writer(boost::optional<VcfWriter::Path> path = boost::none,
+                     std::shared_ptr<const VcfWriter::ThreadPool> compression_pool = nullptr)
 {
     if (path) {
-        return std::make_unique<HtslibBcfFacade>(std::move(*path), HtslibBcfFacade::Mode::write);
+        return std::make_unique<HtslibBcfFacade>(std::move(*path), HtslibBcfFacade::Mode::write, std::move(compression_pool));
     } else {
         return std::make_unique<HtslibBcfFacade>();
     }
@@ -29,13 +30,23 @@ auto make_vcf_writer(boost::optional<VcfWriter::Path> path = boost::none)
 } // namespace
 
 VcfWriter::VcfWriter()
+: VcfWriter {std::shared_ptr<const ThreadPool> {}}
+{}
+
+VcfWriter::VcfWriter(std::shared_ptr<const ThreadPool> compression_pool)
 : file_path_ {}
+, compression_pool_ {std::move(compression_pool)}
 , writer_ {make_vcf_writer()}
 , is_header_written_ {false}
 {}
 
 VcfWriter::VcfWriter(Path file_path)
+: VcfWriter {std::move(file_path), nullptr}
+{}
+
+VcfWriter::VcfWriter(Path file_path, std::shared_ptr<const ThreadPool> compression_pool)
 : file_path_ {std::move(file_path)}
+, compression_pool_ {std::move(compression_pool)}
 , writer_ {nullptr}
 , is_header_written_ {false}
 {
@@ -59,7 +70,7 @@ VcfWriter::VcfWriter(Path file_path)
     } else if (exists(index_path2)) {
         remove(index_path2);
     }
-    writer_ = make_vcf_writer(*file_path_);
+    writer_ = make_vcf_writer(*file_path_, compression_pool_);
 }
 
 VcfWriter::VcfWriter(const VcfHeader& header)
@@ -69,15 +80,20 @@ VcfWriter::VcfWriter(const VcfHeader& header)
 }
 
 VcfWriter::VcfWriter(Path file_path, const VcfHeader& header)
-: VcfWriter {std::move(file_path)}
+: VcfWriter {std::move(file_path), header, nullptr}
+{}
+
+VcfWriter::VcfWriter(Path file_path, const VcfHeader& header, std::shared_ptr<const ThreadPool> compression_pool)
+: VcfWriter {std::move(file_path), std::move(compression_pool)}
 {
-    write(std::move(header));
+    write(header);
 }
 
 VcfWriter::VcfWriter(VcfWriter&& other)
 {
     std::lock_guard<std::mutex> lock {other.mutex_};
     file_path_         = std::move(other.file_path_);
+    compression_pool_  = std::move(other.compression_pool_);
     is_header_written_ = other.is_header_written_;
     writer_            = std::move(other.writer_);
 }
@@ -88,6 +104,7 @@ VcfWriter& VcfWriter::operator=(VcfWriter&& other)
         std::unique_lock<std::mutex> lock_lhs {mutex_, std::defer_lock}, lock_rhs {other.mutex_, std::defer_lock};
         std::lock(lock_lhs, lock_rhs);
         file_path_         = std::move(other.file_path_);
+        compression_pool_  = std::move(other.compression_pool_);
         is_header_written_ = other.is_header_written_;
         writer_            = std::move(other.writer_);
     }
@@ -113,6 +130,7 @@ void swap(VcfWriter& lhs, VcfWriter& rhs) noexcept
     std::lock_guard<std::mutex> lock_lhs {lhs.mutex_, std::adopt_lock}, lock_rhs {rhs.mutex_, std::adopt_lock};
     using std::swap;
     swap(lhs.file_path_, rhs.file_path_);
+    swap(lhs.compression_pool_, rhs.compression_pool_);
     swap(lhs.is_header_written_, rhs.is_header_written_);
     swap(lhs.writer_, rhs.writer_);
 }
@@ -127,7 +145,16 @@ void VcfWriter::open(Path file_path)
 {
     std::lock_guard<std::mutex> lock {mutex_};
     file_path_         = std::move(file_path);
-    writer_            = make_vcf_writer(*file_path_);
+    writer_            = make_vcf_writer(*file_path_, compression_pool_);
+    is_header_written_ = false;
+}
+
+void VcfWriter::open(Path file_path, std::shared_ptr<const ThreadPool> compression_pool)
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    file_path_         = std::move(file_path);
+    compression_pool_  = std::move(compression_pool);
+    writer_            = make_vcf_writer(*file_path_, compression_pool_);
     is_header_written_ = false;
 }
 
@@ -149,6 +176,12 @@ boost::optional<VcfWriter::Path> VcfWriter::path() const
     return file_path_;
 }
 
+std::shared_ptr<const VcfWriter::ThreadPool> VcfWriter::compression_pool() const
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    return compression_pool_;
+}
+
 void VcfWriter::write(const VcfHeader& header)
 {
     std::lock_guard<std::mutex> lock {mutex_};
@@ -159,9 +192,20 @@ void VcfWriter::write(const VcfHeader& header)
 void VcfWriter::write(const VcfRecord& record)
 {
     std::lock_guard<std::mutex> lock {mutex_};
-    if (is_header_written_) {
-        writer_->write(record);
-    } else {
+    check_header_written();
+    writer_->write(record);
+}
+
+bool VcfWriter::append_compressed(const Path& source)
+{
+    std::lock_guard<std::mutex> lock {mutex_};
+    check_header_written();
+    return writer_->append_compressed(source);
+}
+
+void VcfWriter::check_header_written() const
+{
+    if (!is_header_written_) {
         throw std::runtime_error {"VcfWriter::write: cannot write record as header has not been written"};
     }
 }
@@ -9,10 +9,12 @@
 #include <type_traits>
 #include <functional>
 #include <iterator>
+#include <algorithm>
 
 #include <boost/filesystem/path.hpp>
 #include <boost/optional.hpp>
 
+#include "io/read/htslib_thread_pool.hpp"
 #include "htslib_bcf_facade.hpp"
 
 namespace octopus {
@@ -25,11 +27,16 @@ class VcfWriter
 {
 public:
     using Path = boost::filesystem::path;
+    using ThreadPool = io::HtslibThreadPool;
     
     VcfWriter();
     VcfWriter(Path file_path);
     VcfWriter(const VcfHeader& header);
     VcfWriter(Path file_path, const VcfHeader& header);
+    // BGZF compressed output is compressed on compression_pool, which is kept for files opened later
+    explicit VcfWriter(std::shared_ptr<const ThreadPool> compression_pool);
+    VcfWriter(Path file_path, std::shared_ptr<const ThreadPool> compression_pool);
+    VcfWriter(Path file_path, const VcfHeader& header, std::shared_ptr<const ThreadPool> compression_pool);
     
     VcfWriter(const VcfWriter&)            = delete;
     VcfWriter& operator=(const VcfWriter&) = delete;
@@ -42,24 +49,44 @@ public:
     
     bool is_open() const noexcept;
     void open(Path file_path);
+    void open(Path file_path, std::shared_ptr<const ThreadPool> compression_pool);
     void close() noexcept;
     
     bool is_header_written() const noexcept;
     
     boost::optional<Path> path() const;
+    std::shared_ptr<const ThreadPool> compression_pool() const;
     
     void write(const VcfHeader& header);
     void write(const VcfRecord& record);
+    // Writes all records in [first, last) under a single lock, so concurrent writers cannot interleave them
+    template <typename ForwardIterator>
+    void write(ForwardIterator first, ForwardIterator last);
+    
+    // Appends the records of a closed file without decoding them if possible, see HtslibBcfFacade::append_compressed
+    bool append_compressed(const Path& source);
     
 private:
     boost::optional<Path> file_path_;
+    std::shared_ptr<const ThreadPool> compression_pool_;
     std::unique_ptr<HtslibBcfFacade> writer_;
     bool is_header_written_;
     mutable std::mutex mutex_;
     
+    void check_header_written() const;
     bool can_write_index() const noexcept;
 };
 
+template <typename ForwardIterator>
+void VcfWriter::write(ForwardIterator first, ForwardIterator last)
+{
+    static_assert(std::is_same<typename std::iterator_traits<ForwardIterator>::value_type, VcfRecord>::value, "");
+    if (first == last) return;
+    std::lock_guard<std::mutex> lock {mutex_};
+    check_header_written();
+    std::for_each(first, last, [this] (const VcfRecord& record) { writer_->write(record); });
+}
+
 VcfWriter& operator<<(VcfWriter& dst, const VcfHeader& header);
 VcfWriter& operator<<(VcfWriter& dst, const VcfRecord& record);
 
@@ -67,9 +94,7 @@ template <typename Container>
 void write(const Container& records, VcfWriter& dst)
 {
     static_assert(std::is_same<typename Container::value_type, VcfRecord>::value, "");
-    for (const auto& record : records) {
-        dst << record;
-    }
+    dst.write(std::cbegin(records), std::cend(records));
 }
 
 template <typename Container>
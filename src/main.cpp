@@ -13,6 +13,8 @@
 #include "config/option_parser.hpp"
 #include "config/option_collation.hpp"
 #include "core/octopus.hpp"
+#include "io/reference/reference_annotation_index.hpp"
+#include "io/reference/packed_reference.hpp"
 #include "utils/timing.hpp"
 #include "utils/string_utils.hpp"
 #include "exceptions/error.hpp"
@@ -46,6 +48,32 @@ void init_common(const OptionMap& options)
     TRACE_MODE = options::is_trace_mode(options);
 }
 
+void run_index_reference(const OptionMap& options)
+{
+    logging::InfoLogger info_log {};
+    const auto reference = make_reference(options);
+    const auto index_path = get_reference_annotation_index_path(options);
+    stream(info_log) << "Writing reference annotation index to " << index_path;
+    const auto start = std::chrono::system_clock::now();
+    ReferenceAnnotationIndex::build(reference, index_path);
+    const auto end = std::chrono::system_clock::now();
+    using utils::TimeInterval;
+    stream(info_log) << "Done writing reference annotation index in " << TimeInterval {start, end};
+}
+
+void run_pack_reference(const OptionMap& options)
+{
+    logging::InfoLogger info_log {};
+    const auto reference = make_reference(options);
+    const auto packed_path = get_packed_reference_path(options);
+    stream(info_log) << "Writing packed reference to " << packed_path;
+    const auto start = std::chrono::system_clock::now();
+    io::PackedReference::build(reference, packed_path);
+    const auto end = std::chrono::system_clock::now();
+    using utils::TimeInterval;
+    stream(info_log) << "Done writing packed reference in " << TimeInterval {start, end};
+}
+
 std::string to_string(const int argc, const char** argv)
 {
     std::vector<std::string> arguements {argv, argv + argc};
@@ -69,7 +97,23 @@ int main(const int argc, const char** argv)
         return EXIT_FAILURE;
     }
     
-    if (is_run_command(options)) {
+    if (is_index_reference_command(options) || is_pack_reference_command(options)) {
+        try {
+            init_common(options);
+            log_program_startup();
+            if (is_pack_reference_command(options)) run_pack_reference(options);
+            if (is_index_reference_command(options)) run_index_reference(options);
+            log_program_end();
+        } catch (const Error& e) {
+            return log_exception(e);
+        } catch (const std::exception& e) {
+            return log_exception(e);
+        } catch (...) {
+            log_unknown_error();
+            log_program_end();
+            return EXIT_FAILURE;
+        }
+    } else if (is_run_command(options)) {
         try {
             init_common(options);
             log_program_startup();
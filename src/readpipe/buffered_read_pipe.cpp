@@ -7,6 +7,7 @@
 #include <limits>
 #include <algorithm>
 #include <iterator>
+#include <cassert>
 
 #include "utils/mappable_algorithms.hpp"
 #include "utils/read_stats.hpp"
@@ -23,6 +24,9 @@ BufferedReadPipe::BufferedReadPipe(const ReadPipe& source, Config config, std::v
 , buffer_ {}
 , buffered_region_ {}
 , hints_ {}
+, prefetches_ {}
+, prefetcher_ {config.max_prefetches > 0 ? std::make_unique<ThreadPool>(1) : nullptr}
+, buffer_charge_ {}
 {
     hint(std::move(hints));
 }
@@ -37,17 +41,22 @@ void BufferedReadPipe::clear() noexcept
     buffer_.clear();
     buffered_region_ = boost::none;
     hints_.clear();
+    cancel_prefetches();
+    buffer_charge_ = {};
 }
 
 ReadMap BufferedReadPipe::fetch_reads(const GenomicRegion& region) const
 {
     setup_buffer(region);
-    return copy_overlapped(buffer_, region);
+    auto result = copy_overlapped(buffer_, region);
+    if (is_over_budget()) shrink_buffer(region);
+    return result;
 }
 
 void BufferedReadPipe::hint(std::vector<GenomicRegion> hints) const
 {
     hints_.clear();
+    cancel_prefetches();
     for (auto& region : hints) {
         hints_[region.contig_name()].insert(std::move(region));
     }
@@ -67,41 +76,168 @@ bool BufferedReadPipe::is_cached(const GenomicRegion& region) const noexcept
 
 // private methods
 
+BufferedReadPipe::Fetch
+BufferedReadPipe::fetch(const ReadPipe& source, const GenomicRegion& request, const GenomicRegion& max_region,
+                        const bool unchecked, const std::size_t max_reads, const GenomicRegion::Size expansion)
+{
+    Fetch result {unchecked ? max_region : source.read_manager().find_covered_subregion(max_region, max_reads),
+                  {}, !unchecked, false, {}};
+    result.reads = source.fetch_reads(expand(result.region, expansion));
+    if (unchecked && count_reads(result.reads) > max_reads) {
+        // Clear buffer of reads to rhs of request
+        for (auto& p : result.reads) {
+            const auto last_overlapped = find_first_after(p.second, request);
+            p.second.erase(last_overlapped, std::cend(p.second));
+        }
+        result.region = request;
+        result.overflowed = true;
+    }
+    if (auto budget = source.memory_budget()) {
+        result.charge = budget->charge(footprint(result.reads));
+    }
+    return result;
+}
+
 void BufferedReadPipe::setup_buffer(const GenomicRegion& request) const
 {
-    if (!is_cached(request)) {
-        auto max_region = get_max_fetch_region(request);
-        bool unchecked_fetch {false};
-        if (can_make_unchecked_fetch()) {
-            buffered_region_ = std::move(max_region);
-            unchecked_fetch = true;
+    if (!is_cached(request) && !use_prefetched_buffer(request)) {
+        cancel_prefetches();
+        update_buffer(fetch(source_, request, get_max_fetch_region(request), can_make_unchecked_fetch(),
+                            max_buffer_size(), config_.fetch_expansion));
+    }
+    if (is_prefetching()) schedule_prefetches();
+}
+
+void BufferedReadPipe::update_buffer(Fetch fetch) const
+{
+    buffer_ = std::move(fetch.reads);
+    buffered_region_ = std::move(fetch.region);
+    buffer_charge_ = std::move(fetch.charge);
+    const auto num_reads = count_reads(buffer_);
+    if (num_reads > 0 && buffer_charge_.num_bytes() > 0) {
+        mean_read_footprint_ = std::max(buffer_charge_.num_bytes() / num_reads, std::size_t {1});
+    }
+    if (fetch.overflowed) {
+        if (default_unchecked_fetch_overflowed_) {
+            adjusted_unchecked_fetch_overflowed_ = true;
         } else {
-            buffered_region_ = source_.get().read_manager().find_covered_subregion(max_region, config_.max_buffer_size);
+            default_unchecked_fetch_overflowed_ = true;
         }
-        buffer_ = source_.get().fetch_reads(expand(*buffered_region_, config_.fetch_expansion));
-        if (unchecked_fetch) {
-            const auto fetch_size = count_reads(buffer_);
-            if (fetch_size > config_.max_buffer_size) {
-                if (default_unchecked_fetch_overflowed_) {
-                    adjusted_unchecked_fetch_overflowed_ = true;
-                } else {
-                    default_unchecked_fetch_overflowed_ = true;
-                }
-                // Clear buffer of reads to rhs of request
-                for (auto& p : buffer_) {
-                    const auto last_overlapped = find_first_after(p.second, request);
-                    p.second.erase(last_overlapped, std::cend(p.second));
-                }
-                buffered_region_ = request;
-            }
+    }
+    if (fetch.checked) {
+        if (min_checked_fetch_size_) {
+            min_checked_fetch_size_ = std::min(size(*buffered_region_), *min_checked_fetch_size_);
         } else {
-            if (min_checked_fetch_size_) {
-                min_checked_fetch_size_ = std::min(size(*buffered_region_), *min_checked_fetch_size_);
-            } else {
-                min_checked_fetch_size_ = size(*buffered_region_);
-            }
+            min_checked_fetch_size_ = size(*buffered_region_);
+        }
+    }
+}
+
+bool BufferedReadPipe::use_prefetched_buffer(const GenomicRegion& request) const
+{
+    // Prefetches are ordered, so any that end before the request will never be used
+    while (!prefetches_.empty() && (!is_same_contig(prefetches_.front().request, request)
+                                    || is_before(prefetches_.front().request, request))) {
+        prefetches_.pop_front();
+    }
+    if (prefetches_.empty() || !contains(prefetches_.front().request, head_position(request))) {
+        return false;
+    }
+    update_buffer(prefetches_.front().result.get());
+    prefetches_.pop_front();
+    return is_cached(request);
+}
+
+void BufferedReadPipe::schedule_prefetches() const
+{
+    assert(buffered_region_);
+    while (prefetches_.size() < config_.max_prefetches && !is_over_budget()) {
+        const auto& last_region = prefetches_.empty() ? *buffered_region_ : prefetches_.back().max_region;
+        auto request = next_hinted_request(last_region);
+        if (!request) break;
+        auto max_region = get_max_fetch_region(*request);
+        auto result = prefetcher_->push(fetch, std::cref(source_.get()), *request, max_region, can_make_unchecked_fetch(),
+                                        max_buffer_size(), config_.fetch_expansion);
+        prefetches_.push_back({std::move(*request), std::move(max_region), std::move(result)});
+    }
+}
+
+boost::optional<GenomicRegion> BufferedReadPipe::next_hinted_request(const GenomicRegion& region) const
+{
+    const auto contig_hints_itr = hints_.find(region.contig_name());
+    if (contig_hints_itr == std::cend(hints_)) return boost::none;
+    const auto& contig_hints = contig_hints_itr->second;
+    // Hints are non-overlapping so are also sorted by end position
+    const auto hint_itr = std::partition_point(std::cbegin(contig_hints), std::cend(contig_hints),
+                                               [&] (const auto& hint) { return hint.end() <= region.end(); });
+    if (hint_itr == std::cend(contig_hints)) return boost::none;
+    if (hint_itr->begin() < region.end()) {
+        return GenomicRegion {region.contig_name(), region.end(), hint_itr->end()};
+    } else {
+        return *hint_itr;
+    }
+}
+
+void BufferedReadPipe::cancel_prefetches() const noexcept
+{
+    // Dropping a future does not stop its task, so remove queued fetches before they read reads nobody wants
+    if (prefetcher_) prefetcher_->clear();
+    prefetches_.clear();
+}
+
+bool BufferedReadPipe::is_prefetching() const noexcept
+{
+    return prefetcher_ && !hints_.empty();
+}
+
+bool BufferedReadPipe::is_over_budget() const noexcept
+{
+    const auto budget = source_.get().memory_budget();
+    return budget && budget->is_exceeded();
+}
+
+void BufferedReadPipe::shrink_buffer(const GenomicRegion& request) const
+{
+    if (!buffered_region_) return;
+    // Requests are usually made left to right, so reads before the request are least likely to be needed again
+    if (begins_before(*buffered_region_, request)) {
+        const auto passed_region = left_overhang_region(*buffered_region_, request);
+        for (auto& p : buffer_) {
+            p.second.erase_contained(passed_region);
         }
+        buffered_region_ = closed_region(request, *buffered_region_);
+        buffer_charge_ = {};
+        buffer_charge_ = source_.get().memory_budget()->charge(footprint(buffer_));
+    }
+    // Other holders may account for the excess, so only drop the buffer if it is over its own share
+    if (is_over_budget() && buffer_charge_.num_bytes() > max_buffer_footprint()) {
+        buffer_.clear();
+        buffered_region_ = boost::none;
+        buffer_charge_ = {};
+    }
+}
+
+std::size_t BufferedReadPipe::max_buffer_footprint() const noexcept
+{
+    return config_.max_buffer_size * mean_read_footprint_;
+}
+
+std::size_t BufferedReadPipe::max_buffer_size() const noexcept
+{
+    const auto num_buffers = is_prefetching() ? config_.max_prefetches + 1 : 1u;
+    auto result = config_.max_buffer_size / num_buffers;
+    const auto budget = source_.get().memory_budget();
+    if (budget && mean_read_footprint_ > 0) {
+        // The current buffer is replaced by the fetch, so its bytes count as available
+        static constexpr std::size_t min_budgeted_reads {10'000};
+        const auto num_used_bytes = budget->used().num_bytes();
+        const auto num_other_bytes = num_used_bytes - std::min(num_used_bytes, buffer_charge_.num_bytes());
+        const auto limit = budget->limit().num_bytes();
+        const auto num_available_bytes = num_other_bytes < limit ? limit - num_other_bytes : 0;
+        const auto num_budgeted_reads = num_available_bytes / mean_read_footprint_ / num_buffers;
+        result = std::min(result, std::max(num_budgeted_reads, min_budgeted_reads));
     }
+    return result;
 }
 
 GenomicRegion BufferedReadPipe::get_max_fetch_region(const GenomicRegion& request) const
@@ -6,12 +6,17 @@
 
 #include <functional>
 #include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
 
 #include <boost/optional.hpp>
 
 #include "read_pipe.hpp"
 #include "basics/genomic_region.hpp"
 #include "containers/mappable_map.hpp"
+#include "utils/thread_pool.hpp"
+#include "utils/memory_budget.hpp"
 
 namespace octopus {
 
@@ -25,8 +30,14 @@ public:
         boost::optional<GenomicRegion::Size> max_fetch_size = boost::none;
         boost::optional<GenomicRegion::Size> max_hint_gap = boost::none;
         bool allow_unchecked_fetches = true;
+        // Number of hinted regions that may be fetched in the background ahead of requests. The max_buffer_size
+        // read budget is shared equally between the buffer and any in-flight prefetches.
+        unsigned max_prefetches = 0;
     };
     
+    // If the source has a memory budget then buffered reads are charged to it. Fetch sizes are then also limited by
+    // the measured size of buffered reads, and the buffer is shrunk whenever the budget is exceeded.
+    
     BufferedReadPipe() = delete;
     
     BufferedReadPipe(const ReadPipe& source, Config config);
@@ -55,6 +66,19 @@ public:
 private:
     using RegionMap = MappableSetMap<GenomicRegion::ContigName, GenomicRegion>;
     
+    struct Fetch
+    {
+        GenomicRegion region;
+        ReadMap reads;
+        bool checked, overflowed;
+        MemoryBudget::Charge charge;
+    };
+    struct Prefetch
+    {
+        GenomicRegion request, max_region;
+        std::future<Fetch> result;
+    };
+    
     std::reference_wrapper<const ReadPipe> source_;
     Config config_;
     mutable ReadMap buffer_;
@@ -63,8 +87,25 @@ private:
     mutable bool default_unchecked_fetch_overflowed_ = false;
     mutable bool adjusted_unchecked_fetch_overflowed_ = false;
     mutable boost::optional<GenomicRegion::Size> min_checked_fetch_size_ = boost::none;
+    mutable std::deque<Prefetch> prefetches_;
+    std::unique_ptr<ThreadPool> prefetcher_;
+    mutable MemoryBudget::Charge buffer_charge_;
+    mutable std::size_t mean_read_footprint_ = 0;
+    
+    static Fetch fetch(const ReadPipe& source, const GenomicRegion& request, const GenomicRegion& max_region,
+                       bool unchecked, std::size_t max_reads, GenomicRegion::Size expansion);
     
     void setup_buffer(const GenomicRegion& request) const;
+    void update_buffer(Fetch fetch) const;
+    bool use_prefetched_buffer(const GenomicRegion& request) const;
+    void schedule_prefetches() const;
+    void cancel_prefetches() const noexcept;
+    boost::optional<GenomicRegion> next_hinted_request(const GenomicRegion& region) const;
+    bool is_prefetching() const noexcept;
+    bool is_over_budget() const noexcept;
+    void shrink_buffer(const GenomicRegion& request) const;
+    std::size_t max_buffer_size() const noexcept;
+    std::size_t max_buffer_footprint() const noexcept;
     GenomicRegion get_max_fetch_region(const GenomicRegion& request) const;
     GenomicRegion get_default_max_fetch_region(const GenomicRegion& request) const;
     bool can_make_unchecked_fetch() const noexcept;
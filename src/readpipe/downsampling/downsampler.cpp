@@ -11,6 +11,8 @@
 #include <random>
 #include <cassert>
 
+#include <boost/functional/hash.hpp>
+
 #include "concepts/mappable.hpp"
 #include "basics/mappable_reference_wrapper.hpp"
 #include "concepts/mappable_range.hpp"
@@ -46,40 +48,41 @@ auto calculate_minimum_coverages(const ForwardIt first, const ForwardIt last,
     return result;
 }
 
-auto sample(const PositionCoverages& required_coverage)
+using RandomEngine = std::default_random_engine;
+
+auto sample(const PositionCoverages& required_coverage, RandomEngine& generator)
 {
-    static std::default_random_engine generator {};
     // TODO: Do we really need to keep regenerating this distribution?
     std::discrete_distribution<std::size_t> dist {std::cbegin(required_coverage), std::cend(required_coverage)};
     return dist(generator);
 }
 
 template <typename BidirIt>
-BidirIt random_sample(const BidirIt first, const BidirIt last)
+BidirIt random_sample(const BidirIt first, const BidirIt last, RandomEngine& generator)
 {
-    static std::default_random_engine generator {};
     std::uniform_int_distribution<std::size_t> dist(0, std::distance(first, last) - 1);
     return std::next(first, dist(generator));
 }
 
 template <typename T>
-auto random_sample(const OverlapRange<T>& range)
+auto random_sample(const OverlapRange<T>& range, RandomEngine& generator)
 {
-    return random_sample(std::begin(range), std::end(range)).base();
+    return random_sample(std::begin(range), std::end(range), generator).base();
 }
 
 template <typename BidirIt>
 auto pick_sample(BidirIt first_unsampled, BidirIt last_unsampled,
                  const std::vector<GenomicRegion>& positions,
                  const PositionCoverages& required_coverage,
-                 const AlignedRead::MappingDomain::Size max_read_size)
+                 const AlignedRead::MappingDomain::Size max_read_size,
+                 RandomEngine& generator)
 {
     assert(first_unsampled < last_unsampled);
     const auto candidates = overlap_range(first_unsampled, last_unsampled,
-                                          positions[sample(required_coverage)],
+                                          positions[sample(required_coverage, generator)],
                                           max_read_size);
     assert(!candidates.empty());
-    return random_sample(candidates);
+    return random_sample(candidates, generator);
 }
 
 void reduce(PositionCoverages& coverages, const ReadWrapper& read, const GenomicRegion& region)
@@ -125,6 +128,15 @@ void remove_sample(BidirIt& first, BidirIt sample, BidirIt& last)
     }
 }
 
+// Each region is sampled with its own engine so the reads kept do not depend on what was sampled before,
+// or on which thread does the sampling
+RandomEngine make_random_engine(const std::size_t seed, const GenomicRegion& region)
+{
+    auto result = seed;
+    boost::hash_combine(result, std::hash<GenomicRegion> {}(region));
+    return RandomEngine {static_cast<RandomEngine::result_type>(result)};
+}
+
 auto extract_sampled(std::vector<ReadWrapper>& reads,
                      std::vector<ReadWrapper>::iterator first_unsampled,
                      std::vector<ReadWrapper>::iterator last_unsampled)
@@ -142,7 +154,7 @@ auto extract_sampled(std::vector<ReadWrapper>& reads,
 
 template <typename InputIt>
 auto sample(const InputIt first_read, const InputIt last_read, const GenomicRegion& region,
-            const unsigned target_coverage)
+            const unsigned target_coverage, const std::size_t seed)
 {
     if (first_read == last_read) return std::vector<AlignedRead> {};
     const auto positions = decompose(region);
@@ -155,10 +167,11 @@ auto sample(const InputIt first_read, const InputIt last_read, const GenomicRegi
     // which allows a sampled read to be optimally moved out of the unsampled partition
     auto first_unsampled_itr = std::begin(reads);
     auto last_unsampled_itr  = std::end(reads);
+    auto generator = make_random_engine(seed, region);
     
     while (!has_minimum_coverage(required_coverage)) {
         const auto sampled_itr = pick_sample(first_unsampled_itr, last_unsampled_itr,
-                                             positions, required_coverage, max_read_size);
+                                             positions, required_coverage, max_read_size, generator);
         reduce(required_coverage, *sampled_itr, region);
         remove_sample(first_unsampled_itr, sampled_itr, last_unsampled_itr);
     }
@@ -194,7 +207,8 @@ auto find_target_regions(const ReadContainer& reads, const unsigned max_coverage
 
 } // namespace
 
-std::size_t sample(ReadContainer& reads, const unsigned trigger_coverage, const unsigned target_coverage)
+std::size_t sample(ReadContainer& reads, const unsigned trigger_coverage, const unsigned target_coverage,
+                   const std::size_t seed)
 {
     using std::begin; using std::end; using std::make_move_iterator;
     
@@ -219,7 +233,7 @@ std::size_t sample(ReadContainer& reads, const unsigned trigger_coverage, const
           const auto contained = bases(contained_range(begin(reads), end(reads), region));
           num_reads += std::distance(end(contained), end(reads));
           unsampled_read_blocks.emplace_back(make_move_iterator(end(contained)), make_move_iterator(end(reads)));
-          auto sampled_reads = sample(begin(contained), end(contained), region, target_coverage);
+          auto sampled_reads = sample(begin(contained), end(contained), region, target_coverage, seed);
           num_reads += sampled_reads.size();
           sampled_read_blocks.emplace_back(make_move_iterator(begin(sampled_reads)), make_move_iterator(end(sampled_reads)));
           reads.erase(begin(contained), end(reads));
@@ -251,9 +265,19 @@ Downsampler::Downsampler(const unsigned trigger_coverage, const unsigned target_
     }
 }
 
-std::size_t Downsampler::downsample(ReadContainer& reads) const
+unsigned Downsampler::trigger_coverage() const noexcept
+{
+    return trigger_coverage_;
+}
+
+unsigned Downsampler::target_coverage() const noexcept
+{
+    return target_coverage_;
+}
+
+std::size_t Downsampler::downsample(ReadContainer& reads, const std::size_t seed) const
 {
-    return sample(reads, trigger_coverage_, target_coverage_);
+    return sample(reads, trigger_coverage_, target_coverage_, seed);
 }
 
 } // namespace readpipe
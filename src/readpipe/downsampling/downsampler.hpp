@@ -5,6 +5,7 @@
 #define downsampler_hpp
 
 #include <cstddef>
+#include <functional>
 
 #include "config/common.hpp"
 #include "containers/mappable_flat_multi_set.hpp"
@@ -31,8 +32,11 @@ public:
     
     ~Downsampler() = default;
     
-    // Returns the number of reads removed
-    std::size_t downsample(ReadContainer& reads) const;
+    unsigned trigger_coverage() const noexcept;
+    unsigned target_coverage() const noexcept;
+    
+    // Returns the number of reads removed. The reads kept depend only on the reads and the seed.
+    std::size_t downsample(ReadContainer& reads, std::size_t seed = 0) const;
     
 private:
     unsigned trigger_coverage_ = 10'000;
@@ -45,7 +49,7 @@ auto downsample(Map& reads, const Downsampler& downsampler)
     std::size_t result {0};
     
     for (auto& p : reads) {
-        result += downsampler.downsample(p.second);
+        result += downsampler.downsample(p.second, std::hash<typename Map::key_type> {}(p.first));
     }
     
     return result;
@@ -35,6 +35,11 @@ bool IsNotSecondaryAlignment::passes(const AlignedRead& read) const noexcept
     return !read.is_marked_secondary_alignment();
 }
 
+void IsNotSecondaryAlignment::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::notSecondary);
+}
+
 IsNotSupplementaryAlignment::IsNotSupplementaryAlignment()
 : BasicReadFilter {"IsNotSupplementaryAlignment"} {}
 
@@ -46,6 +51,11 @@ bool IsNotSupplementaryAlignment::passes(const AlignedRead& read) const noexcept
     return !read.is_marked_supplementary_alignment();
 }
 
+void IsNotSupplementaryAlignment::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::notSupplementary);
+}
+
 IsGoodMappingQuality::IsGoodMappingQuality(MappingQuality good_mapping_quality)
 :
 BasicReadFilter {"IsGoodMappingQuality"}
@@ -60,6 +70,11 @@ bool IsGoodMappingQuality::passes(const AlignedRead& read) const noexcept
     return read.mapping_quality() >= good_mapping_quality_;
 }
 
+void IsGoodMappingQuality::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::minMappingQuality, good_mapping_quality_);
+}
+
 HasSufficientGoodBaseFraction::HasSufficientGoodBaseFraction(BaseQuality good_base_quality,
                                                              double min_good_base_fraction)
 : BasicReadFilter {"HasSufficientGoodBaseFraction"}
@@ -114,6 +129,11 @@ bool IsMapped::passes(const AlignedRead& read) const noexcept
     return !read.is_marked_unmapped();
 }
 
+void IsMapped::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::mapped);
+}
+
 IsNotChimeric::IsNotChimeric() : BasicReadFilter {"IsNotChimeric"} {}
 IsNotChimeric::IsNotChimeric(std::string name) :  BasicReadFilter {std::move(name)} {}
 
@@ -122,6 +142,11 @@ bool IsNotChimeric::passes(const AlignedRead& read) const noexcept
     return !read.has_other_segment();
 }
 
+void IsNotChimeric::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::notChimeric);
+}
+
 IsNextSegmentMapped::IsNextSegmentMapped() : BasicReadFilter {"IsNextSegmentMapped"} {}
 IsNextSegmentMapped::IsNextSegmentMapped(std::string name) :  BasicReadFilter {std::move(name)} {}
 
@@ -130,6 +155,11 @@ bool IsNextSegmentMapped::passes(const AlignedRead& read) const noexcept
     return !read.has_other_segment() || !read.next_segment().is_marked_unmapped();
 }
 
+void IsNextSegmentMapped::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::nextSegmentMapped);
+}
+
 IsNotMarkedDuplicate::IsNotMarkedDuplicate() : BasicReadFilter {"IsNotMarkedDuplicate"} {}
 IsNotMarkedDuplicate::IsNotMarkedDuplicate(std::string name) :  BasicReadFilter {std::move(name)} {}
 
@@ -138,6 +168,11 @@ bool IsNotMarkedDuplicate::passes(const AlignedRead& read) const noexcept
     return !read.is_marked_duplicate();
 }
 
+void IsNotMarkedDuplicate::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::notDuplicate);
+}
+
 IsShort::IsShort(Length max_length)
 : BasicReadFilter {"IsShort"}
 , max_length_ {max_length} {}
@@ -151,6 +186,11 @@ bool IsShort::passes(const AlignedRead& read) const noexcept
     return sequence_size(read) <= max_length_;
 }
 
+void IsShort::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::maxLength, max_length_);
+}
+
 IsLong::IsLong(Length min_length)
 : BasicReadFilter {"IsLong"}
 , min_length_ {min_length} {}
@@ -164,6 +204,11 @@ bool IsLong::passes(const AlignedRead& read) const noexcept
     return sequence_size(read) >= min_length_;
 }
 
+void IsLong::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::minLength, min_length_);
+}
+
 IsNotContaminated::IsNotContaminated() : BasicReadFilter {"IsNotContaminated"} {}
 IsNotContaminated::IsNotContaminated(std::string name) :  BasicReadFilter {std::move(name)} {}
 
@@ -184,6 +229,11 @@ bool IsNotMarkedQcFail::passes(const AlignedRead& read) const noexcept
     return !read.is_marked_qc_fail();
 }
 
+void IsNotMarkedQcFail::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::notQcFail);
+}
+
 IsProperTemplate::IsProperTemplate() : BasicReadFilter {"IsProperTemplate"} {}
 IsProperTemplate::IsProperTemplate(std::string name) :  BasicReadFilter {std::move(name)} {}
 
@@ -192,6 +242,11 @@ bool IsProperTemplate::passes(const AlignedRead& read) const noexcept
     return !read.has_other_segment() || read.is_marked_all_segments_in_read_aligned();
 }
 
+void IsProperTemplate::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::properTemplate);
+}
+
 IsLocalTemplate::IsLocalTemplate() : BasicReadFilter {"IsLocalTemplate"} {}
 IsLocalTemplate::IsLocalTemplate(std::string name) :  BasicReadFilter {std::move(name)} {}
 
@@ -200,5 +255,10 @@ bool IsLocalTemplate::passes(const AlignedRead& read) const noexcept
     return !read.has_other_segment() || read.next_segment().contig_name() == contig_name(read);
 }
 
+void IsLocalTemplate::do_compile(io::ReadPrefilter& prefilter) const
+{
+    prefilter.add(name(), io::ReadPrefilter::Test::localTemplate);
+}
+
 } // namespace readpipe
 } // namespace octopus
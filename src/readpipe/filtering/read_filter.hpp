@@ -12,6 +12,7 @@
 
 #include "basics/cigar_string.hpp"
 #include "basics/aligned_read.hpp"
+#include "io/read/read_prefilter.hpp"
 
 namespace octopus { namespace readpipe
 {
@@ -46,11 +47,18 @@ public:
         return passes(read);
     }
     
+    // Adds an equivalent test on raw alignment records to prefilter, if there is one
+    void compile(io::ReadPrefilter& prefilter) const
+    {
+        do_compile(prefilter);
+    }
+    
 protected:
     BasicReadFilter(std::string name) : Nameable {std::move(name)} {};
     
 private:
     virtual bool passes(const AlignedRead&) const noexcept = 0;
+    virtual void do_compile(io::ReadPrefilter&) const {}
 };
 
 struct HasWellFormedCigar : BasicReadFilter
@@ -75,6 +83,7 @@ struct IsNotSecondaryAlignment : BasicReadFilter
     IsNotSecondaryAlignment(std::string name);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
 };
 
 struct IsNotSupplementaryAlignment : BasicReadFilter
@@ -83,6 +92,7 @@ struct IsNotSupplementaryAlignment : BasicReadFilter
     IsNotSupplementaryAlignment(std::string name);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
 };
 
 struct IsGoodMappingQuality : BasicReadFilter
@@ -96,6 +106,7 @@ struct IsGoodMappingQuality : BasicReadFilter
     IsGoodMappingQuality(std::string name, MappingQuality good_mapping_quality);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
     
 private:
     MappingQuality good_mapping_quality_;
@@ -141,6 +152,7 @@ struct IsMapped : BasicReadFilter
     IsMapped(std::string name);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
 };
 
 struct IsNotChimeric : BasicReadFilter
@@ -149,6 +161,7 @@ struct IsNotChimeric : BasicReadFilter
     IsNotChimeric(std::string name);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
 };
 
 struct IsNextSegmentMapped : BasicReadFilter
@@ -157,6 +170,7 @@ struct IsNextSegmentMapped : BasicReadFilter
     IsNextSegmentMapped(std::string name);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
 };
 
 struct IsNotMarkedDuplicate : BasicReadFilter
@@ -165,6 +179,7 @@ struct IsNotMarkedDuplicate : BasicReadFilter
     IsNotMarkedDuplicate(std::string name);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
 };
 
 struct IsShort : BasicReadFilter
@@ -176,6 +191,7 @@ struct IsShort : BasicReadFilter
     IsShort(std::string name, Length max_length);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
 
 private:
     Length max_length_;
@@ -190,6 +206,7 @@ struct IsLong : BasicReadFilter
     IsLong(std::string name, Length min_length);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
     
 private:
     Length min_length_;
@@ -209,6 +226,7 @@ struct IsNotMarkedQcFail : BasicReadFilter
     IsNotMarkedQcFail(std::string name);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
 };
 
 struct IsProperTemplate : BasicReadFilter
@@ -217,6 +235,7 @@ struct IsProperTemplate : BasicReadFilter
     IsProperTemplate(std::string name);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
 };
     
 struct IsLocalTemplate : BasicReadFilter
@@ -225,6 +244,7 @@ struct IsLocalTemplate : BasicReadFilter
     IsLocalTemplate(std::string name);
     
     bool passes(const AlignedRead& read) const noexcept override;
+    void do_compile(io::ReadPrefilter& prefilter) const override;
 };
 
 // Context filters
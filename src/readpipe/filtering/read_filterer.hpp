@@ -24,6 +24,9 @@ namespace octopus { namespace readpipe
  
  This is a template class as the type of iterator used for context-based filteration needs to be 
  known at compile time. The class needs to know what container it is going to be operating on.
+ 
+ Filters are not allowed to hold mutable state, so the const methods may be called concurrently (e.g. on
+ different samples' reads).
  */
 template <typename BidirIt>
 class ReadFilterer
@@ -52,6 +55,12 @@ public:
     
     void shrink_to_fit() noexcept; // Just removes extra capcity for filters
     
+    // Basic filters that can be evaluated on raw alignment records, for readers to apply before
+    // reads are constructed
+    io::ReadPrefilter make_prefilter() const;
+    // True if the prefilter is equivalent to all the filters, so readers see exactly the reads that would pass
+    bool is_prefilterable() const;
+    
     // Like std::remove
     BidirIt remove(ReadIterator first, ReadIterator last) const;
     BidirIt remove(ReadIterator first, ReadIterator last, FilterCountMap& filter_counts) const;
@@ -93,6 +102,29 @@ void ReadFilterer<BidirIt>::shrink_to_fit() noexcept
     context_filters_.shrink_to_fit();
 }
 
+template <typename BidirIt>
+io::ReadPrefilter ReadFilterer<BidirIt>::make_prefilter() const
+{
+    io::ReadPrefilter result {};
+    for (const auto& filter : basic_filters_) {
+        filter->compile(result);
+    }
+    return result;
+}
+
+template <typename BidirIt>
+bool ReadFilterer<BidirIt>::is_prefilterable() const
+{
+    if (!context_filters_.empty()) return false;
+    io::ReadPrefilter prefilter {};
+    return std::all_of(std::cbegin(basic_filters_), std::cend(basic_filters_),
+                       [&prefilter] (const auto& filter) {
+                           const auto num_clauses = prefilter.size();
+                           filter->compile(prefilter);
+                           return prefilter.size() > num_clauses;
+                       });
+}
+
 template <typename BidirIt>
 BidirIt ReadFilterer<BidirIt>::remove(BidirIt first, BidirIt last) const
 {
@@ -172,11 +204,10 @@ BidirIt ReadFilterer<BidirIt>::remove(BidirIt first, BidirIt last,
         
         filter_counts.reserve(num_filters());
         
-        std::transform(std::cbegin(basic_filters_), std::cend(basic_filters_), std::cbegin(flat_counts),
-                       std::inserter(filter_counts, std::begin(filter_counts)),
-                       [] (const auto& filter, const auto count) {
-                           return std::make_pair(filter->name(), count);
-                       });
+        // Counts are added as reads may already have been counted by a prefilter
+        for (std::size_t i {0}; i < basic_filters_.size(); ++i) {
+            filter_counts[basic_filters_[i]->name()] += flat_counts[i];
+        }
     }
     
     std::for_each(cbegin(context_filters_), cend(context_filters_),
@@ -225,11 +256,10 @@ BidirIt ReadFilterer<BidirIt>::partition(BidirIt first, BidirIt last,
         
         filter_counts.reserve(num_filters());
         
-        std::transform(std::cbegin(basic_filters_), std::cend(basic_filters_), std::cbegin(flat_counts),
-                       std::inserter(filter_counts, std::begin(filter_counts)),
-                       [] (const auto& filter, const auto count) {
-                           return std::make_pair(filter->name(), count);
-                       });
+        // Counts are added as reads may already have been counted by a prefilter
+        for (std::size_t i {0}; i < basic_filters_.size(); ++i) {
+            filter_counts[basic_filters_[i]->name()] += flat_counts[i];
+        }
     }
     
     std::for_each(cbegin(context_filters_), cend(context_filters_),
@@ -6,10 +6,13 @@
 #include <utility>
 #include <iterator>
 #include <algorithm>
+#include <future>
+#include <functional>
 #include <cassert>
 
 #include "utils/read_stats.hpp"
 #include "utils/mappable_algorithms.hpp"
+#include "io/read/read_buffer_pool.hpp"
 
 namespace octopus {
 
@@ -24,11 +27,19 @@ ReadPipe::ReadPipe(const ReadManager& source, ReadTransformer transformer, ReadF
 : source_ {source}
 , prefilter_transformer_ {std::move(transformer)}
 , filterer_ {std::move(filterer)}
+, prefilter_ {filterer_.make_prefilter()}
 , postfilter_transformer_ {}
 , downsampler_ {std::move(downsampler)}
 , samples_ {std::move(samples)}
+, workers_ {}
+, memory_budget_ {}
 , debug_log_ {}
 {
+    if (downsampler_ && filterer_.is_prefilterable()) {
+        // Let readers discard reads in regions that will be downsampled before they are constructed. Coverage
+        // must be counted on the reads that pass filtering, so this is only possible if readers apply every filter.
+        prefilter_.set_coverage_limit(downsampler_->trigger_coverage(), downsampler_->target_coverage());
+    }
     if (DEBUG_MODE) debug_log_ = logging::DebugLogger {};
 }
 
@@ -38,11 +49,19 @@ ReadPipe::ReadPipe(const ReadManager& source, ReadTransformer prefilter_transfor
 : source_ {source}
 , prefilter_transformer_ {std::move(prefilter_transformer)}
 , filterer_ {std::move(filterer)}
+, prefilter_ {filterer_.make_prefilter()}
 , postfilter_transformer_ {std::move(postfilter_transformer)}
 , downsampler_ {std::move(downsampler)}
 , samples_ {std::move(samples)}
+, workers_ {}
+, memory_budget_ {}
 , debug_log_ {}
 {
+    if (downsampler_ && filterer_.is_prefilterable()) {
+        // Let readers discard reads in regions that will be downsampled before they are constructed. Coverage
+        // must be counted on the reads that pass filtering, so this is only possible if readers apply every filter.
+        prefilter_.set_coverage_limit(downsampler_->trigger_coverage(), downsampler_->target_coverage());
+    }
     if (DEBUG_MODE) debug_log_ = logging::DebugLogger {};
 }
 
@@ -63,6 +82,22 @@ void ReadPipe::set_read_manager(const ReadManager& source) noexcept
     source_ = source;
 }
 
+void ReadPipe::set_thread_pool(std::shared_ptr<ThreadPool> workers) noexcept
+{
+    workers_ = std::move(workers);
+}
+
+void ReadPipe::set_memory_budget(std::shared_ptr<MemoryBudget> budget) noexcept
+{
+    memory_budget_ = std::move(budget);
+}
+
+boost::optional<MemoryBudget&> ReadPipe::memory_budget() const noexcept
+{
+    if (memory_budget_) return *memory_budget_;
+    return boost::none;
+}
+
 unsigned ReadPipe::num_samples() const noexcept
 {
     return static_cast<unsigned>(samples_.size());
@@ -83,9 +118,10 @@ void sort_each(Map& reads)
     }
 }
 
-auto fetch_batch(const ReadManager& rm, const std::vector<SampleName>& samples, const GenomicRegion& region)
+auto fetch_batch(const ReadManager& rm, const std::vector<SampleName>& samples, const GenomicRegion& region,
+                 const io::ReadPrefilter& prefilter, ReadManager::SampleFilterCountMap& filter_counts)
 {
-    auto result = rm.fetch_reads(samples, region);
+    auto result = rm.fetch_reads(samples, region, prefilter, filter_counts);
     sort_each(result);
     return result;
 }
@@ -136,18 +172,39 @@ ReadMap ReadPipe::fetch_reads(const GenomicRegion& region) const
         result.emplace(std::piecewise_construct, std::forward_as_tuple(sample), std::forward_as_tuple());
     }
     for (const auto& batch : batch_samples(samples_)) {
-        auto batch_reads = fetch_batch(source_, batch, region);
+        SampleFilterCountMap<SampleName, decltype(filterer_)> filter_counts {};
+        auto batch_reads = fetch_batch(source_, batch, region, prefilter_, filter_counts);
         if (debug_log_) {
-            stream(*debug_log_) << "Fetched " << count_reads(batch_reads) << " unfiltered reads from " << region;
-        }
-        transform_reads(batch_reads, prefilter_transformer_);
-        if (debug_log_) {
-            SampleFilterCountMap<SampleName, decltype(filterer_)> filter_counts {};
+            stream(*debug_log_) << "Fetched " << count_reads(batch_reads) << " prefiltered reads from " << region;
+            // Populate here so samples can be processed concurrently
             filter_counts.reserve(samples_.size());
-            for (const auto& sample : samples_) {
-                filter_counts[sample].reserve(filterer_.num_filters());
+            for (const auto& p : batch_reads) {
+                filter_counts[p.first].reserve(filterer_.num_filters());
             }
-            erase_filtered_reads(batch_reads, filter(batch_reads, filterer_, filter_counts));
+        }
+        // Samples are independent from here, and each only touches its own entries
+        const auto process_sample = [&] (auto& p) {
+            auto sample_filter_counts = debug_log_ ? &filter_counts.at(p.first) : nullptr;
+            return process(p.first, p.second, sample_filter_counts, result.at(p.first));
+        };
+        std::vector<ProcessReport> reports {};
+        reports.reserve(batch_reads.size());
+        if (workers_ && batch_reads.size() > 1) {
+            std::vector<std::future<ProcessReport>> futures {};
+            futures.reserve(batch_reads.size());
+            for (auto& p : batch_reads) {
+                futures.push_back(workers_->push([&process_sample, &p] () { return process_sample(p); }));
+            }
+            // Tasks reference locals so all must finish before any exception propagates
+            for (auto& future : futures) future.wait();
+            for (auto& future : futures) reports.push_back(future.get());
+        } else {
+            for (auto& p : batch_reads) {
+                reports.push_back(process_sample(p));
+            }
+        }
+        batch_reads.clear();
+        if (debug_log_) {
             if (filterer_.num_filters() > 0) {
                 for (const auto& p : filter_counts) {
                     stream(*debug_log_) << "In sample " << p.first;
@@ -160,23 +217,13 @@ ReadMap ReadPipe::fetch_reads(const GenomicRegion& region) const
                     }
                 }
             }
-        } else {
-            erase_filtered_reads(batch_reads, filter(batch_reads, filterer_));
-        }
-        if (postfilter_transformer_) {
-            transform_reads(batch_reads, *postfilter_transformer_);
-        }
-        if (debug_log_) {
-            stream(*debug_log_) << "There are " << count_reads(batch_reads) << " reads in " << region
-                            << " after filtering";
-        }
-        if (downsampler_) {
-            auto reads = make_mappable_map(std::move(batch_reads));
-            const auto n = downsample(reads, *downsampler_);
-            if (debug_log_) stream(*debug_log_) << "Downsampling removed " << n << " reads from " << region;
-            insert_each(std::move(reads), result);
-        } else {
-            insert_each(std::move(batch_reads), result);
+            std::size_t num_reads {0}, num_downsampled {0};
+            for (const auto& report : reports) {
+                num_reads += report.num_reads;
+                num_downsampled += report.num_downsampled;
+            }
+            stream(*debug_log_) << "There are " << num_reads << " reads in " << region << " after filtering";
+            if (downsampler_) stream(*debug_log_) << "Downsampling removed " << num_downsampled << " reads from " << region;
         }
     }
     shrink_to_fit(result); // TODO: should we make this conditional on extra capacity?
@@ -218,4 +265,36 @@ ReadMap ReadPipe::fetch_reads(const std::vector<GenomicRegion>& regions) const
     return result;
 }
 
+// private methods
+
+ReadPipe::ProcessReport
+ReadPipe::process(const SampleName& sample, ReadManager::ReadContainer& reads,
+                  ReadFilterer::FilterCountMap* filter_counts, ReadContainer& result) const
+{
+    using namespace readpipe;
+    transform_reads(reads, prefilter_transformer_);
+    const auto filter_point = filter_counts ? remove(reads, filterer_, *filter_counts) : remove(reads, filterer_);
+    reads.erase(filter_point, std::end(reads));
+    if (postfilter_transformer_) {
+        transform_reads(reads, *postfilter_transformer_);
+    }
+    ProcessReport report {reads.size(), 0};
+    if (downsampler_) {
+        ReadContainer sample_reads {std::make_move_iterator(std::begin(reads)), std::make_move_iterator(std::end(reads))};
+        // Seeded by sample so the reads kept do not depend on which worker processed the sample
+        report.num_downsampled = downsampler_->downsample(sample_reads, std::hash<SampleName> {}(sample));
+        if (result.empty()) {
+            result = std::move(sample_reads);
+        } else {
+            result.insert(std::make_move_iterator(std::begin(sample_reads)), std::make_move_iterator(std::end(sample_reads)));
+        }
+    } else if (result.empty()) {
+        move_construct(std::move(reads), result);
+    } else {
+        result.insert(std::make_move_iterator(std::begin(reads)), std::make_move_iterator(std::end(reads)));
+    }
+    io::release_read_buffer(reads);
+    return report;
+}
+
 } // namespace octopus
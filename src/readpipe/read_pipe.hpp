@@ -8,6 +8,7 @@
 #include <unordered_map>
 #include <cstddef>
 #include <functional>
+#include <memory>
 
 #include <boost/optional.hpp>
 
@@ -18,6 +19,8 @@
 #include "filtering/read_filterer.hpp"
 #include "transformers/read_transformer.hpp"
 #include "downsampling/downsampler.hpp"
+#include "utils/thread_pool.hpp"
+#include "utils/memory_budget.hpp"
 
 namespace octopus {
 /*
@@ -63,6 +66,14 @@ public:
     const ReadManager& read_manager() const noexcept;
     void set_read_manager(const ReadManager& source) noexcept;
     
+    // If set, the transforms, filters, and downsampling of each sample are run in parallel on the pool, which
+    // may be the read manager's own pool as the per-sample tasks never fetch reads
+    void set_thread_pool(std::shared_ptr<ThreadPool> workers) noexcept;
+    
+    // The budget that holders of fetched reads (e.g. callers and buffers) should charge their reads to
+    void set_memory_budget(std::shared_ptr<MemoryBudget> budget) noexcept;
+    boost::optional<MemoryBudget&> memory_budget() const noexcept;
+    
     unsigned num_samples() const noexcept;
     const std::vector<SampleName>& samples() const noexcept;
     
@@ -72,13 +83,24 @@ public:
     //Report get_report() const;
     
 private:
+    struct ProcessReport
+    {
+        std::size_t num_reads, num_downsampled;
+    };
+    
     std::reference_wrapper<const ReadManager> source_;
     ReadTransformer prefilter_transformer_;
     ReadFilterer filterer_;
+    io::ReadPrefilter prefilter_;
     boost::optional<ReadTransformer> postfilter_transformer_;
     boost::optional<Downsampler> downsampler_;
     std::vector<SampleName> samples_;
+    std::shared_ptr<ThreadPool> workers_;
+    std::shared_ptr<MemoryBudget> memory_budget_;
     mutable boost::optional<logging::DebugLogger> debug_log_;
+    
+    ProcessReport process(const SampleName& sample, ReadManager::ReadContainer& reads,
+                          ReadFilterer::FilterCountMap* filter_counts, ReadContainer& result) const;
 };
 
 } // namespace octopus
@@ -15,6 +15,8 @@
 
 namespace octopus { namespace readpipe {
 
+// Transforms must only modify the reads they are given, so transform_reads may be called concurrently
+// on disjoint ranges of reads.
 class ReadTransformer
 {
     using ReadReferenceVector = std::vector<std::reference_wrapper<AlignedRead>>;
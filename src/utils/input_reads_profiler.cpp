@@ -35,20 +35,9 @@ ForwardIt random_select(ForwardIt first, ForwardIt last)
     return random_select(first, last, gen);
 }
 
-auto estimate_dynamic_size(const AlignedRead& read) noexcept
-{
-    return read.name().size() * sizeof(char)
-    + read.read_group().size() * sizeof(char)
-    + sequence_size(read) * sizeof(char)
-    + sequence_size(read) * sizeof(AlignedRead::BaseQuality)
-    + read.cigar().size() * sizeof(CigarOperation)
-    + contig_name(read).size() * sizeof(char)
-    + (read.has_other_segment() ? sizeof(AlignedRead::Segment) : 0);
-}
-
 auto estimate_read_size(const AlignedRead& read) noexcept
 {
-    return sizeof(AlignedRead) + estimate_dynamic_size(read);
+    return footprint(read);
 }
 
 auto get_covered_sample_regions(const std::vector<SampleName>& samples, const InputRegionMap& input_regions,
@@ -0,0 +1,82 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "memory_budget.hpp"
+
+#include <utility>
+
+namespace octopus {
+
+MemoryBudget::Charge::Charge(MemoryBudget& budget, const std::size_t num_bytes) noexcept
+: budget_ {&budget}
+, num_bytes_ {num_bytes}
+{
+    budget_->num_used_bytes_ += num_bytes_;
+}
+
+MemoryBudget::Charge::Charge(Charge&& other) noexcept
+: budget_ {std::exchange(other.budget_, nullptr)}
+, num_bytes_ {std::exchange(other.num_bytes_, 0)}
+{}
+
+MemoryBudget::Charge& MemoryBudget::Charge::operator=(Charge&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        budget_ = std::exchange(other.budget_, nullptr);
+        num_bytes_ = std::exchange(other.num_bytes_, 0);
+    }
+    return *this;
+}
+
+MemoryBudget::Charge::~Charge()
+{
+    release();
+}
+
+std::size_t MemoryBudget::Charge::num_bytes() const noexcept
+{
+    return num_bytes_;
+}
+
+void MemoryBudget::Charge::release() noexcept
+{
+    if (budget_) {
+        budget_->num_used_bytes_ -= num_bytes_;
+        budget_ = nullptr;
+        num_bytes_ = 0;
+    }
+}
+
+MemoryBudget::MemoryBudget(MemoryFootprint limit)
+: limit_ {limit}
+, num_used_bytes_ {0}
+{}
+
+MemoryFootprint MemoryBudget::limit() const noexcept
+{
+    return limit_;
+}
+
+MemoryFootprint MemoryBudget::used() const noexcept
+{
+    return num_used_bytes_.load();
+}
+
+std::size_t MemoryBudget::num_available_bytes() const noexcept
+{
+    const auto num_used_bytes = num_used_bytes_.load();
+    return num_used_bytes < limit_.num_bytes() ? limit_.num_bytes() - num_used_bytes : 0;
+}
+
+bool MemoryBudget::is_exceeded() const noexcept
+{
+    return num_used_bytes_.load() > limit_.num_bytes();
+}
+
+MemoryBudget::Charge MemoryBudget::charge(const std::size_t num_bytes) noexcept
+{
+    return Charge {*this, num_bytes};
+}
+
+} // namespace octopus
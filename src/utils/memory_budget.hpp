@@ -0,0 +1,73 @@
+// Copyright (c) 2015-2018 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef memory_budget_hpp
+#define memory_budget_hpp
+
+#include <cstddef>
+#include <atomic>
+
+#include "memory_footprint.hpp"
+
+namespace octopus {
+
+/*
+ MemoryBudget is a thread-safe running total of the bytes held by some set of objects, compared
+ against a limit. Holders take a Charge for the bytes they keep, which is returned to the budget when
+ the Charge is destroyed or reassigned. The budget is advisory: charges are never refused, so
+ holders should check is_exceeded and shrink what they keep.
+ */
+class MemoryBudget
+{
+public:
+    class Charge
+    {
+    public:
+        Charge() = default;
+
+        Charge(const Charge&)            = delete;
+        Charge& operator=(const Charge&) = delete;
+        Charge(Charge&& other) noexcept;
+        Charge& operator=(Charge&& other) noexcept;
+
+        ~Charge();
+
+        std::size_t num_bytes() const noexcept;
+
+    private:
+        MemoryBudget* budget_ = nullptr;
+        std::size_t num_bytes_ = 0;
+
+        Charge(MemoryBudget& budget, std::size_t num_bytes) noexcept;
+
+        void release() noexcept;
+
+        friend MemoryBudget;
+    };
+
+    MemoryBudget() = delete;
+
+    MemoryBudget(MemoryFootprint limit);
+
+    MemoryBudget(const MemoryBudget&)            = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+    MemoryBudget(MemoryBudget&&)                 = delete;
+    MemoryBudget& operator=(MemoryBudget&&)      = delete;
+
+    ~MemoryBudget() = default;
+
+    MemoryFootprint limit() const noexcept;
+    MemoryFootprint used() const noexcept;
+    std::size_t num_available_bytes() const noexcept;
+    bool is_exceeded() const noexcept;
+
+    Charge charge(std::size_t num_bytes) noexcept;
+
+private:
+    MemoryFootprint limit_;
+    std::atomic<std::size_t> num_used_bytes_;
+};
+
+} // namespace octopus
+
+#endif
@@ -141,6 +141,14 @@ std::size_t count_reads(const T& reads, const GenomicRegion& region, NonMapTag)
     return count_overlapped(reads, region);
 }
 
+template <typename T>
+std::size_t footprint(const T& reads, NonMapTag)
+{
+    static_assert(is_aligned_read_container<T>, "T must be a container of AlignedReads");
+    return std::accumulate(std::cbegin(reads), std::cend(reads), std::size_t {0},
+                           [] (const auto curr, const AlignedRead& read) { return curr + footprint(read); });
+}
+
 template <typename T>
 std::size_t count_forward(const T& reads, NonMapTag)
 {
@@ -458,6 +466,15 @@ std::size_t count_reads(const T& reads, MapTag)
     return maths::sum_sizes(reads);
 }
 
+template <typename T>
+std::size_t footprint(const T& reads, MapTag)
+{
+    return std::accumulate(std::cbegin(reads), std::cend(reads), std::size_t {0},
+                           [] (const auto curr, const auto& sample_reads) {
+                               return curr + footprint(sample_reads.second, NonMapTag {});
+                           });
+}
+
 template <typename T>
 std::size_t count_reads(const T& reads, const GenomicRegion& region, MapTag)
 {
@@ -750,6 +767,13 @@ std::size_t count_reads(const T& reads, const GenomicRegion& region)
     return detail::count_reads(reads, region, MapTagType<T> {});
 }
 
+// Bytes held by the reads themselves, not including the container
+template <typename T>
+std::size_t footprint(const T& reads)
+{
+    return detail::footprint(reads, MapTagType<T> {});
+}
+
 template <typename T>
 std::size_t count_forward(const T& reads)
 {
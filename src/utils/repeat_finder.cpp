@@ -3,8 +3,150 @@
 
 #include "repeat_finder.hpp"
 
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace octopus {
 
+namespace {
+
+constexpr std::uint32_t no_run {std::numeric_limits<std::uint32_t>::max()};
+
+bool has_smaller_period(const char* repeat, const std::uint32_t length, const unsigned period) noexcept
+{
+    // By Fine and Wilf, a repeat at least two periods long with a smaller period q also has period
+    // gcd(period, q), so only divisors need to be checked.
+    for (unsigned d {1}; d < period; ++d) {
+        if (period % d == 0 && std::equal(repeat + d, repeat + length, repeat)) return true;
+    }
+    return false;
+}
+
+// Index of the lowest set bit of x, which must be non-zero
+unsigned count_trailing_zeros(unsigned x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(x));
+#else
+    unsigned result {0};
+    for (; (x & 1u) == 0; x >>= 1) ++result;
+    return result;
+#endif
+}
+
+class ShortRepeatScanner
+{
+public:
+    ShortRepeatScanner(const char* sequence, std::vector<tandem::Repeat>& result)
+    : sequence_ {sequence}, result_ {result}
+    {
+        run_begins_.fill(no_run);
+    }
+    
+    // Bit i of matches is set if sequence[base + i] == sequence[base + i + period]
+    void scan(unsigned matches, const unsigned num_bits, const std::uint32_t base, const unsigned period)
+    {
+        const unsigned all_bits {(1u << num_bits) - 1};
+        matches &= all_bits;
+        auto& run_begin = run_begins_[period];
+        if (run_begin != no_run) {
+            if (matches == all_bits) return;
+            const auto run_end = count_trailing_zeros(~matches);
+            emit(run_begin, base + run_end, period);
+            run_begin = no_run;
+            matches &= ~((1u << run_end) - 1);
+        }
+        while (matches != 0) {
+            const auto run_start = count_trailing_zeros(matches);
+            const auto mismatches = ~matches & all_bits & ~((1u << run_start) - 1);
+            if (mismatches == 0) {
+                run_begin = base + run_start;
+                return;
+            }
+            const auto run_end = count_trailing_zeros(mismatches);
+            emit(base + run_start, base + run_end, period);
+            matches &= ~((1u << run_end) - 1);
+        }
+    }
+    
+    void finish(const std::uint32_t end, const unsigned period)
+    {
+        auto& run_begin = run_begins_[period];
+        if (run_begin != no_run) {
+            emit(run_begin, end, period);
+            run_begin = no_run;
+        }
+    }
+    
+private:
+    const char* sequence_;
+    std::vector<tandem::Repeat>& result_;
+    std::array<std::uint32_t, max_short_tandem_repeat_period() + 1> run_begins_;
+    
+    // A run of matches [begin, end) with shift period is a repeat of length end - begin + period
+    void emit(const std::uint32_t begin, const std::uint32_t end, const unsigned period)
+    {
+        if (end - begin >= period) {
+            const auto length = end - begin + period;
+            if (!has_smaller_period(sequence_ + begin, length, period)) {
+                result_.emplace_back(begin, length, period);
+            }
+        }
+    }
+};
+
+} // namespace
+
+std::vector<tandem::Repeat>
+find_short_tandem_repeats(const char* first, const char* last, unsigned min_period, unsigned max_period)
+{
+    if (min_period == 0) ++min_period;
+    if (max_period > max_short_tandem_repeat_period()) {
+        throw std::domain_error {"find_short_tandem_repeats: max_period > max_short_tandem_repeat_period()"};
+    }
+    std::vector<tandem::Repeat> result {};
+    const auto n = static_cast<std::uint32_t>(std::distance(first, last));
+    max_period = std::min(max_period, n / 2);
+    if (min_period > max_period) return result;
+    ShortRepeatScanner scanner {first, result};
+    static constexpr unsigned block_size {16};
+    std::uint32_t i {0};
+#if defined(__SSE2__)
+    static_assert(sizeof(__m128i) == block_size, "block_size must match the SSE2 register width");
+    for (; i + block_size + max_period <= n; i += block_size) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+        for (auto period = min_period; period <= max_period; ++period) {
+            const auto shifted_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i + period));
+            const auto matches = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, shifted_block)));
+            scanner.scan(matches, block_size, i, period);
+        }
+    }
+#endif
+    // Scalar comparison of whatever the vector loop did not cover (everything without SSE2)
+    for (auto period = min_period; period <= max_period; ++period) {
+        const auto end = n - period;
+        for (auto j = i; j < end; j += block_size) {
+            const auto num_bits = std::min(block_size, end - j);
+            unsigned matches {0};
+            for (unsigned k {0}; k < num_bits; ++k) {
+                if (first[j + k] == first[j + k + period]) matches |= 1u << k;
+            }
+            scanner.scan(matches, num_bits, j, period);
+        }
+        scanner.finish(end, period);
+    }
+    std::sort(std::begin(result), std::end(result),
+              [] (const tandem::Repeat& lhs, const tandem::Repeat& rhs) noexcept {
+                  return lhs.pos < rhs.pos || (lhs.pos == rhs.pos && lhs.length < rhs.length);
+              });
+    return result;
+}
+
 std::vector<TandemRepeat>
 find_exact_tandem_repeats(const ReferenceGenome& reference, const GenomicRegion& region, unsigned max_period)
 {
@@ -8,6 +8,7 @@
 #include <iterator>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 #include "io/reference/reference_genome.hpp"
 #include "basics/genomic_region.hpp"
@@ -41,6 +42,36 @@ struct InexactRepeatDefinition
     unsigned min_joined_repeat_length      = 10;
 };
 
+constexpr unsigned max_short_tandem_repeat_period() noexcept { return 6; }
+
+/**
+ Finds all maximal exact tandem repeats (runs) with period in [min_period, max_period], where max_period
+ is at most max_short_tandem_repeat_period(). Each period is detected by comparing the sequence with a
+ shifted copy of itself 16 bases at a time, with all periods handled in a single pass.
+ 
+ The result is sorted by position.
+ */
+std::vector<tandem::Repeat>
+find_short_tandem_repeats(const char* first, const char* last, unsigned min_period, unsigned max_period);
+
+template <typename SequenceType>
+std::vector<tandem::Repeat>
+find_short_tandem_repeats(const SequenceType& sequence, unsigned min_period, unsigned max_period)
+{
+    return find_short_tandem_repeats(sequence.data(), sequence.data() + sequence.size(), min_period, max_period);
+}
+
+template <typename SequenceType>
+std::vector<tandem::Repeat>
+extract_exact_tandem_repeats(const SequenceType& sequence, unsigned min_period, unsigned max_period)
+{
+    if (max_period <= max_short_tandem_repeat_period()) {
+        return find_short_tandem_repeats(sequence, min_period, max_period);
+    } else {
+        return tandem::extract_exact_tandem_repeats(sequence, min_period, max_period);
+    }
+}
+
 template <typename SequenceType>
 std::vector<TandemRepeat>
 find_exact_tandem_repeats(SequenceType& sequence, const GenomicRegion& region,
@@ -51,7 +82,7 @@ find_exact_tandem_repeats(SequenceType& sequence, const GenomicRegion& region,
         sequence.push_back('$');
     }
     auto n_shift_map = tandem::collapse(sequence, 'N');
-    auto maximal_repetitions = tandem::extract_exact_tandem_repeats(sequence , min_period, max_period);
+    auto maximal_repetitions = extract_exact_tandem_repeats(sequence, min_period, max_period);
     tandem::rebase(maximal_repetitions, n_shift_map);
     n_shift_map.clear();
     std::vector<TandemRepeat> result {};
@@ -0,0 +1,63 @@
+// Copyright (c) 2017 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include "mock_fasta.hpp"
+
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <cctype>
+
+#include <boost/filesystem/operations.hpp>
+
+namespace octopus { namespace test { namespace mock {
+
+TemporaryFasta::TemporaryFasta(const std::vector<FastaContig>& contigs, const std::size_t line_width)
+: directory_ {boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()}
+{
+    boost::filesystem::create_directory(directory_);
+    std::ofstream fasta {path().string(), std::ios::binary}, index {path().string() + ".fai"};
+    std::size_t offset {0};
+    for (const auto& contig : contigs) {
+        const auto header = ">" + contig.name + "\n";
+        fasta << header;
+        offset += header.size();
+        index << contig.name << '\t' << contig.sequence.size() << '\t' << offset << '\t'
+              << line_width << '\t' << line_width + 1 << '\n';
+        for (std::size_t pos {0}; pos < contig.sequence.size(); pos += line_width) {
+            const auto line = contig.sequence.substr(pos, line_width);
+            fasta << line << '\n';
+            offset += line.size() + 1;
+        }
+    }
+}
+
+TemporaryFasta::~TemporaryFasta()
+{
+    boost::system::error_code ec {};
+    boost::filesystem::remove_all(directory_, ec);
+}
+
+TemporaryFasta::Path TemporaryFasta::path() const
+{
+    return directory_ / "reference.fa";
+}
+
+std::string make_random_bases(const std::size_t n, std::mt19937& generator)
+{
+    static const std::string bases {"ACGT"};
+    std::uniform_int_distribution<std::size_t> dist {0, bases.size() - 1};
+    std::string result(n, 'N');
+    std::generate(std::begin(result), std::end(result), [&] () { return bases[dist(generator)]; });
+    return result;
+}
+
+void to_lower_case(std::string& sequence, const std::size_t begin, const std::size_t end)
+{
+    std::transform(std::next(std::begin(sequence), begin), std::next(std::begin(sequence), end),
+                   std::next(std::begin(sequence), begin), [] (const char base) { return std::tolower(base); });
+}
+
+} // namespace mock
+} // namespace test
+} // namespace octopus
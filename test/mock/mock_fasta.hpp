@@ -0,0 +1,52 @@
+// Copyright (c) 2017 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#ifndef mock_fasta_hpp
+#define mock_fasta_hpp
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstddef>
+
+#include <boost/filesystem/path.hpp>
+
+namespace octopus { namespace test { namespace mock {
+
+struct FastaContig
+{
+    std::string name, sequence;
+};
+
+// Writes an indexed FASTA to a new temporary directory, which is removed on destruction
+class TemporaryFasta
+{
+public:
+    using Path = boost::filesystem::path;
+    
+    TemporaryFasta() = delete;
+    
+    TemporaryFasta(const std::vector<FastaContig>& contigs, std::size_t line_width = 60);
+    
+    TemporaryFasta(const TemporaryFasta&)            = delete;
+    TemporaryFasta& operator=(const TemporaryFasta&) = delete;
+    TemporaryFasta(TemporaryFasta&&)                 = delete;
+    TemporaryFasta& operator=(TemporaryFasta&&)      = delete;
+    
+    ~TemporaryFasta();
+    
+    Path path() const;
+    
+private:
+    Path directory_;
+};
+
+std::string make_random_bases(std::size_t n, std::mt19937& generator);
+
+void to_lower_case(std::string& sequence, std::size_t begin, std::size_t end);
+
+} // namespace mock
+} // namespace test
+} // namespace octopus
+
+#endif
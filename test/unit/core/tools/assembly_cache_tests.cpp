@@ -0,0 +1,127 @@
+// Copyright (c) 2017 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include "basics/genomic_region.hpp"
+#include "core/types/variant.hpp"
+#include "core/tools/vargen/utils/assembly_cache.hpp"
+
+namespace octopus { namespace test {
+
+using octopus::coretools::AssemblyCache;
+using octopus::coretools::make_read_set;
+
+namespace {
+
+AssemblyCache::Result make_result(const GenomicRegion::Position pos)
+{
+    return {AssemblyCache::Status::success, {Variant {"test", pos, "C", "A"}}};
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(core)
+BOOST_AUTO_TEST_SUITE(assembly_cache)
+
+BOOST_AUTO_TEST_CASE(inserted_problems_are_found_regardless_of_read_order)
+{
+    AssemblyCache cache {1'000'000};
+    const GenomicRegion region {"test", 100, 200};
+    const std::vector<std::string> reads {"ACGTACGT", "TTTTGGGG", "ACGTACGT"};
+    const std::vector<std::string> shuffled_reads {"TTTTGGGG", "ACGTACGT", "ACGTACGT"};
+    cache.insert(region, 10, make_read_set(reads), make_result(150));
+    const auto hit = cache.find(region, 10, AssemblyCache::ReadSetHash {shuffled_reads}, shuffled_reads);
+    BOOST_REQUIRE(hit);
+    BOOST_CHECK(hit->status == AssemblyCache::Status::success);
+    BOOST_REQUIRE_EQUAL(hit->variants.size(), 1u);
+    BOOST_CHECK_EQUAL(hit->variants.front(), (Variant {"test", 150, "C", "A"}));
+    const auto stats = cache.stats();
+    BOOST_CHECK_EQUAL(stats.hits, 1u);
+    BOOST_CHECK_EQUAL(stats.misses, 0u);
+    BOOST_CHECK_EQUAL(stats.size, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(problems_differing_in_region_kmer_size_or_reads_miss)
+{
+    AssemblyCache cache {1'000'000};
+    const GenomicRegion region {"test", 100, 200};
+    const std::vector<std::string> reads {"ACGTACGT", "TTTTGGGG"};
+    cache.insert(region, 10, make_read_set(reads), make_result(150));
+    BOOST_CHECK(!cache.find(GenomicRegion {"test", 100, 201}, 10, *make_read_set(reads)));
+    BOOST_CHECK(!cache.find(region, 15, *make_read_set(reads)));
+    // Same multiset size, different reads
+    BOOST_CHECK(!cache.find(region, 10, *make_read_set(std::vector<std::string> {"ACGTACGT", "TTTTGGGC"})));
+    // Same reads with different multiplicity
+    BOOST_CHECK(!cache.find(region, 10, *make_read_set(std::vector<std::string> {"ACGTACGT", "TTTTGGGG", "TTTTGGGG"})));
+    BOOST_CHECK(!cache.find(region, 10, *make_read_set(std::vector<std::string> {})));
+    const auto stats = cache.stats();
+    BOOST_CHECK_EQUAL(stats.hits, 0u);
+    BOOST_CHECK_EQUAL(stats.misses, 5u);
+}
+
+BOOST_AUTO_TEST_CASE(read_set_hashes_can_be_built_one_read_at_a_time_in_any_order)
+{
+    const std::vector<std::string> reads {"ACGTACGT", "TTTTGGGG", "ACGTACGT"};
+    AssemblyCache::ReadSetHash hash {};
+    for (auto itr = reads.crbegin(); itr != reads.crend(); ++itr) hash.add(*itr);
+    BOOST_CHECK(hash == AssemblyCache::ReadSetHash {reads});
+    BOOST_CHECK_EQUAL(hash.size(), reads.size());
+    BOOST_CHECK(!(hash == AssemblyCache::ReadSetHash {std::vector<std::string> {"ACGTACGT", "TTTTGGGG"}}));
+    BOOST_CHECK(!(hash == AssemblyCache::ReadSetHash {std::vector<std::string> {"ACGTACGT", "TTTTGGGG", "TTTTGGGG"}}));
+}
+
+BOOST_AUTO_TEST_CASE(hits_are_confirmed_against_the_reads_not_just_the_hash)
+{
+    AssemblyCache cache {1'000'000};
+    const GenomicRegion region {"test", 100, 200};
+    const std::vector<std::string> reads {"ACGTACGT", "TTTTGGGG"}, other_reads {"ACGTACGT", "TTTTGGGC"};
+    cache.insert(region, 10, make_read_set(reads), make_result(150));
+    BOOST_CHECK(!cache.find(region, 10, AssemblyCache::ReadSetHash {reads}, other_reads));
+    BOOST_CHECK(cache.find(region, 10, AssemblyCache::ReadSetHash {reads}, reads));
+}
+
+BOOST_AUTO_TEST_CASE(least_recently_used_entries_are_evicted_to_stay_within_the_footprint)
+{
+    const GenomicRegion region1 {"test", 100, 200}, region2 {"test", 200, 300}, region3 {"test", 300, 400};
+    const auto reads = make_read_set(std::vector<std::string> {"ACGTACGT", "TTTTGGGG"});
+    // Measure the footprint of one entry so that the cache can be sized to hold exactly two
+    std::size_t entry_footprint {};
+    {
+        AssemblyCache probe {1'000'000};
+        probe.insert(region1, 10, reads, make_result(150));
+        entry_footprint = probe.stats().footprint;
+    }
+    BOOST_REQUIRE(entry_footprint > 0);
+    AssemblyCache cache {2 * entry_footprint};
+    cache.insert(region1, 10, reads, make_result(150));
+    cache.insert(region2, 10, reads, make_result(250));
+    BOOST_REQUIRE(cache.find(region1, 10, *reads)); // region2 is now least recently used
+    cache.insert(region3, 10, reads, make_result(350));
+    const auto stats = cache.stats();
+    BOOST_CHECK_EQUAL(stats.evictions, 1u);
+    BOOST_CHECK_EQUAL(stats.size, 2u);
+    BOOST_CHECK_LE(stats.footprint, 2 * entry_footprint);
+    BOOST_CHECK(cache.find(region1, 10, *reads));
+    BOOST_CHECK(!cache.find(region2, 10, *reads));
+    BOOST_CHECK(cache.find(region3, 10, *reads));
+}
+
+BOOST_AUTO_TEST_CASE(results_larger_than_the_footprint_are_not_cached)
+{
+    AssemblyCache cache {1};
+    const GenomicRegion region {"test", 100, 200};
+    const auto reads = make_read_set(std::vector<std::string> {"ACGTACGT"});
+    cache.insert(region, 10, reads, make_result(150));
+    BOOST_CHECK(!cache.find(region, 10, *reads));
+    BOOST_CHECK_EQUAL(cache.stats().size, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace octopus
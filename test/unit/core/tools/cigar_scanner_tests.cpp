@@ -3,25 +3,185 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <functional>
+
+#include "basics/genomic_region.hpp"
+#include "basics/cigar_string.hpp"
+#include "basics/aligned_read.hpp"
+#include "config/common.hpp"
+#include "core/types/variant.hpp"
 #include "core/tools/vargen/variant_generator.hpp"
+#include "core/tools/vargen/cigar_scanner.hpp"
+#include "mock/mock_reference.hpp"
 
 namespace octopus { namespace test {
 
+using octopus::coretools::VariantGenerator;
+using octopus::coretools::CigarScanner;
+using octopus::coretools::SimpleThresholdInclusionPredicate;
+
 namespace {
-    auto make_cigar_scanner()
-    {
-        using Builder = VariantGenerator::Builder;
-        return Builder().add_generator(Builder::Generator::Alignment);
-    }
+
+// The start of contig "1" of the mock reference
+const std::string contig1_prefix {"TAAGATGAAATCTACAAAAT"};
+
+// Generators may keep references to sample names, so they must outlive the generator
+const SampleName sample1 {"s1"}, sample2 {"s2"};
+
+AlignedRead make_read(const GenomicRegion::ContigName& contig, const GenomicRegion::Position begin,
+                      std::string sequence, const std::string& cigar, const bool reverse = false)
+{
+    auto parsed_cigar = parse_cigar(cigar);
+    const auto end = begin + static_cast<GenomicRegion::Position>(reference_size(parsed_cigar));
+    AlignedRead::BaseQualityVector qualities(sequence.size(), 30);
+    AlignedRead::Flags flags {};
+    flags.reverse_mapped = reverse;
+    return AlignedRead {"read", GenomicRegion {contig, begin, end}, std::move(sequence), std::move(qualities),
+                        std::move(parsed_cigar), 60, flags, "rg"};
+}
+
+std::string with_substitution(std::string sequence, const std::size_t pos, const std::string& bases)
+{
+    return sequence.replace(pos, bases.size(), bases);
+}
+
+// The test reads are short, so the default mutation rate would mark the MNV read as likely misaligned
+auto make_cigar_scanner(const ReferenceGenome& reference, const std::size_t min_observations,
+                        const double max_expected_mutation_rate = 1e-2)
+{
+    CigarScanner::Options options {};
+    options.include = SimpleThresholdInclusionPredicate {min_observations};
+    options.misalignment_parameters.snv_threshold = 20;
+    options.misalignment_parameters.max_expected_mutation_rate = max_expected_mutation_rate;
+    VariantGenerator result {};
+    result.add(std::make_unique<CigarScanner>(reference, options));
+    return result;
+}
+
+using SampleReads = std::vector<std::pair<std::reference_wrapper<const SampleName>, AlignedRead>>;
+
+// Shared and duplicate alleles within and between samples. The SNVs at 15 are added with their alt
+// bases in reverse lexicographical order.
+SampleReads make_reads()
+{
+    const auto& ref = contig1_prefix;
+    SampleReads result {};
+    result.emplace_back(sample1, make_read("1", 0, with_substitution(ref, 5, "C"), "20M"));
+    result.emplace_back(sample1, make_read("1", 2, with_substitution(ref, 5, "C").substr(2), "18M", true));
+    result.emplace_back(sample2, make_read("1", 0, with_substitution(ref, 5, "G"), "20M"));
+    result.emplace_back(sample1, make_read("1", 0, ref.substr(0, 8) + "CA" + ref.substr(8), "8M2I12M"));
+    result.emplace_back(sample2, make_read("1", 0, ref.substr(0, 8) + "CA" + ref.substr(8), "8M2I12M", true));
+    result.emplace_back(sample1, make_read("1", 0, ref.substr(0, 8) + "AC" + ref.substr(8), "8M2I12M"));
+    result.emplace_back(sample2, make_read("1", 0, ref.substr(0, 10) + ref.substr(12), "10M2D8M"));
+    result.emplace_back(sample1, make_read("1", 0, ref.substr(0, 10) + ref.substr(12), "10M2D8M"));
+    result.emplace_back(sample1, make_read("1", 0, with_substitution(ref, 10, "GG"), "10M2X8M"));
+    result.emplace_back(sample1, make_read("1", 0, with_substitution(ref, 15, "T"), "20M"));
+    result.emplace_back(sample2, make_read("1", 0, with_substitution(ref, 15, "G"), "20M"));
+    result.emplace_back(sample2, make_read("1", 0, with_substitution(ref, 15, "C"), "20M", true));
+    return result;
 }
 
+// Generators may keep references to the reads, so they must outlive the generator too
+void add_reads(const SampleReads& reads, VariantGenerator& generator)
+{
+    for (const auto& p : reads) generator.add_read(p.first, p.second);
+}
+
+} // namespace
+
 BOOST_AUTO_TEST_SUITE(core)
 BOOST_AUTO_TEST_SUITE(cigar_scanner)
 
+BOOST_AUTO_TEST_CASE(candidates_are_every_distinct_observed_allele_in_variant_order)
+{
+    const auto reference = mock::make_reference();
+    const auto reads = make_reads();
+    auto generator = make_cigar_scanner(reference, 1);
+    add_reads(reads, generator);
+    const auto candidates = generator.generate(GenomicRegion {"1", 0, 40});
+    const std::vector<Variant> expected {
+        Variant {"1", 5, "T", "C"},
+        Variant {"1", 5, "T", "G"},
+        Variant {"1", 8, "", "AC"},
+        Variant {"1", 8, "", "CA"},
+        Variant {"1", 10, "TC", ""},
+        Variant {"1", 10, "TC", "GG"},
+        Variant {"1", 15, "A", "C"},
+        Variant {"1", 15, "A", "G"},
+        Variant {"1", 15, "A", "T"}
+    };
+    BOOST_CHECK(std::is_sorted(std::cbegin(expected), std::cend(expected)));
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::cbegin(candidates), std::cend(candidates), std::cbegin(expected), std::cend(expected));
+}
+
+BOOST_AUTO_TEST_CASE(duplicate_alleles_are_counted_across_reads_and_samples)
+{
+    const auto reference = mock::make_reference();
+    const auto reads = make_reads();
+    auto generator = make_cigar_scanner(reference, 2);
+    add_reads(reads, generator);
+    const auto candidates = generator.generate(GenomicRegion {"1", 0, 40});
+    const std::vector<Variant> expected {
+        Variant {"1", 5, "T", "C"},
+        Variant {"1", 8, "", "CA"},
+        Variant {"1", 10, "TC", ""}
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::cbegin(candidates), std::cend(candidates), std::cbegin(expected), std::cend(expected));
+    BOOST_CHECK(make_cigar_scanner(reference, 2).generate(GenomicRegion {"1", 0, 40}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(only_candidates_overlapping_the_requested_region_are_generated)
+{
+    const auto reference = mock::make_reference();
+    const auto reads = make_reads();
+    auto generator = make_cigar_scanner(reference, 1);
+    add_reads(reads, generator);
+    const auto candidates = generator.generate(GenomicRegion {"1", 6, 11});
+    const std::vector<Variant> expected {
+        Variant {"1", 8, "", "AC"},
+        Variant {"1", 8, "", "CA"},
+        Variant {"1", 10, "TC", ""},
+        Variant {"1", 10, "TC", "GG"}
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::cbegin(candidates), std::cend(candidates), std::cbegin(expected), std::cend(expected));
+}
+
+BOOST_AUTO_TEST_CASE(alleles_only_observed_in_likely_misaligned_reads_are_not_candidates)
+{
+    const auto reference = mock::make_reference();
+    const auto reads = make_reads();
+    auto generator = make_cigar_scanner(reference, 1, 1e-3);
+    add_reads(reads, generator);
+    const auto candidates = generator.generate(GenomicRegion {"1", 0, 40});
+    BOOST_CHECK_EQUAL(candidates.size(), 8);
+    BOOST_CHECK(std::find(std::cbegin(candidates), std::cend(candidates), Variant {"1", 10, "TC", "GG"}) == std::cend(candidates));
+}
 
+BOOST_AUTO_TEST_CASE(alleles_are_interned_again_after_clearing)
+{
+    const auto reference = mock::make_reference();
+    const auto reads = make_reads();
+    auto generator = make_cigar_scanner(reference, 1);
+    add_reads(reads, generator);
+    generator.clear();
+    BOOST_CHECK(generator.generate(GenomicRegion {"1", 0, 40}).empty());
+    const auto& ref = contig1_prefix;
+    SampleReads new_reads {};
+    new_reads.emplace_back(sample2, make_read("1", 0, with_substitution(ref, 15, "C"), "20M"));
+    new_reads.emplace_back(sample2, make_read("1", 0, ref.substr(0, 8) + "AC" + ref.substr(8), "8M2I12M"));
+    add_reads(new_reads, generator);
+    const auto candidates = generator.generate(GenomicRegion {"1", 0, 40});
+    const std::vector<Variant> expected {Variant {"1", 8, "", "AC"}, Variant {"1", 15, "A", "C"}};
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::cbegin(candidates), std::cend(candidates), std::cbegin(expected), std::cend(expected));
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
-    
+
 } // namespace test
 } // namespace octopus
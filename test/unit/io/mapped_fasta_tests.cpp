@@ -0,0 +1,105 @@
+// Copyright (c) 2017 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+
+#include "basics/genomic_region.hpp"
+#include "io/reference/fasta.hpp"
+#include "io/reference/mapped_fasta.hpp"
+#include "mock/mock_fasta.hpp"
+
+namespace octopus { namespace test {
+
+namespace {
+
+void check_same_sequence(const io::ReferenceReader& expected, const io::ReferenceReader& actual,
+                         const std::vector<GenomicRegion>& regions)
+{
+    for (const auto& region : regions) {
+        BOOST_TEST_CONTEXT("region " << region) {
+            BOOST_CHECK_EQUAL(actual.fetch_sequence(region), expected.fetch_sequence(region));
+        }
+    }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(io)
+BOOST_AUTO_TEST_SUITE(mapped_fasta)
+
+BOOST_AUTO_TEST_CASE(fetches_the_same_sequence_as_Fasta)
+{
+    std::mt19937 generator {7};
+    auto first = mock::make_random_bases(1'000, generator);
+    mock::to_lower_case(first, 55, 130);
+    std::fill_n(std::next(std::begin(first), 590), 20, 'N');
+    // Contigs whose last line is full, short, or a single base, and one contig shorter than a line
+    const std::vector<mock::FastaContig> contigs {
+        {"1", first},
+        {"2", mock::make_random_bases(600, generator)},
+        {"3", mock::make_random_bases(601, generator)},
+        {"4", mock::make_random_bases(25, generator)}
+    };
+    for (const std::size_t line_width : {60u, 1u, 7u}) {
+        BOOST_TEST_CONTEXT("line_width " << line_width) {
+            const mock::TemporaryFasta file {contigs, line_width};
+            std::vector<GenomicRegion> regions {};
+            for (const auto& contig : contigs) {
+                const auto contig_size = static_cast<GenomicRegion::Position>(contig.sequence.size());
+                const auto width = static_cast<GenomicRegion::Position>(std::min<std::size_t>(line_width, contig_size));
+                regions.emplace_back(contig.name, 0, contig_size);
+                regions.emplace_back(contig.name, 0, width); // first line
+                regions.emplace_back(contig.name, width - 1, std::min(width + 1, contig_size)); // across a line break
+                regions.emplace_back(contig.name, contig_size - 1, contig_size); // last base
+                regions.emplace_back(contig.name, contig_size - (contig_size % width == 0 ? width : contig_size % width),
+                                     contig_size); // last line
+                regions.emplace_back(contig.name, contig_size, contig_size);
+                std::uniform_int_distribution<GenomicRegion::Position> pos_dist {0, contig_size};
+                for (int i {0}; i < 20; ++i) {
+                    auto begin = pos_dist(generator), end = pos_dist(generator);
+                    if (end < begin) std::swap(begin, end);
+                    regions.emplace_back(contig.name, begin, end);
+                }
+            }
+            using Options = octopus::io::Fasta::Options;
+            for (const auto policy : {Options::BaseTransformPolicy::original, Options::BaseTransformPolicy::capitalise}) {
+                Options options {};
+                options.base_transform_policy = policy;
+                const octopus::io::Fasta fasta {file.path(), options};
+                const octopus::io::MappedFasta mapped {file.path(), options};
+                BOOST_CHECK(mapped.fetch_contig_names() == fasta.fetch_contig_names());
+                for (const auto& contig : contigs) {
+                    BOOST_CHECK_EQUAL(mapped.fetch_contig_size(contig.name), fasta.fetch_contig_size(contig.name));
+                }
+                check_same_sequence(fasta, mapped, regions);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bad_requests_fail_the_same_way_as_Fasta)
+{
+    const mock::TemporaryFasta file {{{"1", "ACGTACGTAC"}}};
+    octopus::io::Fasta::Options options {};
+    options.base_fill_policy = octopus::io::Fasta::Options::BaseFillPolicy::throw_exception;
+    const octopus::io::Fasta fasta {file.path(), options};
+    const octopus::io::MappedFasta mapped {file.path(), options};
+    const GenomicRegion out_of_bounds {"1", 5, 20}, unknown_contig {"2", 0, 5};
+    BOOST_CHECK_THROW(fasta.fetch_sequence(out_of_bounds), octopus::io::BadReferenceRequestRegion);
+    BOOST_CHECK_THROW(mapped.fetch_sequence(out_of_bounds), octopus::io::BadReferenceRequestRegion);
+    BOOST_CHECK_THROW(fasta.fetch_sequence(unknown_contig), std::out_of_range);
+    BOOST_CHECK_THROW(mapped.fetch_sequence(unknown_contig), std::out_of_range);
+    BOOST_CHECK_THROW(mapped.fetch_contig_size("2"), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace octopus
@@ -0,0 +1,86 @@
+// Copyright (c) 2017 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <memory>
+
+#include "basics/genomic_region.hpp"
+#include "io/reference/fasta.hpp"
+#include "io/reference/packed_caching_fasta.hpp"
+#include "mock/mock_fasta.hpp"
+
+namespace octopus { namespace test {
+
+namespace {
+
+void check_same_sequence(const io::ReferenceReader& expected, const io::ReferenceReader& actual,
+                         const std::vector<GenomicRegion>& regions)
+{
+    for (const auto& region : regions) {
+        BOOST_TEST_CONTEXT("region " << region) {
+            BOOST_CHECK_EQUAL(actual.fetch_sequence(region), expected.fetch_sequence(region));
+        }
+    }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(io)
+BOOST_AUTO_TEST_SUITE(packed_caching_fasta)
+
+BOOST_AUTO_TEST_CASE(fetches_the_same_sequence_as_Fasta)
+{
+    constexpr GenomicRegion::Position blockSize {16'384}; // PackedCachingFasta block size
+    std::mt19937 generator {42};
+    auto sequence = mock::make_random_bases(3 * blockSize + 1'000, generator);
+    // N and lower case runs that straddle block boundaries, start or end a block, or are mixed
+    std::fill_n(std::next(std::begin(sequence), blockSize - 50), 100, 'N');
+    std::fill_n(std::next(std::begin(sequence), 2 * blockSize), 30, 'N');
+    std::fill_n(std::next(std::begin(sequence), 2 * blockSize - 30), 30, 'R');
+    mock::to_lower_case(sequence, blockSize - 70, blockSize + 200);
+    mock::to_lower_case(sequence, 2 * blockSize + 500, 3 * blockSize);
+    mock::to_lower_case(sequence, sequence.size() - 10, sequence.size());
+    for (std::size_t pos {100}; pos < 200; pos += 3) sequence[pos] = 'N';
+    const std::string contig {"1"};
+    const mock::TemporaryFasta file {{{contig, sequence}, {"2", mock::make_random_bases(500, generator)}}, 60};
+    const octopus::io::Fasta fasta {file.path()};
+    const auto contig_size = static_cast<GenomicRegion::Position>(sequence.size());
+    std::vector<GenomicRegion> regions {
+        GenomicRegion {contig, 0, contig_size},
+        GenomicRegion {contig, 0, 1},
+        GenomicRegion {contig, 90, 210},
+        GenomicRegion {contig, blockSize - 100, blockSize + 100},
+        GenomicRegion {contig, blockSize - 1, blockSize + 1},
+        GenomicRegion {contig, blockSize, blockSize},
+        GenomicRegion {contig, 2 * blockSize - 40, 2 * blockSize + 40},
+        GenomicRegion {contig, blockSize + 10, 3 * blockSize + 10},
+        GenomicRegion {contig, 3 * blockSize - 1, contig_size},
+        GenomicRegion {contig, contig_size - 20, contig_size},
+        GenomicRegion {"2", 0, 500}
+    };
+    std::uniform_int_distribution<GenomicRegion::Position> pos_dist {0, contig_size};
+    for (int i {0}; i < 200; ++i) {
+        auto begin = pos_dist(generator), end = pos_dist(generator);
+        if (end < begin) std::swap(begin, end);
+        regions.emplace_back(contig, begin, end);
+    }
+    // The small cache only holds a couple of blocks, so blocks are repeatedly evicted and refetched
+    for (const std::size_t max_cache_bytes : {10'000ul, 10'000'000ul}) {
+        BOOST_TEST_CONTEXT("max_cache_bytes " << max_cache_bytes) {
+            const octopus::io::PackedCachingFasta cached {std::make_unique<octopus::io::Fasta>(file.path()), max_cache_bytes};
+            check_same_sequence(fasta, cached, regions);
+            check_same_sequence(fasta, cached, regions);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace octopus
@@ -0,0 +1,82 @@
+// Copyright (c) 2017 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+#include <boost/filesystem/operations.hpp>
+
+#include "basics/genomic_region.hpp"
+#include "io/reference/reference_genome.hpp"
+#include "io/reference/reference_annotation_index.hpp"
+#include "utils/sequence_utils.hpp"
+#include "mock/mock_fasta.hpp"
+
+namespace octopus { namespace test {
+
+BOOST_AUTO_TEST_SUITE(io)
+BOOST_AUTO_TEST_SUITE(reference_annotation_index)
+
+BOOST_AUTO_TEST_CASE(gc_content_is_the_same_as_computed_from_the_sequence)
+{
+    std::mt19937 generator {13};
+    auto first = mock::make_random_bases(5'000, generator);
+    std::fill_n(std::next(std::begin(first), 1'000), 700, 'G');
+    std::fill_n(std::next(std::begin(first), 2'000), 300, 'N');
+    mock::to_lower_case(first, 500, 1'200);
+    // Contigs that end on and off a bitmap word boundary, and one shorter than a word
+    const mock::TemporaryFasta file {{{"1", first}, {"2", mock::make_random_bases(1'024, generator)},
+                                      {"3", mock::make_random_bases(33, generator)}}};
+    const auto reference = make_reference(file.path());
+    const auto index_path = ReferenceAnnotationIndex::default_path(file.path());
+    ReferenceAnnotationIndex::build(reference, index_path);
+    BOOST_CHECK(!boost::filesystem::exists(index_path.string() + ".tmp"));
+    BOOST_REQUIRE(ReferenceAnnotationIndex::is_up_to_date(index_path, file.path()));
+    const ReferenceAnnotationIndex index {index_path};
+    BOOST_CHECK(index.is_compatible(reference));
+    std::vector<GenomicRegion> regions {};
+    for (const auto& contig : reference.contig_names()) {
+        const auto contig_size = reference.contig_size(contig);
+        regions.push_back(reference.contig_region(contig));
+        regions.emplace_back(contig, 0, 1);
+        regions.emplace_back(contig, contig_size - 1, contig_size);
+        std::uniform_int_distribution<GenomicRegion::Position> pos_dist {0, contig_size};
+        for (int i {0}; i < 100; ++i) {
+            auto begin = pos_dist(generator), end = pos_dist(generator);
+            if (end < begin) std::swap(begin, end);
+            if (begin == end) continue;
+            regions.emplace_back(contig, begin, end);
+        }
+    }
+    regions.emplace_back("1", 63, 65);
+    regions.emplace_back("1", 511, 1'025);
+    for (const auto& region : regions) {
+        BOOST_TEST_CONTEXT("region " << region) {
+            BOOST_CHECK_EQUAL(index.gc_content(region), utils::gc_content(reference.fetch_sequence(region)));
+        }
+    }
+    BOOST_CHECK(std::isnan(index.gc_content(GenomicRegion {"1", 10, 10})));
+}
+
+BOOST_AUTO_TEST_CASE(index_is_out_of_date_if_missing_or_older_than_the_reference)
+{
+    const mock::TemporaryFasta file {{{"1", "ACGT"}}};
+    const auto index_path = ReferenceAnnotationIndex::default_path(file.path());
+    BOOST_CHECK(!ReferenceAnnotationIndex::is_up_to_date(index_path, file.path()));
+    ReferenceAnnotationIndex::build(make_reference(file.path()), index_path);
+    BOOST_CHECK(ReferenceAnnotationIndex::is_up_to_date(index_path, file.path()));
+    const auto index_write_time = boost::filesystem::last_write_time(index_path);
+    boost::filesystem::last_write_time(file.path(), index_write_time + 10);
+    BOOST_CHECK(!ReferenceAnnotationIndex::is_up_to_date(index_path, file.path()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace octopus
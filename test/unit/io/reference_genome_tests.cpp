@@ -10,7 +10,6 @@
 
 #include "io/reference/reference_genome.hpp"
 #include "io/reference/fasta.hpp"
-#include "io/reference/caching_fasta.hpp"
 #include "utils/mappable_algorithms.hpp"
 #include "mock/mock_reference.hpp"
 
@@ -94,36 +93,6 @@ BOOST_AUTO_TEST_CASE(contigs_are_reported_in_apperance_order)
 //    const auto human = make_reference(human_reference_fasta);
 //    BOOST_CHECK(human.fetch_sequence(GenomicRegion {"1", 100, 100}) == "");
 //}
-//
-//BOOST_AUTO_TEST_CASE(CachingFasta_works_the_same_as_Fasta)
-//{
-//    BOOST_REQUIRE(test_file_exists(ecoli_reference_fasta));
-//
-//    constexpr std::size_t maxCacheSize {100000};
-//    const auto ecoli = make_reference(ecoli_reference_fasta, maxCacheSize);
-//
-//    BOOST_CHECK(ecoli.name() == "R00000042");
-//    BOOST_CHECK(ecoli.contains(GenomicRegion("R00000042", 10000, 2000000)));
-//    BOOST_CHECK(ecoli.contig_size("R00000042") == 5231428);
-//    BOOST_CHECK(!ecoli.has_contig("X"));
-//    BOOST_CHECK(ecoli.contig_region("R00000042") == GenomicRegion("R00000042", 0, 5231428));
-//    BOOST_CHECK(ecoli.fetch_sequence(GenomicRegion("R00000042", 0, 10)) == "AGCTTTTCAT"); // first line
-//    BOOST_CHECK(ecoli.fetch_sequence(GenomicRegion("R00000042", 69, 80)) == "CTTCTGAACTG"); // accross lines
-//
-//    BOOST_REQUIRE(test_file_exists(human_reference_fasta));
-//
-//    const auto human = make_reference(human_reference_fasta, maxCacheSize);
-//
-//    BOOST_CHECK(human.name() == "human_g1k_v37");
-//    BOOST_CHECK(human.contains(GenomicRegion("1", 100, 10000)));
-//    BOOST_CHECK(!human.contains(GenomicRegion("1", 100, 3e8))); // too big
-//    BOOST_CHECK(human.contig_size("20") == 63025520);
-//    BOOST_CHECK(human.has_contig("X"));
-//    BOOST_CHECK(!human.has_contig("y"));
-//    BOOST_CHECK(human.contig_region("X") == GenomicRegion("X", 0, 155270560));
-//    BOOST_CHECK(human.fetch_sequence(GenomicRegion("15", 51265690, 51265700)) == "ACAATGTTGT");
-//    BOOST_CHECK(human.fetch_sequence(GenomicRegion("5", 100000, 100010)) == "AGGAAGTTTC");
-//}
 
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,103 @@
 // Copyright (c) 2017 Daniel Cooke
 // Use of this source code is governed by the MIT license that can be found in the LICENSE file.
 
-#include <stdio.h>
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+
+#include "io/read/streaming_downsampler.hpp"
+
+namespace octopus { namespace test {
+
+namespace {
+
+using Interval = std::pair<unsigned, unsigned>;
+
+// Offers the reads in order, storing them where the downsampler says to as a reader would
+std::vector<Interval> downsample(const std::vector<Interval>& reads, io::StreamingDownsampler& downsampler)
+{
+    std::vector<Interval> result {};
+    for (const auto& read : reads) {
+        const auto index = downsampler.add(read.first, read.second, result.size());
+        if (!index) continue;
+        if (*index < result.size()) {
+            result[*index] = read;
+        } else {
+            BOOST_REQUIRE_EQUAL(*index, result.size());
+            result.push_back(read);
+        }
+    }
+    return result;
+}
+
+std::vector<Interval> make_tiled_reads(const unsigned first_begin, const unsigned last_begin,
+                                       const unsigned reads_per_position, const unsigned read_length)
+{
+    std::vector<Interval> result {};
+    for (auto begin = first_begin; begin < last_begin; ++begin) {
+        for (unsigned i {0}; i < reads_per_position; ++i) {
+            result.emplace_back(begin, begin + read_length);
+        }
+    }
+    return result;
+}
+
+unsigned max_coverage(const std::vector<Interval>& reads)
+{
+    unsigned result {0};
+    for (const auto& read : reads) {
+        const auto pos = read.first;
+        const auto coverage = std::count_if(std::cbegin(reads), std::cend(reads),
+                                            [=] (const auto& other) { return other.first <= pos && pos < other.second; });
+        result = std::max(result, static_cast<unsigned>(coverage));
+    }
+    return result;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(readpipe)
+BOOST_AUTO_TEST_SUITE(streaming_downsampler)
+
+BOOST_AUTO_TEST_CASE(reads_are_all_kept_when_coverage_is_below_the_trigger)
+{
+    io::StreamingDownsampler downsampler {50, 20};
+    const auto reads = make_tiled_reads(0, 100, 1, 40);
+    BOOST_REQUIRE_EQUAL(max_coverage(reads), 40u);
+    const auto kept = downsample(reads, downsampler);
+    BOOST_CHECK(kept == reads);
+    BOOST_CHECK_EQUAL(downsampler.num_discarded(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(kept_coverage_never_exceeds_the_trigger)
+{
+    io::StreamingDownsampler downsampler {30, 10};
+    const auto reads = make_tiled_reads(0, 200, 5, 50);
+    const auto kept = downsample(reads, downsampler);
+    BOOST_CHECK_LE(max_coverage(kept), 30u);
+    BOOST_CHECK_EQUAL(downsampler.num_discarded(), reads.size() - kept.size());
+    BOOST_CHECK(std::is_sorted(std::cbegin(kept), std::cend(kept),
+                               [] (const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; }));
+}
+
+BOOST_AUTO_TEST_CASE(reads_are_kept_again_once_coverage_drops)
+{
+    io::StreamingDownsampler downsampler {30, 10};
+    auto reads = make_tiled_reads(0, 100, 5, 50);
+    const auto num_deep_reads = reads.size();
+    const auto shallow_reads = make_tiled_reads(1000, 1100, 1, 20);
+    reads.insert(std::cend(reads), std::cbegin(shallow_reads), std::cend(shallow_reads));
+    const auto kept = downsample(reads, downsampler);
+    BOOST_CHECK_LT(kept.size(), num_deep_reads);
+    BOOST_CHECK(std::equal(std::cbegin(shallow_reads), std::cend(shallow_reads),
+                           std::prev(std::cend(kept), shallow_reads.size())));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace octopus
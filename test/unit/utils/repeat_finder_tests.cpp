@@ -0,0 +1,162 @@
+// Copyright (c) 2017 Daniel Cooke
+// Use of this source code is governed by the MIT license that can be found in the LICENSE file.
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <random>
+#include <tuple>
+#include <iterator>
+
+#include "tandem/tandem.hpp"
+#include "utils/repeat_finder.hpp"
+
+namespace octopus { namespace test {
+
+namespace {
+
+bool contains(const std::vector<tandem::Repeat>& repeats, const unsigned pos, const unsigned length, const unsigned period)
+{
+    return std::any_of(std::cbegin(repeats), std::cend(repeats),
+                       [=] (const auto& repeat) {
+                           return repeat.pos == pos && repeat.length == length && repeat.period == period;
+                       });
+}
+
+auto sorted(std::vector<tandem::Repeat> repeats)
+{
+    std::sort(std::begin(repeats), std::end(repeats),
+              [] (const auto& lhs, const auto& rhs) {
+                  return std::tie(lhs.pos, lhs.length, lhs.period) < std::tie(rhs.pos, rhs.length, rhs.period);
+              });
+    return repeats;
+}
+
+std::string make_random_sequence(const std::size_t length, const std::string& alphabet, std::mt19937& generator)
+{
+    std::uniform_int_distribution<std::size_t> dist {0, alphabet.size() - 1};
+    std::string result(length, 'N');
+    std::generate(std::begin(result), std::end(result), [&] () { return alphabet[dist(generator)]; });
+    return result;
+}
+
+// Concatenates randomly chosen short motifs, each repeated a few times, so runs of every period abut and overlap
+std::string make_low_complexity_sequence(const std::size_t length, std::mt19937& generator)
+{
+    std::uniform_int_distribution<unsigned> period_dist {1, max_short_tandem_repeat_period()}, copies_dist {1, 6};
+    std::string result {};
+    while (result.size() < length) {
+        const auto motif = make_random_sequence(period_dist(generator), "ACGT", generator);
+        for (auto copies = copies_dist(generator); copies > 0; --copies) result += motif;
+    }
+    result.resize(length);
+    return result;
+}
+
+// Maximal runs straight from the definition: a run with period p is at least 2p long, cannot be extended and
+// has no smaller period
+std::vector<tandem::Repeat> find_runs_naively(const std::string& sequence, const unsigned max_period)
+{
+    std::vector<tandem::Repeat> result {};
+    const auto has_period = [&] (const std::size_t begin, const std::size_t end, const unsigned period) {
+        for (auto i = begin; i + period < end; ++i) {
+            if (sequence[i] != sequence[i + period]) return false;
+        }
+        return true;
+    };
+    for (unsigned period {1}; period <= max_period; ++period) {
+        for (std::size_t begin {0}; begin + 2 * period <= sequence.size(); ++begin) {
+            if (begin > 0 && sequence[begin - 1] == sequence[begin - 1 + period]) continue;
+            auto end = begin + period;
+            while (end < sequence.size() && sequence[end] == sequence[end - period]) ++end;
+            if (end - begin < 2 * period) continue;
+            unsigned smaller_period {1};
+            while (smaller_period < period && !has_period(begin, end, smaller_period)) ++smaller_period;
+            if (smaller_period == period) result.emplace_back(begin, end - begin, period);
+        }
+    }
+    return sorted(result);
+}
+
+void check_matches_naive_runs_and_tandem(const std::string& sequence)
+{
+    // tandem is given the terminated sequence find_exact_tandem_repeats passes it. It is not exact: it misses some
+    // runs (e.g. the second CCC in ACCCCCAAACCCAAA) and reports some parts of runs (e.g. AA at 5 in AACAAAACAC), so
+    // the naive runs are the reference and tandem's repeats must each lie within a found run of the same period.
+    const auto tandem_repeats = tandem::extract_exact_tandem_repeats(sequence + '$', 1, max_short_tandem_repeat_period());
+    const auto actual = find_short_tandem_repeats(sequence, 1, max_short_tandem_repeat_period());
+    for (const auto& repeat : tandem_repeats) {
+        BOOST_REQUIRE_MESSAGE(std::any_of(std::cbegin(actual), std::cend(actual),
+                                          [&] (const auto& run) {
+                                              return run.period == repeat.period && run.pos <= repeat.pos
+                                                     && repeat.pos + repeat.length <= run.pos + run.length;
+                                          }),
+                              sequence << " missing " << repeat.pos << ' ' << repeat.length << ' ' << repeat.period);
+    }
+    for (unsigned max_period {1}; max_period <= max_short_tandem_repeat_period(); ++max_period) {
+        const auto repeats = find_short_tandem_repeats(sequence, 1, max_period);
+        BOOST_REQUIRE(std::is_sorted(std::cbegin(repeats), std::cend(repeats),
+                                     [] (const auto& lhs, const auto& rhs) { return lhs.pos < rhs.pos; }));
+        BOOST_REQUIRE_MESSAGE(sorted(repeats) == find_runs_naively(sequence, max_period),
+                              sequence << " max period " << max_period);
+    }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(utils)
+BOOST_AUTO_TEST_SUITE(repeat_finder)
+
+BOOST_AUTO_TEST_CASE(find_short_tandem_repeats_finds_maximal_runs_with_minimal_period)
+{
+    const std::string sequence {"GTAAAAACACACACGTTCGTTCGTTGGATC"};
+    const auto repeats = find_short_tandem_repeats(sequence, 1, 6);
+    BOOST_CHECK(contains(repeats, 2, 5, 1));
+    BOOST_CHECK(contains(repeats, 6, 8, 2));
+    BOOST_CHECK(contains(repeats, 13, 12, 4));
+    BOOST_CHECK(contains(repeats, 15, 2, 1));
+    BOOST_CHECK(!contains(repeats, 2, 4, 2)); // homopolymer has smaller period
+    BOOST_CHECK(std::is_sorted(std::cbegin(repeats), std::cend(repeats),
+                               [] (const auto& lhs, const auto& rhs) { return lhs.pos < rhs.pos; }));
+}
+
+BOOST_AUTO_TEST_CASE(find_short_tandem_repeats_handles_repeats_spanning_and_ending_blocks)
+{
+    const std::string sequence(40, 'A');
+    const auto repeats = find_short_tandem_repeats(sequence + "C" + std::string(17, 'G'), 1, 6);
+    BOOST_REQUIRE_EQUAL(repeats.size(), 2u);
+    BOOST_CHECK(contains(repeats, 0, 40, 1));
+    BOOST_CHECK(contains(repeats, 41, 17, 1));
+}
+
+BOOST_AUTO_TEST_CASE(find_short_tandem_repeats_respects_period_bounds)
+{
+    const std::string sequence {"AAAACACACAGTAGTAGTA"};
+    const auto repeats = find_short_tandem_repeats(sequence, 2, 2);
+    BOOST_CHECK(std::all_of(std::cbegin(repeats), std::cend(repeats), [] (const auto& r) { return r.period == 2; }));
+    BOOST_CHECK(contains(repeats, 3, 7, 2));
+    BOOST_CHECK(find_short_tandem_repeats(std::string {}, 1, 6).empty());
+    BOOST_CHECK_THROW(find_short_tandem_repeats(sequence, 1, max_short_tandem_repeat_period() + 1), std::domain_error);
+}
+
+BOOST_AUTO_TEST_CASE(find_short_tandem_repeats_finds_all_runs_and_everything_tandem_finds)
+{
+    std::mt19937 generator {42};
+    for (const std::size_t length : {1, 2, 15, 16, 17, 31, 33, 64, 100, 257}) {
+        for (int i {0}; i < 20; ++i) {
+            check_matches_naive_runs_and_tandem(make_random_sequence(length, "ACGT", generator));
+            check_matches_naive_runs_and_tandem(make_random_sequence(length, "AC", generator));
+            check_matches_naive_runs_and_tandem(make_low_complexity_sequence(length, generator));
+        }
+    }
+    check_matches_naive_runs_and_tandem(std::string(100, 'A'));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace octopus